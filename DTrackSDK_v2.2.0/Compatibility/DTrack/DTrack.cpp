@@ -57,6 +57,7 @@ DTrack::DTrack(
 	remoteTracking = true;
 	remoteSending = true;
 	sdk = new DTrackSDK(s, remote_port, data_port, DTrackSDK::SYS_DTRACK_UNKNOWN, data_bufsize, data_timeout_us, data_timeout_us);
+	sdk->setFloatMode(true);  // legacy data types use float
 }
 
 
@@ -120,100 +121,8 @@ bool DTrack::parseerror()
  */
 bool DTrack::receive()
 {
-	if (!sdk->receive())
-		return false;
-	// copy body data
-	act_num_body = sdk->getNumBody();
-	act_body.resize(act_num_body);
-	for (int i = 0; i < act_num_body; i++)
-	{
-		DTrack_Body_Type_d *dtbt = sdk->getBody(i);
-		dtrack_body_type *dtbt2 = &act_body.at(i);
-		dtbt2->id = dtbt->id;
-		dtbt2->quality = (float)dtbt->quality;
-		for (int j = 0; j < 3; j++)
-			dtbt2->loc[j] = (float)dtbt->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtbt2->rot[j] = (float)dtbt->rot[j];
-	}
-	// copy flystick data
-	act_num_flystick = sdk->getNumFlyStick();
-	act_flystick.resize(act_num_flystick);
-	for (int i = 0; i < act_num_flystick; i++)
-	{
-		DTrack_FlyStick_Type_d *dtfst = sdk->getFlyStick(i);
-		dtrack_flystick_type *dtfst2 = &act_flystick.at(i);
-		dtfst2->id = dtfst->id;
-		dtfst2->quality = (float)dtfst->quality;
-		dtfst2->num_button = dtfst->num_button;
-		for (int j = 0; j < DTRACK_FLYSTICK_MAX_BUTTON; j++)
-			dtfst2->button[j] = dtfst->button[j];
-		dtfst2->num_joystick = dtfst->num_joystick;
-		for (int j = 0; j < DTRACK_FLYSTICK_MAX_JOYSTICK; j++)
-			dtfst2->joystick[j] = (float)dtfst->joystick[j];
-		for (int j = 0; j < 3; j++)
-			dtfst2->loc[j] = (float)dtfst->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtfst2->rot[j] = (float)dtfst->rot[j];
-	}
-	// copy measurement tool data
-	act_num_meatool = sdk->getNumMeaTool();
-	act_meatool.resize(act_num_meatool);
-	for (int i = 0; i < act_num_meatool; i++)
-	{
-		DTrack_MeaTool_Type_d *dtmtt = sdk->getMeaTool(i);
-		dtrack_meatool_type *dtmtt2 = &act_meatool.at(i);
-		dtmtt2->id = dtmtt->id;
-		dtmtt2->quality = (float)dtmtt->quality;
-		dtmtt2->num_button = dtmtt->num_button;
-		for (int j = 0; j < DTRACK_MEATOOL_MAX_BUTTON; j++)
-			dtmtt2->button[j] = dtmtt->button[j];
-		for (int j = 0; j < 3; j++)
-			dtmtt2->loc[j] = (float)dtmtt->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtmtt2->rot[j] = (float)dtmtt->rot[j];
-	}
-	// copy hand data
-	act_num_hand = sdk->getNumHand();
-	act_hand.resize(act_num_hand);
-	for (int i = 0; i < act_num_hand; i++)
-	{
-		DTrack_Hand_Type_d *dtht = sdk->getHand(i);
-		dtrack_hand_type *dtht2 = &act_hand.at(i);
-		dtht2->id = dtht->id;
-		dtht2->quality = (float)dtht->quality;
-		dtht2->lr = dtht->lr;
-		dtht2->nfinger = dtht->nfinger;
-		for (int j = 0; j < 3; j++)
-			dtht2->loc[j] = (float)dtht->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtht2->rot[j] = (float)dtht->rot[j];
-		for (int k = 0; k < DTRACK_HAND_MAX_FINGER; k++)
-		{
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].loc[j] = (float)dtht->finger[k].loc[j];
-			for (int j = 0; j < 9; j++)
-				dtht2->finger[k].rot[j] = (float)dtht->finger[k].rot[j];
-			dtht2->finger[k].radiustip = (float)dtht->finger[k].radiustip;
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].lengthphalanx[j] = (float)dtht->finger[k].lengthphalanx[j];
-			for (int j = 0; j < 2; j++)
-				dtht2->finger[k].anglephalanx[j] = (float)dtht->finger[k].anglephalanx[j];
-		}
-	}
-	// copy marker data
-	act_num_marker = sdk->getNumMarker();
-	act_marker.resize(act_num_marker);
-	for (int i = 0; i < act_num_marker; i++)
-	{
-		DTrack_Marker_Type_d *dtmt = sdk->getMarker(i);
-		dtrack_marker_type *dtmt2 = &act_marker.at(i);
-		dtmt2->id = dtmt->id;
-		dtmt2->quality = (float)dtmt->quality;
-		for (int j = 0; j < 3; j++)
-			dtmt2->loc[j] = (float)dtmt->loc[j];
-	}
-	return true;
+	// data is read on access, directly from the (float) data of the sdk
+	return sdk->receive();
 }
 
 
@@ -249,7 +158,7 @@ double DTrack::get_timestamp()
  */
 int DTrack::get_num_body()
 {
-	return act_num_body;
+	return sdk->getNumBody();
 }
 
 
@@ -262,9 +171,9 @@ int DTrack::get_num_body()
  */
 dtrack_body_type DTrack::get_body(int id)
 {
-	if (id < act_num_body)
-	{
-		return act_body[id];
+	dtrack_body_type* body = sdk->getBodyFloat(id);
+	if (body != NULL) {
+		return *body;
 	}
 	dtrack_body_type dummy;
 	memset(&dummy, 0, sizeof(dtrack_body_type));
@@ -282,7 +191,7 @@ dtrack_body_type DTrack::get_body(int id)
  */
 int DTrack::get_num_flystick()
 {
-	return act_num_flystick;
+	return sdk->getNumFlyStick();
 }
 
 
@@ -295,9 +204,9 @@ int DTrack::get_num_flystick()
  */
 dtrack_flystick_type DTrack::get_flystick(int id)
 {
-	if (id < act_num_flystick)
-	{
-		return act_flystick[id];
+	dtrack_flystick_type* flystick = sdk->getFlyStickFloat(id);
+	if (flystick != NULL) {
+		return *flystick;
 	}
 	dtrack_flystick_type dummy;
 	memset(&dummy, 0, sizeof(dtrack_flystick_type));
@@ -315,7 +224,7 @@ dtrack_flystick_type DTrack::get_flystick(int id)
  */
 int DTrack::get_num_meatool()
 {
-	return act_num_meatool;
+	return sdk->getNumMeaTool();
 }
 
 
@@ -328,9 +237,9 @@ int DTrack::get_num_meatool()
  */
 dtrack_meatool_type DTrack::get_meatool(int id)
 {
-	if (id < act_num_meatool)
-	{
-		return act_meatool[id];
+	dtrack_meatool_type* meatool = sdk->getMeaToolFloat(id);
+	if (meatool != NULL) {
+		return *meatool;
 	}
 	dtrack_meatool_type dummy;
 	memset(&dummy, 0, sizeof(dtrack_meatool_type));
@@ -348,7 +257,7 @@ dtrack_meatool_type DTrack::get_meatool(int id)
  */
 int DTrack::get_num_hand()
 {
-	return act_num_hand;
+	return sdk->getNumHand();
 }
 
 
@@ -361,8 +270,9 @@ int DTrack::get_num_hand()
  */
 dtrack_hand_type DTrack::get_hand(int id)
 {
-	if(id < act_num_hand){
-		return act_hand[id];
+	dtrack_hand_type* hand = sdk->getHandFloat(id);
+	if (hand != NULL) {
+		return *hand;
 	}
 	dtrack_hand_type dummy;
 	memset(&dummy, 0, sizeof(dtrack_hand_type));
@@ -380,7 +290,7 @@ dtrack_hand_type DTrack::get_hand(int id)
  */
 int DTrack::get_num_marker()
 {
-	return act_num_marker;
+	return sdk->getNumMarker();
 }
 
 
@@ -393,8 +303,9 @@ int DTrack::get_num_marker()
  */
 dtrack_marker_type DTrack::get_marker(int index)
 {
-	if(index >= 0 && index < act_num_marker){
-		return act_marker[index];
+	dtrack_marker_type* marker = sdk->getMarkerFloat(index);
+	if (marker != NULL) {
+		return *marker;
 	}
 	dtrack_marker_type dummy;
 	memset(&dummy, 0, sizeof(dtrack_marker_type));
@@ -255,16 +255,6 @@ private:
 	bool remoteCameras;		//!< DTrack status: cameras on/off
 	bool remoteTracking;	//!< DTrack status: tracking on/off
 	bool remoteSending;		//!< DTrack status: sending of UDP output data on/off
-	int act_num_body;								//!< number of standard bodies
-	std::vector<dtrack_body_type> act_body;			//!< array containing 6d data
-	int act_num_flystick;							//!< number of flysticks
-	std::vector<dtrack_flystick_type> act_flystick;	//!< array containing 6df data
-	int act_num_meatool;							//!< number of measurement tools
-	std::vector<dtrack_meatool_type> act_meatool;	//!< array containing 6dmt data
-	int act_num_marker;								//!< number of single markers
-	std::vector<dtrack_marker_type> act_marker;		//!< array containing 3d data
-	int act_num_hand;								//!< number of fingertracking hands
-	std::vector<dtrack_hand_type> act_hand;			//!< array containing gl data
 };
 
 #endif // _ART_DTRACK_H
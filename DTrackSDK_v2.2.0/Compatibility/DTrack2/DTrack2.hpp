@@ -356,16 +356,6 @@ public:
 	std::string get_message_msg();
 private:
 	DTrackSDK *sdk;                                     //!< unified sdk
-	int act_num_body;									//!< number of standard bodies
-	std::vector<dtrack2_body_type> act_body;			//!< array containing 6df data
-	int act_num_flystick;								//!< number of flysticks
-	std::vector<dtrack2_flystick_type> act_flystick;	//!< array containing flystick data
-	int act_num_meatool;								//!< number of measurement tools
-	std::vector<dtrack2_meatool_type> act_meatool;		//!< array containing 6dmt data
-	int act_num_marker;									//!< number of single markers
-	std::vector<dtrack2_marker_type> act_marker;		//!< array containing 3d data
-	int act_num_hand;									//!< number of fingertracking hands
-	std::vector<dtrack2_hand_type> act_hand;			//!< array containing gl data
 };
 
 #endif // _ART_DTRACK2_H
@@ -56,8 +56,8 @@ DTracklib::DTracklib(
 	if (remote_ip != NULL)
 		s = remote_ip;
 	sdk = new DTrackSDK(s, remote_port, udpport, DTrackSDK::SYS_DTRACK, udpbufsize, udptimeout_us, udptimeout_us);
+	sdk->setFloatMode(true);  // legacy data types use float
 	act_nbodycal = -1;
-	act_nbody = act_nflystick = act_nmeatool = act_nmarker = act_nglove = 0;
 }
 
 
@@ -121,107 +121,8 @@ bool DTracklib::parseerror()
  */
 bool DTracklib::receive()
 {
-	if (!sdk->receive())
-		return false;
-	// copy body data
-	act_nbody = sdk->getNumBody();
-	act_body.resize(act_nbody);
-	for (int i = 0; i < act_nbody; i++)
-	{
-		DTrack_Body_Type_d *dtbt = sdk->getBody(i);
-		dtracklib_body_type *dtbt2 = &act_body.at(i);
-		dtbt2->id = dtbt->id;
-		dtbt2->quality = (float)dtbt->quality;
-		for (int j = 0; j < 3; j++)
-			dtbt2->loc[j] = (float)dtbt->loc[j];
-		for (int j = 0; j < 3; j++)
-			dtbt2->ang[j] = 0;
-		for (int j = 0; j < 9; j++)
-			dtbt2->rot[j] = (float)dtbt->rot[j];
-	}
-	// copy flystick data
-	act_nflystick = sdk->getNumFlyStick();
-	act_flystick.resize(act_nflystick);
-	for (int i = 0; i < act_nflystick; i++)
-	{
-		DTrack_FlyStick_Type_d *dtfst = sdk->getFlyStick(i);
-		dtracklib_flystick_type *dtfst2 = &act_flystick.at(i);
-		dtfst2->id = dtfst->id;
-		dtfst2->quality = (float)dtfst->quality;
-		dtfst2->bt = 0;
-		for (int j = 0; j < min(dtfst->num_button, DTRACK_FLYSTICK_MAX_BUTTON); j++)
-		{
-			if (dtfst->button[j] == 1)
-				dtfst2->bt |= (dtfst->button[j] << j);
-		}
-		for (int j = 0; j < 3; j++)
-			dtfst2->loc[j] = (float)dtfst->loc[j];
-		for (int j = 0; j < 3; j++)
-			dtfst2->ang[j] = 0;
-		for (int j = 0; j < 9; j++)
-			dtfst2->rot[j] = (float)dtfst->rot[j];
-	}
-	// copy measurement tool data
-	act_nmeatool = sdk->getNumMeaTool();
-	act_meatool.resize(act_nmeatool);
-	for (int i = 0; i < act_nmeatool; i++)
-	{
-		DTrack_MeaTool_Type_d *dtmtt = sdk->getMeaTool(i);
-		dtracklib_meatool_type *dtmtt2 = &act_meatool.at(i);
-		dtmtt2->id = dtmtt->id;
-		dtmtt2->quality = (float)dtmtt->quality;
-		dtmtt2->bt = 0;
-		for (int j = 0; j < min(dtmtt->num_button, DTRACK_FLYSTICK_MAX_BUTTON); j++)
-		{
-			if (dtmtt->button[j] == 1)
-				dtmtt2->bt |= (dtmtt->button[j] << j);
-		}
-		for (int j = 0; j < 3; j++)
-			dtmtt2->loc[j] = (float)dtmtt->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtmtt2->rot[j] = (float)dtmtt->rot[j];
-	}
-	// copy hand data
-	act_nglove = sdk->getNumHand();
-	act_glove.resize(act_nglove);
-	for (int i = 0; i < act_nglove; i++)
-	{
-		DTrack_Hand_Type_d *dtht = sdk->getHand(i);
-		dtracklib_glove_type *dtht2 = &act_glove.at(i);
-		dtht2->id = dtht->id;
-		dtht2->quality = (float)dtht->quality;
-		dtht2->lr = dtht->lr;
-		dtht2->nfinger = dtht->nfinger;
-		for (int j = 0; j < 3; j++)
-			dtht2->loc[j] = (float)dtht->loc[j];
-		for (int j = 0; j < 9; j++)
-			dtht2->rot[j] = (float)dtht->rot[j];
-		for (int k = 0; k < DTRACK_HAND_MAX_FINGER; k++)
-		{
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].loc[j] = (float)dtht->finger[k].loc[j];
-			for (int j = 0; j < 9; j++)
-				dtht2->finger[k].rot[j] = (float)dtht->finger[k].rot[j];
-			dtht2->finger[k].radiustip = (float)dtht->finger[k].radiustip;
-			for (int j = 0; j < 3; j++)
-				dtht2->finger[k].lengthphalanx[j] = (float)dtht->finger[k].lengthphalanx[j];
-			for (int j = 0; j < 2; j++)
-				dtht2->finger[k].anglephalanx[j] = (float)dtht->finger[k].anglephalanx[j];
-		}
-	}
-	// copy marker data
-	act_nmarker = sdk->getNumMarker();
-	act_marker.resize(act_nmarker);
-	for (int i = 0; i < act_nmarker; i++)
-	{
-		DTrack_Marker_Type_d *dtmt = sdk->getMarker(i);
-		dtracklib_marker_type *dtmt2 = &act_marker.at(i);
-		dtmt2->id = dtmt->id;
-		dtmt2->quality = (float)dtmt->quality;
-		for (int j = 0; j < 3; j++)
-			dtmt2->loc[j] = (float)dtmt->loc[j];
-	}
-	return true;
+	// data is converted on access, directly from the (float) data of the sdk
+	return sdk->receive();
 }
 
 
@@ -268,7 +169,7 @@ int DTracklib::get_nbodycal()
  */
 int DTracklib::get_nbody()
 {
-	return act_nbody;
+	return sdk->getNumBody();
 }
 
 
@@ -281,13 +182,22 @@ int DTracklib::get_nbody()
  */
 dtracklib_body_type DTracklib::get_body(int id)
 {
-	if ((id < 0)||(id >= act_nbody))
+	dtracklib_body_type body;
+	DTrack_Body_Type_f* dtbt = sdk->getBodyFloat(id);
+	if (dtbt == NULL)
 	{
-		dtracklib_body_type dummy;
-		memset(&dummy, 0, sizeof(dtracklib_body_type));
-		return dummy;
+		memset(&body, 0, sizeof(dtracklib_body_type));
+		return body;
 	}
-	return act_body[id];
+	body.id = dtbt->id;
+	body.quality = dtbt->quality;
+	for (int j = 0; j < 3; j++)
+		body.loc[j] = dtbt->loc[j];
+	for (int j = 0; j < 3; j++)
+		body.ang[j] = 0;
+	for (int j = 0; j < 9; j++)
+		body.rot[j] = dtbt->rot[j];
+	return body;
 }
 
 
@@ -299,7 +209,7 @@ dtracklib_body_type DTracklib::get_body(int id)
  */
 int DTracklib::get_nflystick()
 {
-	return act_nflystick;
+	return sdk->getNumFlyStick();
 }
 
 
@@ -312,13 +222,28 @@ int DTracklib::get_nflystick()
  */
 dtracklib_flystick_type DTracklib::get_flystick(int id)
 {
-	if ((id < 0)||(id >= act_nflystick))
+	dtracklib_flystick_type flystick;
+	DTrack_FlyStick_Type_f* dtfst = sdk->getFlyStickFloat(id);
+	if (dtfst == NULL)
 	{
-		dtracklib_flystick_type dummy;
-		memset(&dummy, 0, sizeof(dtracklib_flystick_type));
-		return dummy;
+		memset(&flystick, 0, sizeof(dtracklib_flystick_type));
+		return flystick;
 	}
-	return act_flystick[id];
+	flystick.id = dtfst->id;
+	flystick.quality = dtfst->quality;
+	flystick.bt = 0;
+	for (int j = 0; j < min(dtfst->num_button, DTRACK_FLYSTICK_MAX_BUTTON); j++)
+	{
+		if (dtfst->button[j] == 1)
+			flystick.bt |= (dtfst->button[j] << j);
+	}
+	for (int j = 0; j < 3; j++)
+		flystick.loc[j] = dtfst->loc[j];
+	for (int j = 0; j < 3; j++)
+		flystick.ang[j] = 0;
+	for (int j = 0; j < 9; j++)
+		flystick.rot[j] = dtfst->rot[j];
+	return flystick;
 }
 
 
@@ -330,7 +255,7 @@ dtracklib_flystick_type DTracklib::get_flystick(int id)
  */
 int DTracklib::get_nmeatool()
 {
-	return act_nmeatool;
+	return sdk->getNumMeaTool();
 }
 
 
@@ -343,13 +268,26 @@ int DTracklib::get_nmeatool()
  */
 dtracklib_meatool_type DTracklib::get_meatool(int id)
 {
-	if(id < 0 || id >= act_nmeatool){
-		dtracklib_meatool_type dummy;
-		memset(&dummy, 0, sizeof(dtracklib_meatool_type));
-		return dummy;
+	dtracklib_meatool_type meatool;
+	DTrack_MeaTool_Type_f* dtmtt = sdk->getMeaToolFloat(id);
+	if (dtmtt == NULL)
+	{
+		memset(&meatool, 0, sizeof(dtracklib_meatool_type));
+		return meatool;
+	}
+	meatool.id = dtmtt->id;
+	meatool.quality = dtmtt->quality;
+	meatool.bt = 0;
+	for (int j = 0; j < min(dtmtt->num_button, DTRACK_FLYSTICK_MAX_BUTTON); j++)
+	{
+		if (dtmtt->button[j] == 1)
+			meatool.bt |= (dtmtt->button[j] << j);
 	}
-	
-	return act_meatool[id];
+	for (int j = 0; j < 3; j++)
+		meatool.loc[j] = dtmtt->loc[j];
+	for (int j = 0; j < 9; j++)
+		meatool.rot[j] = dtmtt->rot[j];
+	return meatool;
 }
 
 
@@ -361,7 +299,7 @@ dtracklib_meatool_type DTracklib::get_meatool(int id)
  */
 int DTracklib::get_nglove()
 {
-	return act_nglove;
+	return sdk->getNumHand();
 }
 
 
@@ -374,13 +312,14 @@ int DTracklib::get_nglove()
  */
 dtracklib_glove_type DTracklib::get_glove(int id)
 {
-	if(id < 0 || id >= act_nglove){
+	dtracklib_glove_type* glove = sdk->getHandFloat(id);
+	if (glove == NULL)
+	{
 		dtracklib_glove_type dummy;
 		memset(&dummy, 0, sizeof(dtracklib_glove_type));
 		return dummy;
 	}
-	
-	return act_glove[id];
+	return *glove;
 }
 
 
@@ -392,7 +331,7 @@ dtracklib_glove_type DTracklib::get_glove(int id)
  */
 int DTracklib::get_nmarker()
 {
-	return act_nmarker;
+	return sdk->getNumMarker();
 }
 
 
@@ -405,12 +344,14 @@ int DTracklib::get_nmarker()
  */
 dtracklib_marker_type DTracklib::get_marker(int index)
 {
-	if(index < 0 || index >= act_nmarker){
+	dtracklib_marker_type* marker = sdk->getMarkerFloat(index);
+	if (marker == NULL)
+	{
 		dtracklib_marker_type dummy;
 		memset(&dummy, 0, sizeof(dtracklib_marker_type));
 		return dummy;
 	}
-	return act_marker[index];
+	return *marker;
 }
 
 
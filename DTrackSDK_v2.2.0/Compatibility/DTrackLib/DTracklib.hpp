@@ -249,16 +249,6 @@ public:
 private:
 	DTrackSDK *sdk;                                     //!< unified sdk
 	int act_nbodycal;                                   //!< number of calibrated bodies (-1, if information not available)
-	int act_nbody;                                      //!< number of standard bodies
-	std::vector<dtracklib_body_type> act_body;          //!< array containing 6d data
-	int act_nflystick;                                  //!< number of flysticks
-	std::vector<dtracklib_flystick_type> act_flystick;  //!< array containing 6df data
-	int act_nmeatool;                                   //!< number of measurement tools
-	std::vector<dtracklib_meatool_type> act_meatool;    //!< array containing 6dmt data
-	int act_nmarker;                                    //!< number of single markers
-	std::vector<dtracklib_marker_type> act_marker;      //!< array containing 3d data
-	int act_nglove;                                     //!< number of DataGloves
-	std::vector<dtracklib_glove_type> act_glove;        //!< array containing gl data
 };
 
 #endif // _ART_DTRACKLIB_H
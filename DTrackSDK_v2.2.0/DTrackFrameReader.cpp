@@ -0,0 +1,437 @@
+/* DTrackFrameReader: C++ source file
+ *
+ * DTrackFrameReader: reads frames handed over by DTrackSDK through shared memory.
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Version v2.2.0
+ *
+ * Purpose:
+ *  - attaches read-only to frames written into shared memory by DTrackSDK::enableSharedFrames()
+ *    of another process
+ *  - gives access to the newest frame in place (no copy, no syscall as long as frames are available)
+ */
+
+#include "DTrackFrameReader.hpp"
+#include "Lib/DTrackThread.h"
+
+#include <string.h>
+
+using namespace DTrackSDK_Shm;
+using namespace DTrackSDK_Thread;
+
+
+/**
+ * 	\brief	Constructor.
+ *
+ *	Attaching is retried by update(), if the frames are not available yet.
+ *	@param[in]	name	name of shared memory (see DTrackSDK::enableSharedFrames())
+ */
+DTrackFrameReader::DTrackFrameReader(const std::string name)
+{
+	d_name = name;
+	d_missed = 0;
+	memset(&d_empty, 0, sizeof(d_empty));
+	d_empty.timestamp = d_empty.rxtimestamp = -1;
+	d_frame = &d_empty;
+
+	if (shm_frame_open(&d_ring, d_name.c_str())) {
+		d_ring = NULL;
+		d_framesize = 0;
+	} else {
+		d_framesize = shm_frame_size(d_ring);
+	}
+}
+
+
+/**
+ * 	\brief	Destructor.
+ */
+DTrackFrameReader::~DTrackFrameReader()
+{
+	shm_frame_close(d_ring);
+}
+
+
+/**
+ * 	\brief	Is reader attached to frames in shared memory?
+ *
+ *	@return	attached?
+ */
+bool DTrackFrameReader::isAttached()
+{
+	return (d_ring != NULL);
+}
+
+
+/**
+ *	\brief	Get newest frame.
+ *
+ *	Waits for a frame newer than the current one. Attaches again automatically, if the writer
+ *	has disabled and enabled its frames in the meantime, or if a new writer has replaced one that
+ *	terminated without disabling them.
+ *	@param[in]	tout_us		timeout in us; default is 1s (1,000,000 us)
+ *	@return	newer frame available? (false if timeout or not attached)
+ */
+bool DTrackFrameReader::update(int tout_us)
+{
+	const void* frame;
+	int n = -2;
+
+	if (d_ring != NULL) {
+		n = shm_frame_latest(d_ring, &frame, tout_us);
+		if (n == -2) {  // frames disabled by the writer, or replaced after the writer terminated
+			d_frame = &d_empty;
+			shm_frame_close(d_ring);
+			d_ring = NULL;
+		}
+	}
+	if (d_ring == NULL) {  // attach again; as long as there are no frames, behave like a writer without data
+		if (shm_frame_open(&d_ring, d_name.c_str())) {
+			d_ring = NULL;
+			thread_sleep(tout_us);
+			return false;
+		}
+		d_framesize = shm_frame_size(d_ring);
+		n = shm_frame_latest(d_ring, &frame, tout_us);
+	}
+	if (n <= 0)  // timeout
+		return false;
+
+	d_missed += n - 1;
+	if (!checkFrame((const DTrack_Shm_Frame_Type* )frame)) {
+		d_frame = &d_empty;
+		return false;
+	}
+	d_frame = (const DTrack_Shm_Frame_Type* )frame;
+	return true;
+}
+
+
+/**
+ *	\brief	Check if records of a frame are located inside the frame.
+ *
+ *	@param[in]	frame	header of frame
+ *	@return	frame valid?
+ */
+bool DTrackFrameReader::checkFrame(const DTrack_Shm_Frame_Type* frame)
+{
+	const int offset[DTRACK_STAT_RECORDS] = { frame->offset_body, frame->offset_flystick, frame->offset_meatool,
+			frame->offset_mearef, frame->offset_hand, frame->offset_human, frame->offset_marker };
+	const int num[DTRACK_STAT_RECORDS] = { frame->num_body, frame->num_flystick, frame->num_meatool,
+			frame->num_mearef, frame->num_hand, frame->num_human, frame->num_marker };
+	const size_t size[DTRACK_STAT_RECORDS] = { sizeof(DTrack_Body_Type_d), sizeof(DTrack_FlyStick_Type_d), sizeof(DTrack_MeaTool_Type_d),
+			sizeof(DTrack_MeaRef_Type_d), sizeof(DTrack_Hand_Type_d), sizeof(DTrack_Human_Type_d), sizeof(DTrack_Marker_Type_d) };
+
+	// offsets are the same for all frames of a ring, numbers are always limited by the writer
+	if ((size_t )d_framesize < sizeof(DTrack_Shm_Frame_Type))
+		return false;
+	for (int i = 0; i < DTRACK_STAT_RECORDS; i++) {  // same record types as in statistics
+		if ((offset[i] < (int )sizeof(DTrack_Shm_Frame_Type)) || (num[i] < 0)
+				|| ((size_t )num[i] > ((size_t )d_framesize - offset[i]) / size[i]))
+			return false;
+	}
+	return true;
+}
+
+
+/**
+ *	\brief	Check if data of current frame is still unchanged.
+ *
+ *	Call after reading data through the getters; if false, the data is not consistent and
+ *	should be discarded (reader too slow, see DTrackSDK::enableSharedFrames()).
+ *	@return	data of current frame unchanged?
+ */
+bool DTrackFrameReader::isConsistent()
+{
+	if ((d_ring == NULL) || (d_frame == &d_empty))
+		return false;
+	return shm_frame_check(d_ring);
+}
+
+
+/**
+ * 	\brief	Copy records of current frame into a vector.
+ */
+template<typename T>
+static void copy_records(std::vector<T>& dst, int& dst_num, const DTrack_Shm_Frame_Type* frame, int offset, int num)
+{
+	const T* src = (const T* )((const char* )frame + offset);
+	dst.assign(src, src + num);
+	dst_num = num;
+}
+
+
+/**
+ *	\brief	Copy current frame.
+ *
+ *	Latency and statistics are not available.
+ *	@param[out]	frame	complete tracking data of current frame
+ *	@return	copy consistent? (false if no frame available or frame was overwritten)
+ */
+bool DTrackFrameReader::copyFrame(DTrack_Frame_Type_d& frame)
+{
+	const DTrack_Shm_Frame_Type* f = d_frame;
+
+	frame.framecounter = f->framecounter;
+	frame.timestamp = f->timestamp;
+	frame.rxtimestamp = f->rxtimestamp;
+	frame.latency = -1;
+	copy_records(frame.body, frame.num_body, f, f->offset_body, f->num_body);
+	copy_records(frame.flystick, frame.num_flystick, f, f->offset_flystick, f->num_flystick);
+	copy_records(frame.meatool, frame.num_meatool, f, f->offset_meatool, f->num_meatool);
+	copy_records(frame.mearef, frame.num_mearef, f, f->offset_mearef, f->num_mearef);
+	copy_records(frame.hand, frame.num_hand, f, f->offset_hand, f->num_hand);
+	copy_records(frame.human, frame.num_human, f, f->offset_human, f->num_human);
+	copy_records(frame.marker, frame.num_marker, f, f->offset_marker, f->num_marker);
+	memset(&frame.statistics, 0, sizeof(frame.statistics));
+	return isConsistent();
+}
+
+
+/**
+ *	\brief	Get number of frames written but not seen by update().
+ *
+ *	@return	number of missed frames since attaching
+ */
+unsigned int DTrackFrameReader::getMissedFrames()
+{
+	return d_missed;
+}
+
+
+/**
+ * 	\brief	Get frame counter.
+ *
+ *	Refers to current frame.
+ *	@return		frame counter
+ */
+unsigned int DTrackFrameReader::getFrameCounter()
+{
+	return d_frame->framecounter;
+}
+
+
+/**
+ * 	\brief	Get timestamp.
+ *
+ *	Refers to current frame.
+ *	@return		timestamp (-1 if information not available)
+ */
+double DTrackFrameReader::getTimeStamp()
+{
+	return d_frame->timestamp;
+}
+
+
+/**
+ * 	\brief	Get receive timestamp.
+ *
+ *	Refers to current frame, see DTrackSDK::getReceiveTimeStamp().
+ *	@return		receive timestamp in s (-1 if information not available)
+ */
+double DTrackFrameReader::getReceiveTimeStamp()
+{
+	return d_frame->rxtimestamp;
+}
+
+
+/**
+ * 	\brief	Get record of current frame.
+ */
+template<typename T>
+static const T* get_record(const DTrack_Shm_Frame_Type* frame, int offset, int num, int id)
+{
+	if ((id < 0) || (id >= num))
+		return NULL;
+	return (const T* )((const char* )frame + offset) + id;
+}
+
+
+/**
+ * 	\brief	Get number of standard bodies.
+ *
+ *	Refers to current frame.
+ *	@return		number of standard bodies
+ */
+int DTrackFrameReader::getNumBody()
+{
+	return d_frame->num_body;
+}
+
+
+/**
+ * 	\brief	Get standard body data.
+ *
+ *	Refers to current frame.
+ *	@param[in]	id	id, range 0 .. (number of standard bodies - 1)
+ *	@return		id-th standard body data, NULL if not available
+ */
+const DTrack_Body_Type_d* DTrackFrameReader::getBody(int id)
+{
+	return get_record<DTrack_Body_Type_d>(d_frame, d_frame->offset_body, d_frame->num_body, id);
+}
+
+
+/**
+ * 	\brief	Get number of Flysticks.
+ *
+ *	Refers to current frame.
+ *	@return		number of Flysticks
+ */
+int DTrackFrameReader::getNumFlyStick()
+{
+	return d_frame->num_flystick;
+}
+
+
+/**
+ * 	\brief	Get Flystick data.
+ *
+ *	Refers to current frame.
+ *	@param[in]	id	id, range 0 .. (number of Flysticks - 1)
+ *	@return		id-th Flystick data, NULL if not available
+ */
+const DTrack_FlyStick_Type_d* DTrackFrameReader::getFlyStick(int id)
+{
+	return get_record<DTrack_FlyStick_Type_d>(d_frame, d_frame->offset_flystick, d_frame->num_flystick, id);
+}
+
+
+/**
+ * 	\brief	Get number of measurement tools.
+ *
+ *	Refers to current frame.
+ *	@return		number of measurement tools
+ */
+int DTrackFrameReader::getNumMeaTool()
+{
+	return d_frame->num_meatool;
+}
+
+
+/**
+ * 	\brief	Get measurement tool data.
+ *
+ *	Refers to current frame.
+ *	@param[in]	id	id, range 0 .. (number of measurement tools - 1)
+ *	@return		id-th measurement tool data, NULL if not available
+ */
+const DTrack_MeaTool_Type_d* DTrackFrameReader::getMeaTool(int id)
+{
+	return get_record<DTrack_MeaTool_Type_d>(d_frame, d_frame->offset_meatool, d_frame->num_meatool, id);
+}
+
+
+/**
+ * 	\brief	Get number of measurement references.
+ *
+ *	Refers to current frame.
+ *	@return		number of measurement references
+ */
+int DTrackFrameReader::getNumMeaRef()
+{
+	return d_frame->num_mearef;
+}
+
+
+/**
+ * 	\brief	Get measurement reference data.
+ *
+ *	Refers to current frame.
+ *	@param[in]	id	id, range 0 .. (number of measurement references - 1)
+ *	@return		id-th measurement reference data, NULL if not available
+ */
+const DTrack_MeaRef_Type_d* DTrackFrameReader::getMeaRef(int id)
+{
+	return get_record<DTrack_MeaRef_Type_d>(d_frame, d_frame->offset_mearef, d_frame->num_mearef, id);
+}
+
+
+/**
+ * 	\brief	Get number of Fingertracking hands.
+ *
+ *	Refers to current frame.
+ *	@return		number of Fingertracking hands
+ */
+int DTrackFrameReader::getNumHand()
+{
+	return d_frame->num_hand;
+}
+
+
+/**
+ * 	\brief	Get Fingertracking hand data.
+ *
+ *	Refers to current frame.
+ *	@param[in]	id	id, range 0 .. (number of hands - 1)
+ *	@return		id-th Fingertracking hand data, NULL if not available
+ */
+const DTrack_Hand_Type_d* DTrackFrameReader::getHand(int id)
+{
+	return get_record<DTrack_Hand_Type_d>(d_frame, d_frame->offset_hand, d_frame->num_hand, id);
+}
+
+
+/**
+ * 	\brief	Get number of human models.
+ *
+ *	Refers to current frame.
+ *	@return		number of human models
+ */
+int DTrackFrameReader::getNumHuman()
+{
+	return d_frame->num_human;
+}
+
+
+/**
+ * 	\brief	Get human model data.
+ *
+ *	Refers to current frame.
+ *	@param[in]	id	id, range 0 .. (number of human models - 1)
+ *	@return		id-th human model data, NULL if not available
+ */
+const DTrack_Human_Type_d* DTrackFrameReader::getHuman(int id)
+{
+	return get_record<DTrack_Human_Type_d>(d_frame, d_frame->offset_human, d_frame->num_human, id);
+}
+
+
+/**
+ * 	\brief	Get number of single markers.
+ *
+ *	Refers to current frame.
+ *	@return		number of single markers
+ */
+int DTrackFrameReader::getNumMarker()
+{
+	return d_frame->num_marker;
+}
+
+
+/**
+ * 	\brief	Get single marker data.
+ *
+ *	Refers to current frame.
+ *	@param[in]	index	index, range 0 .. (number of markers - 1)
+ *	@return		i-th single marker data, NULL if not available
+ */
+const DTrack_Marker_Type_d* DTrackFrameReader::getMarker(int index)
+{
+	return get_record<DTrack_Marker_Type_d>(d_frame, d_frame->offset_marker, d_frame->num_marker, index);
+}
@@ -0,0 +1,268 @@
+/* DTrackFrameReader: C++ header file
+ *
+ * DTrackFrameReader: reads frames handed over by DTrackSDK through shared memory.
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Version v2.2.0
+ *
+ * Purpose:
+ *  - attaches read-only to frames written into shared memory by DTrackSDK::enableSharedFrames()
+ *    of another process
+ *  - gives access to the newest frame in place (no copy, no syscall as long as frames are available)
+ */
+
+#ifndef _ART_DTRACKFRAMEREADER_HPP_
+#define _ART_DTRACKFRAMEREADER_HPP_
+
+#include "Lib/DTrackDataTypes.h"
+#include "Lib/DTrackShm.h"
+
+using namespace DTrackSDK_Datatypes;
+
+#include <string>
+
+/**
+ * 	\brief Reader for frames in shared memory.
+ *
+ *	The getters refer to the frame of the last update() and point directly into shared memory.
+ *	The writer overwrites a frame after further frames (see DTrackSDK::enableSharedFrames()), so
+ *	data read through the getters is only consistent if isConsistent() is still true afterwards.
+ */
+class DTrackFrameReader
+{
+public:
+
+	/**
+	 * 	\brief	Constructor.
+	 *
+	 *	Attaching is retried by update(), if the frames are not available yet.
+	 *	@param[in]	name	name of shared memory (see DTrackSDK::enableSharedFrames())
+	 */
+	DTrackFrameReader(const std::string name);
+
+	/**
+	 * 	\brief	Destructor.
+	 */
+	~DTrackFrameReader();
+
+	/**
+	 * 	\brief	Is reader attached to frames in shared memory?
+	 *
+	 *	@return	attached?
+	 */
+	bool isAttached();
+
+	/**
+	 *	\brief	Get newest frame.
+	 *
+	 *	Waits for a frame newer than the current one. Attaches again automatically, if the writer
+	 *	has disabled and enabled its frames in the meantime, or if a new writer has replaced one that
+	 *	terminated without disabling them.
+	 *	@param[in]	tout_us		timeout in us; default is 1s (1,000,000 us)
+	 *	@return	newer frame available? (false if timeout or not attached)
+	 */
+	bool update(int tout_us = 1000000);
+
+	/**
+	 *	\brief	Check if data of current frame is still unchanged.
+	 *
+	 *	Call after reading data through the getters; if false, the data is not consistent and
+	 *	should be discarded (reader too slow, see DTrackSDK::enableSharedFrames()).
+	 *	@return	data of current frame unchanged?
+	 */
+	bool isConsistent();
+
+	/**
+	 *	\brief	Copy current frame.
+	 *
+	 *	Latency and statistics are not available.
+	 *	@param[out]	frame	complete tracking data of current frame
+	 *	@return	copy consistent? (false if no frame available or frame was overwritten)
+	 */
+	bool copyFrame(DTrack_Frame_Type_d& frame);
+
+	/**
+	 *	\brief	Get number of frames written but not seen by update().
+	 *
+	 *	@return	number of missed frames since attaching
+	 */
+	unsigned int getMissedFrames();
+
+	/**
+	 * 	\brief	Get frame counter.
+	 *
+	 *	Refers to current frame.
+	 *	@return		frame counter
+	 */
+	unsigned int getFrameCounter();
+
+	/**
+	 * 	\brief	Get timestamp.
+	 *
+	 *	Refers to current frame.
+	 *	@return		timestamp (-1 if information not available)
+	 */
+	double getTimeStamp();
+
+	/**
+	 * 	\brief	Get receive timestamp.
+	 *
+	 *	Refers to current frame, see DTrackSDK::getReceiveTimeStamp().
+	 *	@return		receive timestamp in s (-1 if information not available)
+	 */
+	double getReceiveTimeStamp();
+
+	/**
+	 * 	\brief	Get number of standard bodies.
+	 *
+	 *	Refers to current frame.
+	 *	@return		number of standard bodies
+	 */
+	int getNumBody();
+
+	/**
+	 * 	\brief	Get standard body data.
+	 *
+	 *	Refers to current frame.
+	 *	@param[in]	id	id, range 0 .. (number of standard bodies - 1)
+	 *	@return		id-th standard body data, NULL if not available
+	 */
+	const DTrack_Body_Type_d* getBody(int id);
+
+	/**
+	 * 	\brief	Get number of Flysticks.
+	 *
+	 *	Refers to current frame.
+	 *	@return		number of Flysticks
+	 */
+	int getNumFlyStick();
+
+	/**
+	 * 	\brief	Get Flystick data.
+	 *
+	 *	Refers to current frame.
+	 *	@param[in]	id	id, range 0 .. (number of Flysticks - 1)
+	 *	@return		id-th Flystick data, NULL if not available
+	 */
+	const DTrack_FlyStick_Type_d* getFlyStick(int id);
+
+	/**
+	 * 	\brief	Get number of measurement tools.
+	 *
+	 *	Refers to current frame.
+	 *	@return		number of measurement tools
+	 */
+	int getNumMeaTool();
+
+	/**
+	 * 	\brief	Get measurement tool data.
+	 *
+	 *	Refers to current frame.
+	 *	@param[in]	id	id, range 0 .. (number of measurement tools - 1)
+	 *	@return		id-th measurement tool data, NULL if not available
+	 */
+	const DTrack_MeaTool_Type_d* getMeaTool(int id);
+
+	/**
+	 * 	\brief	Get number of measurement references.
+	 *
+	 *	Refers to current frame.
+	 *	@return		number of measurement references
+	 */
+	int getNumMeaRef();
+
+	/**
+	 * 	\brief	Get measurement reference data.
+	 *
+	 *	Refers to current frame.
+	 *	@param[in]	id	id, range 0 .. (number of measurement references - 1)
+	 *	@return		id-th measurement reference data, NULL if not available
+	 */
+	const DTrack_MeaRef_Type_d* getMeaRef(int id);
+
+	/**
+	 * 	\brief	Get number of Fingertracking hands.
+	 *
+	 *	Refers to current frame.
+	 *	@return		number of Fingertracking hands
+	 */
+	int getNumHand();
+
+	/**
+	 * 	\brief	Get Fingertracking hand data.
+	 *
+	 *	Refers to current frame.
+	 *	@param[in]	id	id, range 0 .. (number of hands - 1)
+	 *	@return		id-th Fingertracking hand data, NULL if not available
+	 */
+	const DTrack_Hand_Type_d* getHand(int id);
+
+	/**
+	 * 	\brief	Get number of human models.
+	 *
+	 *	Refers to current frame.
+	 *	@return		number of human models
+	 */
+	int getNumHuman();
+
+	/**
+	 * 	\brief	Get human model data.
+	 *
+	 *	Refers to current frame.
+	 *	@param[in]	id	id, range 0 .. (number of human models - 1)
+	 *	@return		id-th human model data, NULL if not available
+	 */
+	const DTrack_Human_Type_d* getHuman(int id);
+
+	/**
+	 * 	\brief	Get number of single markers.
+	 *
+	 *	Refers to current frame.
+	 *	@return		number of single markers
+	 */
+	int getNumMarker();
+
+	/**
+	 * 	\brief	Get single marker data.
+	 *
+	 *	Refers to current frame.
+	 *	@param[in]	index	index, range 0 .. (number of markers - 1)
+	 *	@return		i-th single marker data, NULL if not available
+	 */
+	const DTrack_Marker_Type_d* getMarker(int index);
+
+private:
+
+	/**
+	 *	\brief	Check if records of a frame are located inside the frame.
+	 *
+	 *	@param[in]	frame	header of frame
+	 *	@return	frame valid?
+	 */
+	bool checkFrame(const DTrack_Shm_Frame_Type* frame);
+
+	std::string d_name;                   //!< name of shared memory
+	void* d_ring;                         //!< ring of frames (NULL if not attached)
+	int d_framesize;                      //!< size of frame
+	const DTrack_Shm_Frame_Type* d_frame; //!< current frame (d_empty if not available)
+	DTrack_Shm_Frame_Type d_empty;        //!< header without records (used if no frame is available)
+	unsigned int d_missed;                //!< number of missed frames
+};
+
+
+#endif /* _ART_DTRACKFRAMEREADER_HPP_ */
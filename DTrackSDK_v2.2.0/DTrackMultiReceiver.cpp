@@ -0,0 +1,347 @@
+/* DTrackMultiReceiver: C++ source file
+ *
+ * DTrackMultiReceiver: receives tracking data of several DTrackSDK instances in one thread.
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Version v2.2.0
+ *
+ * Purpose:
+ *  - waits for tracking data on the data ports (or multicast groups) of several DTrackSDK instances at once
+ *    (epoll on Linux, select() on other systems)
+ *  - processes the packets of whichever instance has got data, each instance keeps its own
+ *    settings (drain policy, lazy parsing, ...) and statistics
+ */
+
+#include "DTrackMultiReceiver.hpp"
+
+using namespace DTrackSDK_Net;
+using namespace DTrackSDK_Thread;
+
+#define THREAD_TIMEOUT_US  100000    // receiver thread: maximum time to wait for data before checking for stop
+
+
+/**
+ * 	\brief	Constructor.
+ *
+ *	@param[in]	data_timeout_us		timeout for receiving tracking data in us; default is 1s (1,000,000 us)
+ */
+DTrackMultiReceiver::DTrackMultiReceiver(int data_timeout_us)
+{
+	d_udptimeout_us = (data_timeout_us > 0) ? data_timeout_us : 1000000;
+	d_ready_pos = 0;
+	d_last_source = -1;
+	lastDataError = DTrackSDK::ERR_NONE;
+	d_thread = NULL;
+	d_thread_run = 0;
+
+	if (udp_poll_init(&d_poll)) {
+		d_poll = NULL;
+	}
+}
+
+
+/**
+ * 	\brief	Destructor.
+ *
+ *	Stops the receiver thread, the sources are not deleted.
+ */
+DTrackMultiReceiver::~DTrackMultiReceiver()
+{
+	stopReceiverThread();
+	udp_poll_exit(d_poll);
+}
+
+
+/**
+ * 	\brief	Check if initialization was successful.
+ *
+ *	@return	valid?
+ */
+bool DTrackMultiReceiver::isValid()
+{
+	return (d_poll != NULL);
+}
+
+
+/**
+ * 	\brief	Add source.
+ *
+ *	Not possible while the receiver thread is running, or if the source is receiving data itself.
+ *	@param[in]	sdk		DTrackSDK instance
+ *	@return	index of source (used by getLastSource(), latestFrame()), -1 if error occured
+ */
+int DTrackMultiReceiver::addSource(DTrackSDK* sdk)
+{
+	int source = (int )d_source.size();
+
+	if (!isValid() || (d_thread != NULL))
+		return -1;
+	if ((sdk == NULL) || (sdk->d_udpsock == NULL) || sdk->isReceiverThreadRunning())  // no UDP socket: e.g. local fan-out
+		return -1;
+	for (int i = 0; i < source; i++) {
+		if (d_source[i] == sdk)  // already added
+			return -1;
+	}
+
+	if (udp_poll_add(d_poll, sdk->d_udpsock, source))
+		return -1;
+
+	d_source.push_back(sdk);
+	d_poll_ids.resize(d_source.size());
+	return source;
+}
+
+
+/**
+ * 	\brief	Get number of sources.
+ *
+ *	@return	number of sources
+ */
+int DTrackMultiReceiver::getNumSource()
+{
+	return (int )d_source.size();
+}
+
+
+/**
+ * 	\brief	Get source.
+ *
+ *	@param[in]	source	index of source, range 0 .. num_source - 1
+ *	@return	DTrackSDK instance, NULL if not available
+ */
+DTrackSDK* DTrackMultiReceiver::getSource(int source)
+{
+	if ((source < 0) || (source >= (int )d_source.size()))
+		return NULL;
+	return d_source[source];
+}
+
+
+/**
+ * 	\brief	Set timeout for receiving tracking data.
+ *
+ * 	@param[in]	timeout		timeout for receiving tracking data of any source in us
+ * 	@return		Success? (i.e. valid timeout)
+ */
+bool DTrackMultiReceiver::setDataTimeoutUS(int timeout)
+{
+	if (timeout <= 0)
+		return false;
+	d_udptimeout_us = timeout;
+	return true;
+}
+
+
+/**
+ *	\brief	Receive and process one tracking data packet of any source.
+ *
+ *	Waits until one of the sources has got data, then processes it like DTrackSDK::receive() of
+ *	this source. Sources with data available at the same time are processed in turn by the
+ *	following calls, so a source with high frame rate does not block the others.
+ *	The data is available through the getters of the source (see getLastSource()).
+ *	@return	receive succeeded?
+ */
+bool DTrackMultiReceiver::receive()
+{
+	if (d_thread != NULL) {  // data is received by receiver thread
+		d_last_source = -1;
+		return false;
+	}
+	return receiveData(d_udptimeout_us);
+}
+
+
+/**
+ *	\brief	Receive and process one tracking data packet of any source.
+ *
+ *	@param[in]	tout_us		timeout for receiving tracking data in us
+ *	@return	receive succeeded?
+ */
+bool DTrackMultiReceiver::receiveData(int tout_us)
+{
+	int i, n, source;
+	DTrackSDK* sdk;
+
+	lastDataError = DTrackSDK::ERR_NONE;
+	d_last_source = -1;
+
+	if (!isValid() || d_source.empty()) {
+		lastDataError = DTrackSDK::ERR_NET;
+		return false;
+	}
+
+	if (d_ready_pos >= (int )d_ready.size()) {  // all sources of last round processed: wait for data
+		d_ready.clear();
+		d_ready_pos = 0;
+		for (i = 0; i < (int )d_source.size(); i++) {
+			if (d_source[i]->d_udpcount > 0) {  // queued packets left (DRAIN_ALL): no need to wait
+				d_ready.push_back(i);
+			}
+		}
+		n = udp_poll_wait(d_poll, &d_poll_ids[0], (int )d_poll_ids.size(), d_ready.empty() ? tout_us : 0);
+		for (i = 0; i < n; i++) {
+			if (d_source[d_poll_ids[i]]->d_udpcount == 0) {  // otherwise already in list
+				d_ready.push_back(d_poll_ids[i]);
+			}
+		}
+		if (d_ready.empty()) {
+			lastDataError = (n == -1) ? DTrackSDK::ERR_TIMEOUT : DTrackSDK::ERR_NET;
+			return false;
+		}
+	}
+
+	while (d_ready_pos < (int )d_ready.size()) {
+		source = d_ready[d_ready_pos++];
+		sdk = d_source[source];
+		if (sdk->receiveData(0)) {
+			d_last_source = source;
+			return true;
+		}
+		if (sdk->lastDataError != DTrackSDK::ERR_TIMEOUT) {  // timeout: no data after all, try next source
+			d_last_source = source;
+			lastDataError = sdk->lastDataError;
+			sdk->statError();
+			return false;
+		}
+	}
+	lastDataError = DTrackSDK::ERR_TIMEOUT;
+	return false;
+}
+
+
+/**
+ *	\brief	Get source of last receive().
+ *
+ *	@return	index of source, -1 if no source got data (timeout, network error)
+ */
+int DTrackMultiReceiver::getLastSource()
+{
+	return d_last_source;
+}
+
+
+/**
+ * 	\brief	Get last error at receiving data (data transmission).
+ *
+ *	Refers to last receive(); details for a source are available through DTrackSDK::getLastDataError().
+ *	@return		last data error
+ */
+DTrackSDK::Errors DTrackMultiReceiver::getLastDataError()
+{
+	return lastDataError;
+}
+
+
+/**
+ *	\brief	Start receiver thread.
+ *
+ *	One thread receives and processes tracking data of all sources in the background, complete
+ *	frames are handed over through DTrackSDK::latestFrame() of each source (see latestFrame()).
+ *	While the thread is running, receive() fails and no sources can be added.
+ *	@return	thread started? (false if already running, without sources or on error)
+ */
+bool DTrackMultiReceiver::startReceiverThread()
+{
+	int i;
+
+	if ((d_thread != NULL) || !isValid() || d_source.empty())
+		return false;
+	for (i = 0; i < (int )d_source.size(); i++) {
+		if (d_source[i]->isReceiverThreadRunning())  // source started its own thread in the meantime
+			return false;
+	}
+
+	for (i = 0; i < (int )d_source.size(); i++) {
+		d_source[i]->initFrames();
+		d_source[i]->d_thread_external = true;
+	}
+	d_thread_run = 1;
+	if (thread_start(&d_thread, receiverThread, this)) {
+		d_thread = NULL;
+		d_thread_run = 0;
+		for (i = 0; i < (int )d_source.size(); i++) {
+			d_source[i]->d_thread_external = false;
+		}
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ *	\brief	Stop receiver thread.
+ *
+ *	Waits until the thread has finished (at most 100 ms).
+ */
+void DTrackMultiReceiver::stopReceiverThread()
+{
+	if (d_thread == NULL)
+		return;
+	atomic_store(&d_thread_run, 0);
+	thread_join(d_thread);
+	d_thread = NULL;
+	for (int i = 0; i < (int )d_source.size(); i++) {
+		d_source[i]->d_thread_external = false;
+	}
+}
+
+
+/**
+ *	\brief	Is receiver thread running?
+ *
+ *	@return	thread running?
+ */
+bool DTrackMultiReceiver::isReceiverThreadRunning()
+{
+	return (d_thread != NULL);
+}
+
+
+/**
+ *	\brief	Get latest frame of a source processed by the receiver thread.
+ *
+ *	Same as DTrackSDK::latestFrame() of the source.
+ *	@param[in]	source	index of source, range 0 .. num_source - 1
+ *	@return	latest frame, NULL if no frame is available yet
+ */
+const DTrack_Frame_Type_d* DTrackMultiReceiver::latestFrame(int source)
+{
+	if ((source < 0) || (source >= (int )d_source.size()))
+		return NULL;
+	return d_source[source]->latestFrame();
+}
+
+
+/**
+ *	\brief	Main loop of receiver thread.
+ *
+ *	@param[in]	arg		DTrackMultiReceiver instance
+ */
+void DTrackMultiReceiver::receiverThread(void* arg)
+{
+	DTrackMultiReceiver* mr = (DTrackMultiReceiver* )arg;
+	int tout_us = (mr->d_udptimeout_us < THREAD_TIMEOUT_US) ? mr->d_udptimeout_us : THREAD_TIMEOUT_US;
+
+	while (atomic_load(&mr->d_thread_run)) {
+		if (mr->receiveData(tout_us)) {  // errors of sources are counted by receiveData()
+			mr->d_source[mr->d_last_source]->publishFrame();
+		} else if (mr->lastDataError == DTrackSDK::ERR_NET) {  // fails without waiting: don't retry at once
+			thread_sleep(tout_us);
+		}
+	}
+}
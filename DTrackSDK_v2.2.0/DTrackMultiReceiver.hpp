@@ -0,0 +1,191 @@
+/* DTrackMultiReceiver: C++ header file
+ *
+ * DTrackMultiReceiver: receives tracking data of several DTrackSDK instances in one thread.
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Version v2.2.0
+ *
+ * Purpose:
+ *  - waits for tracking data on the data ports (or multicast groups) of several DTrackSDK instances at once
+ *    (epoll on Linux, select() on other systems)
+ *  - processes the packets of whichever instance has got data, each instance keeps its own
+ *    settings (drain policy, lazy parsing, ...) and statistics
+ */
+
+#ifndef _ART_DTRACKMULTIRECEIVER_HPP_
+#define _ART_DTRACKMULTIRECEIVER_HPP_
+
+#include "DTrackSDK.hpp"
+
+#include <vector>
+
+/**
+ * 	\brief Receiver for several DTrackSDK instances ('sources') in one thread.
+ *
+ *	The sources must receive through a valid UDP socket (i.e. not from a local fan-out) and must
+ *	exist as long as the receiver is used. Tracking data of a source is only received through this class, i.e.
+ *	DTrackSDK::receive() of the source must not be used.
+ */
+class DTrackMultiReceiver
+{
+public:
+
+	/**
+	 * 	\brief	Constructor.
+	 *
+	 *	@param[in]	data_timeout_us		timeout for receiving tracking data in us; default is 1s (1,000,000 us)
+	 */
+	DTrackMultiReceiver(int data_timeout_us = 1000000);
+
+	/**
+	 * 	\brief	Destructor.
+	 *
+	 *	Stops the receiver thread, the sources are not deleted.
+	 */
+	~DTrackMultiReceiver();
+
+	/**
+	 * 	\brief	Check if initialization was successful.
+	 *
+	 *	@return	valid?
+	 */
+	bool isValid();
+
+	/**
+	 * 	\brief	Add source.
+	 *
+	 *	Not possible while the receiver thread is running, or if the source is receiving data itself.
+	 *	@param[in]	sdk		DTrackSDK instance
+	 *	@return	index of source (used by getLastSource(), latestFrame()), -1 if error occured
+	 */
+	int addSource(DTrackSDK* sdk);
+
+	/**
+	 * 	\brief	Get number of sources.
+	 *
+	 *	@return	number of sources
+	 */
+	int getNumSource();
+
+	/**
+	 * 	\brief	Get source.
+	 *
+	 *	@param[in]	source	index of source, range 0 .. num_source - 1
+	 *	@return	DTrackSDK instance, NULL if not available
+	 */
+	DTrackSDK* getSource(int source);
+
+	/**
+	 * 	\brief	Set timeout for receiving tracking data.
+	 *
+	 * 	@param[in]	timeout		timeout for receiving tracking data of any source in us
+	 * 	@return		Success? (i.e. valid timeout)
+	 */
+	bool setDataTimeoutUS(int timeout);
+
+	/**
+	 *	\brief	Receive and process one tracking data packet of any source.
+	 *
+	 *	Waits until one of the sources has got data, then processes it like DTrackSDK::receive() of
+	 *	this source. Sources with data available at the same time are processed in turn by the
+	 *	following calls, so a source with high frame rate does not block the others.
+	 *	The data is available through the getters of the source (see getLastSource()).
+	 *	@return	receive succeeded?
+	 */
+	bool receive();
+
+	/**
+	 *	\brief	Get source of last receive().
+	 *
+	 *	@return	index of source, -1 if no source got data (timeout, network error)
+	 */
+	int getLastSource();
+
+	/**
+	 * 	\brief	Get last error at receiving data (data transmission).
+	 *
+	 *	Refers to last receive(); details for a source are available through DTrackSDK::getLastDataError().
+	 *	@return		last data error
+	 */
+	DTrackSDK::Errors getLastDataError();
+
+	/**
+	 *	\brief	Start receiver thread.
+	 *
+	 *	One thread receives and processes tracking data of all sources in the background, complete
+	 *	frames are handed over through DTrackSDK::latestFrame() of each source (see latestFrame()).
+	 *	While the thread is running, receive() fails and no sources can be added.
+	 *	@return	thread started? (false if already running, without sources or on error)
+	 */
+	bool startReceiverThread();
+
+	/**
+	 *	\brief	Stop receiver thread.
+	 *
+	 *	Waits until the thread has finished (at most 100 ms).
+	 */
+	void stopReceiverThread();
+
+	/**
+	 *	\brief	Is receiver thread running?
+	 *
+	 *	@return	thread running?
+	 */
+	bool isReceiverThreadRunning();
+
+	/**
+	 *	\brief	Get latest frame of a source processed by the receiver thread.
+	 *
+	 *	Same as DTrackSDK::latestFrame() of the source.
+	 *	@param[in]	source	index of source, range 0 .. num_source - 1
+	 *	@return	latest frame, NULL if no frame is available yet
+	 */
+	const DTrack_Frame_Type_d* latestFrame(int source);
+
+private:
+
+	/**
+	 *	\brief	Receive and process one tracking data packet of any source.
+	 *
+	 *	@param[in]	tout_us		timeout for receiving tracking data in us
+	 *	@return	receive succeeded?
+	 */
+	bool receiveData(int tout_us);
+
+	/**
+	 *	\brief	Main loop of receiver thread.
+	 *
+	 *	@param[in]	arg		DTrackMultiReceiver instance
+	 */
+	static void receiverThread(void* arg);
+
+	void* d_poll;                     //!< poll set containing the sockets of all sources
+	int d_udptimeout_us;              //!< timeout for receiving UDP data
+	std::vector<DTrackSDK*> d_source; //!< sources
+	std::vector<int> d_poll_ids;      //!< buffer for sources reported by the poll set
+	std::vector<int> d_ready;         //!< sources with data available, in order of processing
+	int d_ready_pos;                  //!< next entry of d_ready to be processed
+	int d_last_source;                //!< source of last receive() (-1 if none)
+	DTrackSDK::Errors lastDataError;  //!< last data error
+
+	void* d_thread;                   //!< receiver thread (NULL if not running)
+	volatile int d_thread_run;        //!< receiver thread: keep running?
+};
+
+
+#endif /* _ART_DTRACKMULTIRECEIVER_HPP_ */
@@ -0,0 +1,439 @@
+/* DTrackPredictor: C++ source file
+ *
+ * DTrackPredictor: extrapolates poses of standard bodies and Fingertracking hands.
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Version v2.2.0
+ *
+ * Purpose:
+ *  - keeps the poses of the last frames of each standard body, hand and finger
+ *  - extrapolates them to a given time (e.g. the time a rendered image will be displayed), to
+ *    compensate for the latency between measurement and display
+ */
+
+#include "DTrackPredictor.hpp"
+
+#include <string.h>
+
+using namespace DTrackSDK_Pose;
+
+#define PREDICT_MAX_GAP  0.25   // max time between two frames of a target in s (otherwise motion is unknown)
+#define HAND_POSES       (1 + DTRACK_HAND_MAX_FINGER)  // poses per hand: back of the hand and fingers
+
+
+/**
+ * 	\brief	Constructor.
+ *
+ *	@param[in]	model		motion model
+ *	@param[in]	max_pred	max time of extrapolation in s (see setMaxPrediction()); default is 100 ms
+ */
+DTrackPredictor::DTrackPredictor(Model model, double max_pred)
+{
+	d_model = model;
+	d_maxpred = 0.1;
+	setMaxPrediction(max_pred);
+	d_time = -1;
+}
+
+
+/**
+ * 	\brief	Set motion model.
+ *
+ *	@param[in]	model		motion model
+ */
+void DTrackPredictor::setModel(Model model)
+{
+	d_model = model;
+}
+
+
+/**
+ * 	\brief	Get motion model.
+ *
+ *	@return	motion model
+ */
+DTrackPredictor::Model DTrackPredictor::getModel()
+{
+	return d_model;
+}
+
+
+/**
+ * 	\brief	Set max time of extrapolation.
+ *
+ *	@param[in]	max_pred	max time of extrapolation in s
+ *	@return	Success? (i.e. valid time)
+ */
+bool DTrackPredictor::setMaxPrediction(double max_pred)
+{
+	if (!(max_pred >= 0))
+		return false;
+
+	d_maxpred = max_pred;
+	return true;
+}
+
+
+/**
+ * 	\brief	Get max time of extrapolation.
+ *
+ *	@return	max time of extrapolation in s
+ */
+double DTrackPredictor::getMaxPrediction()
+{
+	return d_maxpred;
+}
+
+
+/**
+ * 	\brief	Forget all frames.
+ */
+void DTrackPredictor::reset()
+{
+	d_time = -1;
+	d_body.clear();
+	d_body_track.clear();
+	d_body_hist.clear();
+	d_hand.clear();
+	d_hand_track.clear();
+	d_hand_hist.clear();
+}
+
+
+/**
+ * 	\brief	Add last received frame.
+ *
+ *	Uses the compact poses of the instance (see DTrackSDK::setCompactPoses()).
+ *	@param[in]	dt		DTrackSDK instance
+ *	@return	frame added? (false if no timestamp is available or frame is not newer than last one)
+ */
+bool DTrackPredictor::update(DTrackSDK* dt)
+{
+	int i;
+
+	if (!beginFrame(dt->getTimeStamp(), dt->getNumBody(), dt->getNumHand()))
+		return false;
+
+	for (i=0; i<(int )d_body.size(); i++) {
+		addBody(i, *dt->getBodyPose(i));
+	}
+	for (i=0; i<(int )d_hand.size(); i++) {
+		addHand(i, *dt->getHandPose(i));
+	}
+	return true;
+}
+
+
+/**
+ * 	\brief	Add frame processed by a receiver thread.
+ *
+ *	@param[in]	frame	frame (see DTrackSDK::latestFrame())
+ *	@return	frame added? (false if no timestamp is available or frame is not newer than last one)
+ */
+bool DTrackPredictor::update(const DTrack_Frame_Type_d& frame)
+{
+	DTrack_Body_Pose_Type body;
+	DTrack_Hand_Pose_Type hand;
+	int i;
+
+	int nbody = (frame.num_body < (int )frame.body.size()) ? frame.num_body : (int )frame.body.size();
+	int nhand = (frame.num_hand < (int )frame.hand.size()) ? frame.num_hand : (int )frame.hand.size();
+
+	if (!beginFrame(frame.timestamp, nbody, nhand))
+		return false;
+
+	for (i=0; i<nbody; i++) {
+		pose_convert(body, frame.body[i]);
+		addBody(i, body);
+	}
+	for (i=0; i<nhand; i++) {
+		pose_convert(hand, frame.hand[i]);
+		addHand(i, hand);
+	}
+	return true;
+}
+
+
+/**
+ * 	\brief	Get timestamp of last frame.
+ *
+ *	@return	timestamp (-1 if no frame is available)
+ */
+double DTrackPredictor::getTimeStamp()
+{
+	return d_time;
+}
+
+
+/**
+ * 	\brief	Get number of standard bodies.
+ *
+ *	@return	number of standard bodies of last frame
+ */
+int DTrackPredictor::getNumBody()
+{
+	return (int )d_body.size();
+}
+
+
+/**
+ * 	\brief	Get number of Fingertracking hands.
+ *
+ *	@return	number of hands of last frame
+ */
+int DTrackPredictor::getNumHand()
+{
+	return (int )d_hand.size();
+}
+
+
+/**
+ * 	\brief	Get extrapolated pose of standard body.
+ *
+ *	Without motion known yet (first frame after tracking started), the pose of the last frame is returned.
+ *	@param[in]	id		id, range 0 .. (number of standard bodies - 1)
+ *	@param[in]	time	time to extrapolate to (time base of DTrack timestamp, in s)
+ *	@param[out]	body	extrapolated standard body data; data of last frame, if not tracked
+ *	@return	tracked in last frame? (false also if id is not available)
+ */
+bool DTrackPredictor::predictBody(int id, double time, DTrack_Body_Pose_Type& body)
+{
+	if ((id < 0) || (id >= (int )d_body.size()))
+		return false;
+
+	body = d_body[id];
+	if (d_body_track[id].num == 0)
+		return false;
+
+	predictPoses(d_body_track[id], &d_body_hist[id * DTRACK_PREDICT_HISTORY], time, &body.pose, 1);
+	return true;
+}
+
+
+/**
+ * 	\brief	Get extrapolated poses of Fingertracking hand (back of the hand and fingers).
+ *
+ *	Without motion known yet (first frame after tracking started), the poses of the last frame are returned.
+ *	@param[in]	id		id, range 0 .. (number of hands - 1)
+ *	@param[in]	time	time to extrapolate to (time base of DTrack timestamp, in s)
+ *	@param[out]	hand	extrapolated hand data; data of last frame, if not tracked
+ *	@return	tracked in last frame? (false also if id is not available)
+ */
+bool DTrackPredictor::predictHand(int id, double time, DTrack_Hand_Pose_Type& hand)
+{
+	DTrack_Pose_Type_f pose[HAND_POSES];
+
+	if ((id < 0) || (id >= (int )d_hand.size()))
+		return false;
+
+	hand = d_hand[id];
+	if (d_hand_track[id].num == 0)
+		return false;
+
+	predictPoses(d_hand_track[id], &d_hand_hist[id * DTRACK_PREDICT_HISTORY * HAND_POSES], time, pose, HAND_POSES);
+
+	hand.pose = pose[0];
+	for (int j=0; j<hand.nfinger; j++) {
+		hand.finger[j] = pose[1 + j];
+	}
+	return true;
+}
+
+
+/**
+ * 	\brief	Start adding a frame.
+ *
+ *	@param[in]	timestamp	timestamp of frame
+ *	@param[in]	nbody		number of standard bodies
+ *	@param[in]	nhand		number of hands
+ *	@return	frame newer than last one?
+ */
+bool DTrackPredictor::beginFrame(double timestamp, int nbody, int nhand)
+{
+	if (timestamp < 0)  // no timestamp, motion can't be estimated
+		return false;
+
+	if (d_time >= 0) {
+		if (timestamp == d_time)  // same frame again
+			return false;
+		if (timestamp < d_time)  // time base changed (e.g. midnight, restart of DTrack): motion unknown
+			reset();
+	}
+	d_time = timestamp;
+
+	// new targets are not tracked yet:
+	Track empty;
+	memset(&empty, 0, sizeof(empty));
+
+	d_body.resize(nbody);
+	d_body_track.resize(nbody, empty);
+	d_body_hist.resize(nbody * DTRACK_PREDICT_HISTORY);
+	d_hand.resize(nhand);
+	d_hand_track.resize(nhand, empty);
+	d_hand_hist.resize(nhand * DTRACK_PREDICT_HISTORY * HAND_POSES);
+	return true;
+}
+
+
+/**
+ * 	\brief	Add standard body of current frame.
+ *
+ *	@param[in]	i		index of standard body
+ *	@param[in]	body	standard body data
+ */
+void DTrackPredictor::addBody(int i, const DTrack_Body_Pose_Type& body)
+{
+	d_body[i] = body;
+	addPoses(d_body_track[i], &d_body_hist[i * DTRACK_PREDICT_HISTORY], &body.pose, 1, body.quality >= 0);
+}
+
+
+/**
+ * 	\brief	Add hand of current frame.
+ *
+ *	@param[in]	i		index of hand
+ *	@param[in]	hand	hand data
+ */
+void DTrackPredictor::addHand(int i, const DTrack_Hand_Pose_Type& hand)
+{
+	DTrack_Pose_Type_f pose[HAND_POSES];
+
+	if (hand.nfinger != d_hand[i].nfinger) {  // other fingers: motion unknown
+		d_hand_track[i].num = 0;
+	}
+	d_hand[i] = hand;
+
+	pose[0] = hand.pose;
+	for (int j=0; j<DTRACK_HAND_MAX_FINGER; j++) {
+		pose[1 + j] = hand.finger[j];
+	}
+	addPoses(d_hand_track[i], &d_hand_hist[i * DTRACK_PREDICT_HISTORY * HAND_POSES], pose, HAND_POSES, hand.quality >= 0);
+}
+
+
+/**
+ * 	\brief	Add poses of one target to its frames.
+ *
+ *	@param[in,out]	track	frames of target
+ *	@param[in,out]	hist	poses of frames of target (DTRACK_PREDICT_HISTORY * npose)
+ *	@param[in]		pose	poses of current frame (npose)
+ *	@param[in]		npose	number of poses per frame
+ *	@param[in]		tracked	target tracked in current frame?
+ */
+void DTrackPredictor::addPoses(Track& track, DTrack_Pose_Type_f* hist, const DTrack_Pose_Type_f* pose, int npose, bool tracked)
+{
+	if (!tracked) {
+		track.num = 0;
+		return;
+	}
+	if ((track.num > 0) && (d_time - track.time[0] > PREDICT_MAX_GAP)) {  // target was lost in between
+		track.num = 0;
+	}
+
+	// newest frame first:
+	int n = (track.num < DTRACK_PREDICT_HISTORY) ? track.num : DTRACK_PREDICT_HISTORY - 1;
+	for (int k=n; k>0; k--) {
+		track.time[k] = track.time[k - 1];
+		memcpy(&hist[k * npose], &hist[(k - 1) * npose], npose * sizeof(DTrack_Pose_Type_f));
+	}
+	track.time[0] = d_time;
+	memcpy(hist, pose, npose * sizeof(DTrack_Pose_Type_f));
+	track.num = n + 1;
+}
+
+
+/**
+ * 	\brief	Extrapolate poses of one target.
+ *
+ *	Location: with the mean velocities v01 (between the last two frames) and v12 (between the two
+ *	frames before), the acceleration is a = (v01 - v12) / ((h1 + h2) / 2) and the velocity at the
+ *	last frame is v = v01 + a * h1 / 2 (h1, h2: time between the frames). Rotation: the same with
+ *	angular velocities, taken from the relative rotation between two frames (rotation vector).
+ *	@param[in]	track	frames of target
+ *	@param[in]	hist	poses of frames of target (DTRACK_PREDICT_HISTORY * npose)
+ *	@param[in]	time	time to extrapolate to
+ *	@param[out]	pose	extrapolated poses (npose)
+ *	@param[in]	npose	number of poses per frame
+ */
+void DTrackPredictor::predictPoses(const Track& track, const DTrack_Pose_Type_f* hist, double time, DTrack_Pose_Type_f* pose, int npose)
+{
+	int order = (d_model == MODEL_ACCELERATION) ? 2 : 1;
+	if (order > track.num - 1) {
+		order = track.num - 1;
+	}
+
+	double dt = time - track.time[0];
+	if (dt > d_maxpred) {
+		dt = d_maxpred;
+	} else if (dt < -d_maxpred) {
+		dt = -d_maxpred;
+	}
+
+	if ((order == 0) || (dt == 0)) {  // no motion known
+		memcpy(pose, hist, npose * sizeof(DTrack_Pose_Type_f));
+		return;
+	}
+
+	double h1 = track.time[0] - track.time[1];
+	double h2 = (order == 2) ? track.time[1] - track.time[2] : 0;
+
+	for (int j=0; j<npose; j++) {
+		const DTrack_Pose_Type_f& p0 = hist[j];
+		const DTrack_Pose_Type_f& p1 = hist[npose + j];
+		float dq[4], w01[3], w12[3], rv[3], q[4];
+		double v, a;
+		int k;
+
+		// angular velocity between last two frames (in room or hand coordinates):
+		float q1inv[4] = { p1.quat[0], -p1.quat[1], -p1.quat[2], -p1.quat[3] };
+		quat_mult(dq, p0.quat, q1inv);
+		quat_log(w01, dq);
+
+		if (order == 2) {
+			const DTrack_Pose_Type_f& p2 = hist[2 * npose + j];
+			float q2inv[4] = { p2.quat[0], -p2.quat[1], -p2.quat[2], -p2.quat[3] };
+			quat_mult(dq, p1.quat, q2inv);
+			quat_log(w12, dq);
+
+			for (k=0; k<3; k++) {
+				double v01 = (p0.loc[k] - p1.loc[k]) / h1;
+				double v12 = (p1.loc[k] - p2.loc[k]) / h2;
+				a = (v01 - v12) / ((h1 + h2) / 2);
+				v = v01 + a * h1 / 2;
+				pose[j].loc[k] = (float )(p0.loc[k] + v * dt + a * dt * dt / 2);
+
+				v01 = w01[k] / h1;
+				v12 = w12[k] / h2;
+				a = (v01 - v12) / ((h1 + h2) / 2);
+				v = v01 + a * h1 / 2;
+				rv[k] = (float )(v * dt + a * dt * dt / 2);
+			}
+		} else {
+			for (k=0; k<3; k++) {
+				v = (p0.loc[k] - p1.loc[k]) / h1;
+				pose[j].loc[k] = (float )(p0.loc[k] + v * dt);
+				rv[k] = (float )(w01[k] / h1 * dt);
+			}
+		}
+
+		// rotate last orientation further:
+		quat_exp(dq, rv);
+		quat_mult(q, dq, p0.quat);
+		memcpy(pose[j].quat, q, sizeof(q));
+	}
+}
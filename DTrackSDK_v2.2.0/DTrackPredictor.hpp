@@ -0,0 +1,233 @@
+/* DTrackPredictor: C++ header file
+ *
+ * DTrackPredictor: extrapolates poses of standard bodies and Fingertracking hands.
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Version v2.2.0
+ *
+ * Purpose:
+ *  - keeps the poses of the last frames of each standard body, hand and finger
+ *  - extrapolates them to a given time (e.g. the time a rendered image will be displayed), to
+ *    compensate for the latency between measurement and display
+ */
+
+#ifndef _ART_DTRACKPREDICTOR_HPP_
+#define _ART_DTRACKPREDICTOR_HPP_
+
+#include "DTrackSDK.hpp"
+
+#include <vector>
+
+//! Number of frames kept per target
+#define DTRACK_PREDICT_HISTORY 3
+
+/**
+ * 	\brief Extrapolation of poses to compensate for latency.
+ *
+ *	Feed every frame through update(), then get poses extrapolated to the desired time through
+ *	predictBody() and predictHand(). Times are given in the time base of the DTrack timestamp (see
+ *	DTrackSDK::getTimeStamp()), i.e. the time of measurement; to predict to the time of display, add
+ *	the total latency from measurement to display to the timestamp of the last frame.
+ *	Locations are extrapolated linearly (constant velocity) or quadratically (constant acceleration),
+ *	orientations likewise using the angular velocity (and acceleration) from quaternions. Fingers are
+ *	extrapolated in the hand coordinate system, independently of the back of the hand.
+ */
+class DTrackPredictor
+{
+public:
+
+	//! Motion models
+	enum Model {
+		MODEL_VELOCITY,     //!< constant velocity (needs two frames)
+		MODEL_ACCELERATION  //!< constant acceleration (needs three frames; follows faster, but amplifies noise)
+	};
+
+	/**
+	 * 	\brief	Constructor.
+	 *
+	 *	@param[in]	model		motion model
+	 *	@param[in]	max_pred	max time of extrapolation in s (see setMaxPrediction()); default is 100 ms
+	 */
+	DTrackPredictor(Model model = MODEL_VELOCITY, double max_pred = 0.1);
+
+	/**
+	 * 	\brief	Set motion model.
+	 *
+	 *	@param[in]	model		motion model
+	 */
+	void setModel(Model model);
+
+	/**
+	 * 	\brief	Get motion model.
+	 *
+	 *	@return	motion model
+	 */
+	Model getModel();
+
+	/**
+	 * 	\brief	Set max time of extrapolation.
+	 *
+	 *	Extrapolation to a time further away from the last frame is limited to this time, as
+	 *	errors grow fast with the extrapolation time.
+	 *	@param[in]	max_pred	max time of extrapolation in s
+	 *	@return	Success? (i.e. valid time)
+	 */
+	bool setMaxPrediction(double max_pred);
+
+	/**
+	 * 	\brief	Get max time of extrapolation.
+	 *
+	 *	@return	max time of extrapolation in s
+	 */
+	double getMaxPrediction();
+
+	/**
+	 * 	\brief	Forget all frames.
+	 */
+	void reset();
+
+	/**
+	 * 	\brief	Add last received frame.
+	 *
+	 *	Uses the compact poses of the instance (see DTrackSDK::setCompactPoses()).
+	 *	@param[in]	dt		DTrackSDK instance
+	 *	@return	frame added? (false if no timestamp is available or frame is not newer than last one)
+	 */
+	bool update(DTrackSDK* dt);
+
+	/**
+	 * 	\brief	Add frame processed by a receiver thread.
+	 *
+	 *	@param[in]	frame	frame (see DTrackSDK::latestFrame())
+	 *	@return	frame added? (false if no timestamp is available or frame is not newer than last one)
+	 */
+	bool update(const DTrack_Frame_Type_d& frame);
+
+	/**
+	 * 	\brief	Get timestamp of last frame.
+	 *
+	 *	@return	timestamp (-1 if no frame is available)
+	 */
+	double getTimeStamp();
+
+	/**
+	 * 	\brief	Get number of standard bodies.
+	 *
+	 *	@return	number of standard bodies of last frame
+	 */
+	int getNumBody();
+
+	/**
+	 * 	\brief	Get number of Fingertracking hands.
+	 *
+	 *	@return	number of hands of last frame
+	 */
+	int getNumHand();
+
+	/**
+	 * 	\brief	Get extrapolated pose of standard body.
+	 *
+	 *	Without motion known yet (first frame after tracking started), the pose of the last frame is returned.
+	 *	@param[in]	id		id, range 0 .. (number of standard bodies - 1)
+	 *	@param[in]	time	time to extrapolate to (time base of DTrack timestamp, in s)
+	 *	@param[out]	body	extrapolated standard body data; data of last frame, if not tracked
+	 *	@return	tracked in last frame? (false also if id is not available)
+	 */
+	bool predictBody(int id, double time, DTrack_Body_Pose_Type& body);
+
+	/**
+	 * 	\brief	Get extrapolated poses of Fingertracking hand (back of the hand and fingers).
+	 *
+	 *	Without motion known yet (first frame after tracking started), the poses of the last frame are returned.
+	 *	@param[in]	id		id, range 0 .. (number of hands - 1)
+	 *	@param[in]	time	time to extrapolate to (time base of DTrack timestamp, in s)
+	 *	@param[out]	hand	extrapolated hand data; data of last frame, if not tracked
+	 *	@return	tracked in last frame? (false also if id is not available)
+	 */
+	bool predictHand(int id, double time, DTrack_Hand_Pose_Type& hand);
+
+private:
+
+	//! Frames kept of one target (newest first)
+	struct Track {
+		int num;                               //!< number of frames kept
+		double time[DTRACK_PREDICT_HISTORY];   //!< timestamps of frames
+	};
+
+	/**
+	 * 	\brief	Start adding a frame.
+	 *
+	 *	@param[in]	timestamp	timestamp of frame
+	 *	@param[in]	nbody		number of standard bodies
+	 *	@param[in]	nhand		number of hands
+	 *	@return	frame newer than last one?
+	 */
+	bool beginFrame(double timestamp, int nbody, int nhand);
+
+	/**
+	 * 	\brief	Add standard body of current frame.
+	 *
+	 *	@param[in]	i		index of standard body
+	 *	@param[in]	body	standard body data
+	 */
+	void addBody(int i, const DTrack_Body_Pose_Type& body);
+
+	/**
+	 * 	\brief	Add hand of current frame.
+	 *
+	 *	@param[in]	i		index of hand
+	 *	@param[in]	hand	hand data
+	 */
+	void addHand(int i, const DTrack_Hand_Pose_Type& hand);
+
+	/**
+	 * 	\brief	Add poses of one target to its frames.
+	 *
+	 *	@param[in,out]	track	frames of target
+	 *	@param[in,out]	hist	poses of frames of target (DTRACK_PREDICT_HISTORY * npose)
+	 *	@param[in]		pose	poses of current frame (npose)
+	 *	@param[in]		npose	number of poses per frame
+	 *	@param[in]		tracked	target tracked in current frame?
+	 */
+	void addPoses(Track& track, DTrack_Pose_Type_f* hist, const DTrack_Pose_Type_f* pose, int npose, bool tracked);
+
+	/**
+	 * 	\brief	Extrapolate poses of one target.
+	 *
+	 *	@param[in]	track	frames of target
+	 *	@param[in]	hist	poses of frames of target (DTRACK_PREDICT_HISTORY * npose)
+	 *	@param[in]	time	time to extrapolate to
+	 *	@param[out]	pose	extrapolated poses (npose)
+	 *	@param[in]	npose	number of poses per frame
+	 */
+	void predictPoses(const Track& track, const DTrack_Pose_Type_f* hist, double time, DTrack_Pose_Type_f* pose, int npose);
+
+	Model d_model;                                //!< motion model
+	double d_maxpred;                             //!< max time of extrapolation in s
+	double d_time;                                //!< timestamp of last frame (-1 if none)
+
+	std::vector<DTrack_Body_Pose_Type> d_body;    //!< standard bodies of last frame
+	std::vector<Track> d_body_track;              //!< frames of standard bodies
+	std::vector<DTrack_Pose_Type_f> d_body_hist;  //!< poses of standard bodies (DTRACK_PREDICT_HISTORY per body)
+	std::vector<DTrack_Hand_Pose_Type> d_hand;    //!< hands of last frame
+	std::vector<Track> d_hand_track;              //!< frames of hands
+	std::vector<DTrack_Pose_Type_f> d_hand_hist;  //!< poses of hands and fingers (DTRACK_PREDICT_HISTORY * (1 + DTRACK_HAND_MAX_FINGER) per hand)
+};
+
+
+#endif /* _ART_DTRACKPREDICTOR_HPP_ */
@@ -35,18 +35,30 @@
 
 #include <iostream>
 #include <sstream>
+#include <math.h>
 
 using namespace DTrackSDK_Net;
 using namespace DTrackSDK_Parse;
+using namespace DTrackSDK_Thread;
+using namespace DTrackSDK_Shm;
+using namespace DTrackSDK_Pose;
+
+#define FRAME_NEW            0x04    // triple buffer: flag for a frame not yet taken by latestFrame()
+#define THREAD_TIMEOUT_US  100000    // receiver thread: maximum time to wait for data before checking for stop
+#define SHM_FRAME_ALIGN        64    // frames in shared memory: alignment of header and record arrays (cache line)
+
+// frames in shared memory: default max number of records (standard body, Flystick, measurement tool, measurement reference, hand, human model, marker)
+static const DTrack_Shm_Layout_Type SHM_DEFAULT_LAYOUT = { 32, 8, 8, 8, 4, 4, 256 };
 
 
 /**
  * 	\brief	Constructor. Use for listening mode.
  *
  *	@param[in]	data_port		port number to receive tracking data from DTrack
+ *	@param[in]	sockopt			options for the UDP socket (see getSocketOptions()); default is OS defaults
  */
-DTrackSDK::DTrackSDK(unsigned short data_port) {
-	init("", 0, data_port, SYS_DTRACK_UNKNOWN);
+DTrackSDK::DTrackSDK(unsigned short data_port, const DTrack_Socket_Options_Type* sockopt) {
+	init("", 0, data_port, SYS_DTRACK_UNKNOWN, 32768, 1000000, 10000000, sockopt);
 }
 
 
@@ -66,14 +78,31 @@ DTrackSDK::DTrackSDK(const std::string server_host, unsigned short data_port)
  * 	\brief	Constructor. Use for DTrack.
  *
  * 	This constructor can also be used for DTrack2. In this case server_port must be 50105.
+ *	With a multicast IP address as server_host and server_port 0 it listens to multicast.
  *
  *	@param[in]	server_host		hostname or IP address of ARTtrack Controller (empty string if not used)
  *	@param[in]	server_port		port number of DTrack
  *	@param[in]	data_port		port number to receive tracking data from DTrack
+ *	@param[in]	sockopt			options for the UDP socket (see getSocketOptions()); default is OS defaults
+ */
+DTrackSDK::DTrackSDK(const std::string server_host, unsigned short server_port, unsigned short data_port,
+	const DTrack_Socket_Options_Type* sockopt)
+{
+	init(server_host, server_port, data_port, SYS_DTRACK_UNKNOWN, 32768, 1000000, 10000000, sockopt);
+}
+
+
+/**
+ * 	\brief	Constructor. Use for receiving tracking data from the local fan-out of another instance.
+ *
+ *	Tracking data is taken from shared memory instead of a UDP socket (see enableFanout()).
+ *	Fails if the fan-out doesn't exist (see isLocalDataPortValid()).
+ *
+ *	@param[in]	fanout_name		name of local fan-out
  */
-DTrackSDK::DTrackSDK(const std::string server_host, unsigned short server_port, unsigned short data_port)
+DTrackSDK::DTrackSDK(const std::string fanout_name)
 {
-	init(server_host, server_port, data_port, SYS_DTRACK_UNKNOWN);
+	init("", 0, 0, SYS_DTRACK_UNKNOWN, 32768, 1000000, 10000000, NULL, fanout_name);
 }
 
 
@@ -87,11 +116,13 @@ DTrackSDK::DTrackSDK(const std::string server_host, unsigned short server_port,
  *	@param[in]	data_bufsize	size of buffer for UDP packets in bytes; default is 32kb (32768 bytes)
  *	@param[in]	data_timeout_us	timeout for receiving tracking data in us; default is 1s (1,000,000 us)
  *	@param[in]	srv_timeout_us	timeout for reply of ARTtrack Controller in us; default is 10s (10,000,000 us)
+ *	@param[in]	sockopt			options for the UDP socket (see getSocketOptions()); default is OS defaults
  */
 DTrackSDK::DTrackSDK(const std::string server_host,	unsigned short server_port,	unsigned short data_port,
-	RemoteSystemType remote_type, int data_bufsize,	int data_timeout_us, int srv_timeout_us)
+	RemoteSystemType remote_type, int data_bufsize,	int data_timeout_us, int srv_timeout_us,
+	const DTrack_Socket_Options_Type* sockopt)
 {
-	init(server_host, server_port, data_port, remote_type, data_bufsize, data_timeout_us, srv_timeout_us);
+	init(server_host, server_port, data_port, remote_type, data_bufsize, data_timeout_us, srv_timeout_us, sockopt);
 }
 
 
@@ -105,16 +136,56 @@ DTrackSDK::DTrackSDK(const std::string server_host,	unsigned short server_port,
  *	@param[in]	data_bufsize	size of buffer for UDP packets in bytes; default is 32kb (32768 bytes)
  *	@param[in]	data_timeout_us	timeout for receiving tracking data in us; default is 1s (1,000,000 us)
  *	@param[in]	srv_timeout_us	timeout for reply of ARTtrack Controller in us; default is 10s (10,000,000 us)
+ *	@param[in]	sockopt			options for the UDP socket, NULL for OS defaults
+ *	@param[in]	fanout_name		name of local fan-out to receive tracking data from instead of UDP socket (empty string if not used)
  */
 void DTrackSDK::init(const std::string server_host,	unsigned short server_port,	unsigned short data_port,
-	RemoteSystemType remote_type, int data_bufsize,	int data_timeout_us, int srv_timeout_us)
+	RemoteSystemType remote_type, int data_bufsize,	int data_timeout_us, int srv_timeout_us,
+	const DTrack_Socket_Options_Type* sockopt, const std::string fanout_name)
 {
 	rsType = remote_type;
-	int err;
+	int err = 0;
 
 	d_udpsock = NULL;
 	d_tcpsock = NULL;
+	d_cmd_id = 0;
+	d_cmd_skip = false;
+	d_param_cache_on = false;
 	d_udpbuf = NULL;
+	d_thread = NULL;
+	d_thread_external = false;
+	d_thread_run = 0;
+	d_udphead = d_udpcount = 0;
+	d_drain = DRAIN_LATEST;
+	d_drain_queue = 1;
+	d_last_framecounter = 0;
+	memset(d_stat_seen, 0, sizeof(d_stat_seen));
+	d_stat_on = true;
+	d_fanout = NULL;
+	d_fanin = NULL;
+	d_shmframes = NULL;
+	resetStatistics();
+
+	// reset actual DTrack data:
+	act_framecounter = 0;
+	act_timestamp = -1;
+	act_rxtimestamp = act_latency = -1;
+
+	act_num_body = act_num_flystick = act_num_meatool = act_num_mearef = act_num_hand = act_num_human = 0;
+	act_num_marker = 0;
+	d_records = RECORD_ALL;
+	d_lazy = false;
+	d_float = false;
+	d_poses = false;
+	d_body_gen = d_hand_gen = d_human_gen = 1;
+	d_lazy_flystick2 = false;
+	d_lazy_marker = NULL;
+
+	d_message_origin = "";
+	d_message_status = "";
+	d_message_framenr = 0;
+	d_message_errorid = 0;
+	d_message_msg = "";
 
 	lastDataError = ERR_NONE;
 	lastServerError = ERR_NONE;
@@ -134,28 +205,50 @@ void DTrackSDK::init(const std::string server_host,	unsigned short server_port,
 
 	// create UDP socket:
 	d_udpport = data_port;
+	memset(&d_sockopt, 0, sizeof(d_sockopt));
+	if (sockopt != NULL) {
+		d_sockopt = *sockopt;
+	}
 
-	if ((d_remote_ip != 0) && (server_port == 0)) { // listen to multicast case
-		err = udp_init(&d_udpsock, &d_udpport, d_remote_ip);
+	if (!fanout_name.empty()) { // local fan-out case: no UDP socket
+		d_udpport = 0;
+		memset(&d_sockopt, 0, sizeof(d_sockopt));
+		if (shm_packet_open(&d_fanin, fanout_name.c_str())) {
+			d_fanin = NULL;
+			return;
+		}
+		d_fanin_name = fanout_name;
+	} else if ((d_remote_ip != 0) && (server_port == 0)) { // listen to multicast case
+		err = udp_init(&d_udpsock, &d_udpport, d_remote_ip, &d_sockopt);
 	} else { // normal case
-		err = udp_init(&d_udpsock, &d_udpport);
+		d_sockopt.multicast_if = 0;
+		err = udp_init(&d_udpsock, &d_udpport, 0, &d_sockopt);
 	}
 	if (err) {
 		d_udpsock = NULL;
 		d_udpport = 0;
+		memset(&d_sockopt, 0, sizeof(d_sockopt));
 		return;
 	}
 
 	// create UDP buffer:
 	d_udpbufsize = data_bufsize;
-	d_udpbuf = (char *)malloc(data_bufsize);
+	d_udpbuf = (char *)malloc(data_bufsize * DTRACK_UDP_SLOTS);
 	if (!d_udpbuf) {
 		udp_exit(d_udpsock);
 		d_udpsock = NULL;
 		d_udpport = 0;
+		shm_packet_close(d_fanin);
+		d_fanin = NULL;
+		d_fanin_name = "";
 		return;
 	}
 
+	// receive through io_uring, if requested and available:
+	if (d_sockopt.io_uring) {
+		d_sockopt.io_uring = (udp_uring_init(d_udpsock, DTRACK_URING_BUFS, d_udpbufsize) == 0);
+	}
+
 	if (d_remote_ip) {
 		if (server_port == 0) { // multicast
 			d_remoteport = 0;
@@ -176,18 +269,6 @@ void DTrackSDK::init(const std::string server_host,	unsigned short server_port,
 			}
 		}
 	}
-	// reset actual DTrack data:
-	act_framecounter = 0;
-	act_timestamp = -1;
-
-	act_num_body = act_num_flystick = act_num_meatool = act_num_mearef = act_num_hand = act_num_human = 0;
-	act_num_marker = 0;
-
-	d_message_origin = "";
-	d_message_status = "";
-	d_message_framenr = 0;
-	d_message_errorid = 0;
-	d_message_msg = "";
 }
 
 
@@ -196,12 +277,17 @@ void DTrackSDK::init(const std::string server_host,	unsigned short server_port,
  */
 DTrackSDK::~DTrackSDK()
 {
-	// release buffer
+	stopReceiverThread();
+
+	// release buffer & local fan-out
 	free(d_udpbuf);
+	shm_packet_close(d_fanout);
+	shm_packet_close(d_fanin);
+	shm_frame_close(d_shmframes);
 
 	// release sockets & net
 	if ((d_remote_ip != 0) && (d_remoteport == 0)) {
-		udp_exit(d_udpsock, d_remote_ip);
+		udp_exit(d_udpsock, d_remote_ip, d_sockopt.multicast_if);
 	} else {
 		udp_exit(d_udpsock);
 	}
@@ -238,6 +324,315 @@ bool DTrackSDK::setControllerTimeoutUS(int timeout) {
 }
 
 
+/**
+ * 	\brief	Set record types processed by receive().
+ *
+ * 	@param[in]	records		record types (combination of RecordTypes); default is RECORD_ALL
+ */
+void DTrackSDK::setParsedRecords(int records)
+{
+	d_records = records & RECORD_ALL;
+	clearLazyRecords();
+
+	// reset data of skipped record types
+	if (!(d_records & RECORD_BODY)) {
+		act_num_body = 0;
+		act_body.clear();
+		act_body_f.clear();
+		act_body_pose.clear();
+		act_body_gen.clear();
+	}
+	if (!(d_records & RECORD_FLYSTICK)) {
+		act_num_flystick = 0;
+		act_flystick.clear();
+		act_flystick_f.clear();
+	}
+	if (!(d_records & RECORD_MEATOOL)) {
+		act_num_meatool = 0;
+		act_meatool.clear();
+		act_meatool_f.clear();
+	}
+	if (!(d_records & RECORD_MEAREF)) {
+		act_num_mearef = 0;
+		act_mearef.clear();
+		act_mearef_f.clear();
+	}
+	if (!(d_records & RECORD_HAND)) {
+		act_num_hand = 0;
+		act_hand.clear();
+		act_hand_f.clear();
+		act_hand_pose.clear();
+		act_hand_gen.clear();
+	}
+	if (!(d_records & RECORD_HUMAN)) {
+		act_num_human = 0;
+		act_human.clear();
+		act_human_f.clear();
+		act_human_pose.clear();
+		act_human_gen.clear();
+	}
+	if (!(d_records & RECORD_MARKER)) {
+		act_num_marker = 0;
+		act_marker.clear();
+		act_marker_f.clear();
+	}
+}
+
+
+/**
+ * 	\brief	Get record types processed by receive().
+ *
+ * 	@return		record types (combination of RecordTypes)
+ */
+int DTrackSDK::getParsedRecords()
+{
+	return d_records;
+}
+
+
+/**
+ * 	\brief	Set lazy processing of tracking data.
+ *
+ * 	@param[in]	lazy	process records on first access instead of in receive()?
+ */
+void DTrackSDK::setLazyParsing(bool lazy)
+{
+	if (!lazy) {
+		updateRecords();
+		if (d_poses) {  // not filled by receive() in lazy mode
+			convertPoses();
+		}
+	}
+	d_lazy = lazy;
+}
+
+
+/**
+ * 	\brief	Get lazy processing of tracking data.
+ *
+ * 	@return		records processed on first access?
+ */
+bool DTrackSDK::isLazyParsing()
+{
+	return d_lazy;
+}
+
+
+/**
+ * 	\brief	Set handling of queued tracking data packets.
+ *
+ *	DRAIN_LATEST suits applications that only need the current pose: each receive() processes the
+ *	newest packet, older ones are dropped. DRAIN_ALL processes one packet per receive() in order of
+ *	arrival without dropping any (packets may still get lost in the network or, if receive() is
+ *	called too rarely, in the socket buffer). DRAIN_QUEUE works like DRAIN_ALL, but keeps only the
+ *	newest maxqueue packets, so the lag is limited. Default is DRAIN_LATEST.
+ *	Must not be called while the receiver thread is running.
+ * 	@param[in]	policy		handling of queued packets
+ * 	@param[in]	maxqueue	DRAIN_QUEUE: max number of queued packets, range 1 .. DTRACK_UDP_SLOTS - 1
+ * 	@return		Success? (i.e. valid maxqueue)
+ */
+bool DTrackSDK::setDrainPolicy(DrainPolicy policy, int maxqueue)
+{
+	// one slot is needed to look for newer packets:
+	if ((policy == DRAIN_QUEUE) && ((maxqueue < 1) || (maxqueue >= DTRACK_UDP_SLOTS))) {
+		return false;
+	}
+	d_drain = policy;
+	d_drain_queue = (policy == DRAIN_QUEUE) ? maxqueue : 1;
+	return true;
+}
+
+
+/**
+ * 	\brief	Get handling of queued tracking data packets.
+ *
+ * 	@return		handling of queued packets
+ */
+DTrackSDK::DrainPolicy DTrackSDK::getDrainPolicy()
+{
+	return d_drain;
+}
+
+
+/**
+ * 	\brief	Get number of dropped frames.
+ *
+ *	Counts packets received, but dropped according to the drain policy (see setDrainPolicy()).
+ * 	@return		number of dropped frames since start or resetFrameCounters()
+ */
+unsigned int DTrackSDK::getDroppedFrames()
+{
+	return d_stat.dropped;
+}
+
+
+/**
+ * 	\brief	Get number of skipped frames.
+ *
+ *	Counts frames missing between two successive frames processed by receive() (gaps in the frame
+ *	counter). Includes dropped frames (see getDroppedFrames()) as well as frames lost in the network
+ *	or by the tracking system.
+ * 	@return		number of skipped frames since start or resetFrameCounters()
+ */
+unsigned int DTrackSDK::getSkippedFrames()
+{
+	return d_stat.skipped;
+}
+
+
+/**
+ * 	\brief	Reset numbers of dropped and skipped frames.
+ */
+void DTrackSDK::resetFrameCounters()
+{
+	d_stat.dropped = d_stat.skipped = 0;
+}
+
+
+/**
+ * 	\brief	Get statistics of received tracking data.
+ *
+ *	Covers all frames since start or resetStatistics(): errors, gaps and order of the frame counter,
+ *	intervals between arrival of packets (using receive timestamps, see getReceiveTimeStamp()) and time
+ *	for processing each record type. In lazy mode (see setLazyParsing()) only the processing in receive()
+ *	is measured. While the receiver thread is running, use the statistics of latestFrame() instead.
+ * 	@param[out]	stats	statistics
+ * 	@return		Success? (i.e. receiver thread not running)
+ */
+bool DTrackSDK::getStatistics(DTrack_Statistics_Type& stats)
+{
+	if ((d_thread != NULL) || d_thread_external)  // statistics are updated by receiver thread
+		return false;
+
+	fillStatistics(stats);
+	return true;
+}
+
+
+/**
+ * 	\brief	Reset statistics of received tracking data (including numbers of dropped and skipped frames).
+ *
+ *	Must not be called while the receiver thread is running.
+ */
+void DTrackSDK::resetStatistics()
+{
+	memset(&d_stat, 0, sizeof(d_stat));
+	d_stat.interval_min = d_stat.interval_max = -1;
+	d_stat_interval_sum = 0;
+	d_stat_last_rxtime = -1;
+	memset(d_stat_hist, 0, sizeof(d_stat_hist));
+}
+
+
+/**
+ * 	\brief	Set statistics of intervals between packets and of processing times.
+ *
+ *	These statistics read the clock for every packet and every line of a packet. Without them
+ *	getStatistics() only reports frames, errors, gaps and order of the frame counter.
+ *	Default is on.
+ * 	@param[in]	on		measure intervals and processing times?
+ */
+void DTrackSDK::setStatistics(bool on)
+{
+	d_stat_on = on;
+	d_stat_last_rxtime = -1;  // no interval across the time switched off
+}
+
+
+/**
+ * 	\brief	Get statistics of intervals between packets and of processing times.
+ *
+ * 	@return		intervals and processing times measured?
+ */
+bool DTrackSDK::isStatistics()
+{
+	return d_stat_on;
+}
+
+
+/**
+ * 	\brief	Release records of one type, including their memory.
+ *
+ *	@param[in,out]	rec		records
+ */
+template<class T>
+static void release_records(std::vector<T>& rec)
+{
+	std::vector<T>().swap(rec);
+}
+
+
+/**
+ * 	\brief	Set float mode.
+ *
+ * 	@param[in]	on		process tracking data as float instead of double?
+ */
+void DTrackSDK::setFloatMode(bool on)
+{
+	if (on == d_float)
+		return;
+	// keep current data available in new precision
+	updateRecords();
+	convertRecords();
+	d_float = on;
+
+	// data of old precision is converted on demand from now on
+	if (d_float) {
+		release_records(act_body);
+		release_records(act_flystick);
+		release_records(act_meatool);
+		release_records(act_mearef);
+		release_records(act_hand);
+		release_records(act_human);
+		release_records(act_marker);
+	} else {
+		release_records(act_body_f);
+		release_records(act_flystick_f);
+		release_records(act_meatool_f);
+		release_records(act_mearef_f);
+		release_records(act_hand_f);
+		release_records(act_human_f);
+		release_records(act_marker_f);
+	}
+}
+
+
+/**
+ * 	\brief	Get float mode.
+ *
+ * 	@return		tracking data processed as float?
+ */
+bool DTrackSDK::isFloatMode()
+{
+	return d_float;
+}
+
+
+/**
+ * 	\brief	Set compact poses.
+ *
+ * 	@param[in]	on		fill compact poses in receive()?
+ */
+void DTrackSDK::setCompactPoses(bool on)
+{
+	if (on && !d_poses && !d_lazy) {  // keep current data available
+		convertPoses();
+	}
+	d_poses = on;
+}
+
+
+/**
+ * 	\brief	Get compact poses.
+ *
+ * 	@return		compact poses filled in receive()?
+ */
+bool DTrackSDK::isCompactPoses()
+{
+	return d_poses;
+}
+
+
 /**
  * 	\brief	Get current remote system type (e.g. DTrack, DTrack2).
  *
@@ -315,7 +710,7 @@ std::string DTrackSDK::getLastDTrackErrorDescription()
  */
 bool DTrackSDK::isLocalDataPortValid()
 {
-	return (d_udpsock != NULL);
+	return (d_udpsock != NULL) || !d_fanin_name.empty();
 }
 
 
@@ -339,12 +734,113 @@ bool DTrackSDK::isCommandInterfaceValid()
  */
 bool DTrackSDK::receive()
 {
+	if ((d_thread != NULL) || d_thread_external)  // data is received by receiver thread
+		return false;
+
+	if (!receiveData(d_udptimeout_us)) {
+		statError();
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ *	\brief	Start new generation of records.
+ *
+ *	@param[in,out]	gen		generation counter (0 is never used, marks records never written)
+ */
+static void next_generation(unsigned int& gen)
+{
+	if (++gen == 0) {
+		gen = 1;
+	}
+}
+
+
+/**
+ *	\brief	Store begin of a record for later processing.
+ *
+ *	@param[in,out]	lazy	pending records of one type
+ *	@param[in]		i		index of record
+ *	@param[in]		s		begin of record
+ */
+static void lazy_store(std::vector<char*>& lazy, int i, char* s)
+{
+	if (i >= (int )lazy.size()) {
+		lazy.resize(i + 1, NULL);
+	}
+	lazy[i] = s;
+}
+
+
+/**
+ *	\brief	Resize records of one type, only of the precision in use (see setFloatMode()).
+ *
+ *	@param[in,out]	rec		records as double
+ *	@param[in,out]	rec_f	records as float
+ *	@param[in]		flt		float precision in use?
+ *	@param[in]		n		new number of records
+ */
+template<class D, class F>
+static void resize_records(std::vector<D>& rec, std::vector<F>& rec_f, bool flt, int n)
+{
+	if (flt) {
+		rec_f.resize(n);
+	} else {
+		rec.resize(n);
+	}
+}
+
+
+/**
+ *	\brief	Get index of record type of a line (see DTrack_Statistics_Type).
+ *
+ *	@param[in]	s	begin of line
+ *	@return	index, -1 if not a record line
+ */
+static int stat_record_index(const char* s)
+{
+	if ((s[0] == '6') && (s[1] == 'd')) {
+		switch (s[2]) {
+			case ' ':
+			case 'c':
+				return 0;  // '6d', '6dcal'
+			case 'f':
+				return 1;  // '6df', '6df2'
+			case 'm':
+				return (s[4] == 'r') ? 3 : 2;  // '6dmtr', '6dmt'
+			case 'j':
+				return 5;  // '6dj'
+		}
+		return -1;
+	}
+	if ((s[0] == 'g') && (s[1] == 'l')) {
+		return 4;  // 'gl', 'glcal'
+	}
+	if ((s[0] == '3') && (s[1] == 'd')) {
+		return 6;  // '3d'
+	}
+	return -1;
+}
+
+
+/**
+ *	\brief	Receive and process one tracking data packet.
+ *
+ *	@param[in]	tout_us		timeout for receiving tracking data in us
+ *	@return	receive succeeded?
+ */
+bool DTrackSDK::receiveData(int tout_us)
+{
+	char* packet;
 	char* s;
-	int i, j, k, l, n, len, id;
-	char sfmt[20];
-	int iarr[5];
-	double d, darr[6];
+	int i, n, len, id, line, nline;
+	int iarr[3];
+	double d;
 	int loc_num_bodycal, loc_num_handcal, loc_num_flystick1, loc_num_meatool;
+	int rtype;
+	double t0, t;
 
 	lastDataError = ERR_NONE;
 	lastServerError = ERR_NONE;
@@ -356,28 +852,53 @@ bool DTrackSDK::receive()
 	// defaults:
 	act_framecounter = 0;
 	act_timestamp = -1;   // i.e. not available
+	act_rxtimestamp = act_latency = -1;
 	loc_num_bodycal = loc_num_handcal = -1;  // i.e. not available
 	loc_num_flystick1 = loc_num_meatool = 0;
 
-	// receive UDP packet:
-	len = udp_receive(d_udpsock, d_udpbuf, d_udpbufsize-1, d_udptimeout_us);
-	if (len == -1) {
+	// receive UDP packets (all queued packets at once):
+	n = fetchPacket(tout_us);
+	if (n == -1) {
 		lastDataError = ERR_TIMEOUT;
 		return false;
 	}
 
+	if (n < 0) {
+		lastDataError = ERR_NET;
+		return false;
+	}
+
+	// records of last frame are lost now:
+	clearLazyRecords();
+
+	// process chosen packet:
+	packet = d_udpbuf + n * d_udpbufsize;
+	len = d_udplen[n];
 	if (len <= 0) {
 		lastDataError = ERR_NET;
 		return false;
 	}
+	act_rxtimestamp = d_udprxtime[n];
 
-	s = d_udpbuf;
-	s[len] = '\0';
+	packet[len] = '\0';
 
 	// process lines:
 	lastDataError = ERR_PARSE;
 
-	do {
+	nline = string_index_lines(packet, len, d_linestart);
+	rtype = -1;
+	t0 = d_stat_on ? net_clock() : 0;
+	for (line = 0; line < nline; line++) {
+		s = packet + d_linestart[line];
+		if (d_stat_on) {  // statistics: processing time of previous line
+			t = net_clock();
+			if (rtype >= 0) {
+				d_stat.parse_count[rtype]++;
+				d_stat.parse_time[rtype] += t - t0;
+			}
+			t0 = t;
+			rtype = stat_record_index(s);
+		}
 		// line for frame counter:
 		if (!strncmp(s, "fr ", 3)) {
 			s += 3;
@@ -398,6 +919,9 @@ bool DTrackSDK::receive()
 		}
 		// line for additional information about number of calibrated bodies:
 		if (!strncmp(s, "6dcal ", 6)) {
+			if (!(d_records & RECORD_BODY)) {
+				continue;  // record type not wanted
+			}
 			s += 6;
 			if (!(s = string_get_i(s, &loc_num_bodycal))) {
 				return false;
@@ -406,38 +930,29 @@ bool DTrackSDK::receive()
 		}
 		// line for standard body data:
 		if (!strncmp(s, "6d ", 3)) {
-			s += 3;
-			// disable all existing dataargc != 2
-			for (i=0; i<act_num_body; i++) {
-				memset(&act_body[i], 0, sizeof(DTrack_Body_Type));
-				act_body[i].id = i;
-				act_body[i].quality = -1;
+			if (!(d_records & RECORD_BODY)) {
+				continue;  // record type not wanted
 			}
+			s += 3;
+			// new generation: all existing data becomes 'not tracked'
+			next_generation(d_body_gen);
 			// get number of standard bodies (in line)
 			if (!(s = string_get_i(s, &n))) {
 				return false;
 			}
 			// get data of standard bodies
 			for (i=0; i<n; i++) {
-				if (!(s = string_get_block(s, "id", &id, NULL, &d))) {
-					return false;
-				}
-				// adjust length of vector
-				if (id >= act_num_body) {
-					act_body.resize(id + 1);
-					for (j = act_num_body; j<=id; j++) {
-						memset(&act_body[j], 0, sizeof(DTrack_Body_Type));
-						act_body[j].id = j;
-						act_body[j].quality = -1;
+				if (d_lazy) {  // store begin of record, process later
+					if (!string_get_block(s, &id, &d) || (id < 0)) {
+						return false;
 					}
-					act_num_body = id + 1;
-				}
-				act_body[id].id = id;
-				act_body[id].quality = d;
-				if (!(s = string_get_block(s, "ddd", NULL, NULL, act_body[id].loc))) {
-					return false;
+					resizeBody(id);
+					lazy_store(d_lazy_body, id, s);
+					s = string_skip_blocks(s, 3);
+				} else {
+					s = d_float ? parseBody(s, act_body_f) : parseBody(s, act_body);
 				}
-				if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_body[id].rot))) {
+				if (!s) {
 					return false;
 				}
 			}
@@ -452,47 +967,24 @@ bool DTrackSDK::receive()
 				return false;
 			}
 			loc_num_flystick1 = n;
+			if (!(d_records & RECORD_FLYSTICK)) {
+				continue;  // record type not wanted (number of Flysticks still needed for '6dcal')
+			}
 			// adjust length of vector
 			if (n != act_num_flystick) {
-				act_flystick.resize(n);
+				resize_records(act_flystick, act_flystick_f, d_float, n);
 				act_num_flystick = n;
 			}
 			// get data of Flysticks
+			d_lazy_flystick2 = false;
 			for (i=0; i<n; i++) {
-				if (!(s = string_get_block(s, "idi", iarr, NULL, &d))) {
-					return false;
+				if (d_lazy) {  // store begin of record, process later
+					lazy_store(d_lazy_flystick, i, s);
+					s = string_skip_blocks(s, 3);
+				} else {
+					s = d_float ? parseFlyStick1(s, act_flystick_f[i], i) : parseFlyStick1(s, act_flystick[i], i);
 				}
-				if (iarr[0] != i) {	// not expected
-					return false;
-				}
-				act_flystick[i].id = iarr[0];
-				act_flystick[i].quality = d;
-				act_flystick[i].num_button = 8;
-				k = iarr[1];
-				for (j=0; j<8; j++) {
-					act_flystick[i].button[j] = k & 0x01;
-					k >>= 1;
-				}
-				act_flystick[i].num_joystick = 2;  // additionally to buttons 5-8
-				if (iarr[1] & 0x20) {
-					act_flystick[i].joystick[0] = -1;
-				} else
-				if (iarr[1] & 0x80) {
-					act_flystick[i].joystick[0] = 1;
-				} else {
-					act_flystick[i].joystick[0] = 0;
-				}
-				if(iarr[1] & 0x10){
-					act_flystick[i].joystick[1] = -1;
-				}else if(iarr[1] & 0x40){
-					act_flystick[i].joystick[1] = 1;
-				}else{
-					act_flystick[i].joystick[1] = 0;
-				}
-				if (!(s = string_get_block(s, "ddd", NULL, NULL, act_flystick[i].loc))) {
-					return false;
-				}
-				if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_flystick[i].rot))) {
+				if (!s) {
 					return false;
 				}
 			}
@@ -501,6 +993,9 @@ bool DTrackSDK::receive()
 
 		// line for Flystick data (newer format):
 		if (!strncmp(s, "6df2 ", 5)) {
+			if (!(d_records & RECORD_FLYSTICK)) {
+				continue;  // record type not wanted
+			}
 			s += 5;
 			// get number of calibrated Flysticks
 			if (!(s = string_get_i(s, &n))) {
@@ -508,58 +1003,28 @@ bool DTrackSDK::receive()
 			}
 			// adjust length of vector
 			if (n != act_num_flystick) {
-				act_flystick.resize(n);
+				resize_records(act_flystick, act_flystick_f, d_float, n);
 				act_num_flystick = n;
 			}
 			// get number of Flysticks
 			if (!(s = string_get_i(s, &n))) {
 				return false;
 			}
+			if (n > act_num_flystick) {  // not expected
+				return false;
+			}
 			// get data of Flysticks
+			d_lazy_flystick2 = true;
 			for (i=0; i<n; i++) {
-				if (!(s = string_get_block(s, "idii", iarr, NULL, &d))) {
-					return false;
-				}
-				if (iarr[0] != i) {  // not expected
-					return false;
-				}
-				act_flystick[i].id = iarr[0];
-				act_flystick[i].quality = d;
-				if ((iarr[1] > DTRACK_FLYSTICK_MAX_BUTTON)||(iarr[1] > DTRACK_FLYSTICK_MAX_JOYSTICK)) {
-					return false;
-				}
-				act_flystick[i].num_button = iarr[1];
-				act_flystick[i].num_joystick = iarr[2];
-				if (!(s = string_get_block(s, "ddd", NULL, NULL, act_flystick[i].loc))){
-					return false;
-				}
-				if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_flystick[i].rot))){
-					return false;
-				}
-				strcpy(sfmt, "");
-				j = 0;
-				while (j < act_flystick[i].num_button) {
-					strcat(sfmt, "i");
-					j += 32;
-				}
-				j = 0;
-				while (j < act_flystick[i].num_joystick) {
-					strcat(sfmt, "d");
-					j++;
+				if (d_lazy) {  // store begin of record, process later
+					lazy_store(d_lazy_flystick, i, s);
+					s = string_skip_blocks(s, 4);
+				} else {
+					s = d_float ? parseFlyStick2(s, act_flystick_f[i], i) : parseFlyStick2(s, act_flystick[i], i);
 				}
-				if (!(s = string_get_block(s, sfmt, iarr, NULL, act_flystick[i].joystick))) {
+				if (!s) {
 					return false;
 				}
-				k = l = 0;
-				for (j=0; j<act_flystick[i].num_button; j++) {
-					act_flystick[i].button[j] = iarr[k] & 0x01;
-					iarr[k] >>= 1;
-					l++;
-					if (l == 32) {
-						k++;
-						l = 0;
-					}
-				}
 			}
 			continue;
 		}
@@ -572,27 +1037,23 @@ bool DTrackSDK::receive()
 				return false;
 			}
 			loc_num_meatool = n;
+			if (!(d_records & RECORD_MEATOOL)) {
+				continue;  // record type not wanted (number of measurement tools still needed for '6dcal')
+			}
 			// adjust length of vector
 			if (n != act_num_meatool) {
-				act_meatool.resize(n);
+				resize_records(act_meatool, act_meatool_f, d_float, n);
 				act_num_meatool = n;
 			}
 			// get data of measurement tools
 			for (i=0; i<n; i++) {
-				if (!(s = string_get_block(s, "idi", iarr, NULL, &d))) {
-					return false;
-				}
-				if (iarr[0] != i) {  // not expected
-					return false;
-				}
-				act_meatool[i].id = iarr[0];
-				act_meatool[i].quality = d;
-				act_meatool[i].num_button = 1;
-				act_meatool[i].button[0] = iarr[1] & 0x01;
-				if (!(s = string_get_block(s, "ddd", NULL, NULL, act_meatool[i].loc))) {
-					return false;
+				if (d_lazy) {  // store begin of record, process later
+					lazy_store(d_lazy_meatool, i, s);
+					s = string_skip_blocks(s, 3);
+				} else {
+					s = d_float ? parseMeaTool(s, act_meatool_f[i], i) : parseMeaTool(s, act_meatool[i], i);
 				}
-				if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_meatool[i].rot))) {
+				if (!s) {
 					return false;
 				}
 			}
@@ -601,6 +1062,9 @@ bool DTrackSDK::receive()
 
 		// line for measurement reference data:
 		if (!strncmp(s, "6dmtr ", 6)) {
+			if (!(d_records & RECORD_MEAREF)) {
+				continue;  // record type not wanted
+			}
 			s += 6;
 			// get number of measurement references
 			if (!(s = string_get_i(s, &n))) {
@@ -612,21 +1076,19 @@ bool DTrackSDK::receive()
 			}
 			// adjust length of vector
 			if (n != act_num_mearef) {
-				act_mearef.resize(n);
+				resize_records(act_mearef, act_mearef_f, d_float, n);
 				act_num_mearef = n;
 			}
 
 			// get data of measurement references
 			for (i=0; i<n; i++) {
-				if (!(s = string_get_block(s, "id", &id, NULL, &d))) {
-					return false;
-				}
-				act_mearef[i].id = id;
-				act_mearef[i].quality = d;
-				if (!(s = string_get_block(s, "ddd", NULL, NULL, act_mearef[i].loc))) {
-					return false;
+				if (d_lazy) {  // store begin of record, process later
+					lazy_store(d_lazy_mearef, i, s);
+					s = string_skip_blocks(s, 3);
+				} else {
+					s = d_float ? parseMeaRef(s, act_mearef_f[i]) : parseMeaRef(s, act_mearef[i]);
 				}
-				if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_mearef[i].rot))) {
+				if (!s) {
 					return false;
 				}
 			}
@@ -635,6 +1097,9 @@ bool DTrackSDK::receive()
 
 		// line for additional information about number of calibrated Fingertracking hands:
 		if (!strncmp(s, "glcal ", 6)) {
+			if (!(d_records & RECORD_HAND)) {
+				continue;  // record type not wanted
+			}
 			s += 6;
 			if (!(s = string_get_i(s, &loc_num_handcal))) {	// get number of calibrated hands
 				return false;
@@ -643,63 +1108,34 @@ bool DTrackSDK::receive()
 
 		// line for A.R.T. Fingertracking hand data:
 		if (!strncmp(s, "gl ", 3)) {
-			s += 3;
-			// disable all existing data
-			for (i=0; i<act_num_hand; i++) {
-				memset(&act_hand[i], 0, sizeof(DTrack_Hand_Type));
-				act_hand[i].id = i;
-				act_hand[i].quality = -1;
+			if (!(d_records & RECORD_HAND)) {
+				continue;  // record type not wanted
 			}
+			s += 3;
+			// new generation: all existing data becomes 'not tracked'
+			next_generation(d_hand_gen);
 			// get number of hands (in line)
 			if (!(s = string_get_i(s, &n))) {
 				return false;
 			}
 			// get data of hands
 			for (i=0; i<n; i++) {
-				if (!(s = string_get_block(s, "idii", iarr, NULL, &d))){
-					return false;
-				}
-				id = iarr[0];
-				if (id >= act_num_hand) {  // adjust length of vector
-					act_hand.resize(id + 1);
-					for (j=act_num_hand; j<=id; j++) {
-						memset(&act_hand[j], 0, sizeof(DTrack_Hand_Type));
-						act_hand[j].id = j;
-						act_hand[j].quality = -1;
-					}
-					act_num_hand = id + 1;
-				}
-				act_hand[id].id = iarr[0];
-				act_hand[id].lr = iarr[1];
-				act_hand[id].quality = d;
-				if (iarr[2] > DTRACK_HAND_MAX_FINGER) {
-					return false;
-				}
-				act_hand[id].nfinger = iarr[2];
-				if (!(s = string_get_block(s, "ddd", NULL, NULL, act_hand[id].loc))) {
-					return false;
-
-				}
-				if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_hand[id].rot))){
-					return false;
-				}
-				// get data of fingers
-				for (j = 0; j < act_hand[id].nfinger; j++) {
-					if (!(s = string_get_block(s, "ddd", NULL, NULL, act_hand[id].finger[j].loc))) {
-						return false;
-					}
-					if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_hand[id].finger[j].rot))){
+				if (d_lazy) {  // store begin of record, process later
+					if (!string_get_block(s, &iarr[0], &d, &iarr[1], &iarr[2])) {
 						return false;
 					}
-					if (!(s = string_get_block(s, "dddddd", NULL, NULL, darr))){
+					id = iarr[0];
+					if ((id < 0) || (iarr[2] < 0) || (iarr[2] > DTRACK_HAND_MAX_FINGER)) {
 						return false;
 					}
-					act_hand[id].finger[j].radiustip = darr[0];
-					act_hand[id].finger[j].lengthphalanx[0] = darr[1];
-					act_hand[id].finger[j].anglephalanx[0] = darr[2];
-					act_hand[id].finger[j].lengthphalanx[1] = darr[3];
-					act_hand[id].finger[j].anglephalanx[1] = darr[4];
-					act_hand[id].finger[j].lengthphalanx[2] = darr[5];
+					resizeHand(id);
+					lazy_store(d_lazy_hand, id, s);
+					s = string_skip_blocks(s, 3 + 3 * iarr[2]);
+				} else {
+					s = d_float ? parseHand(s, act_hand_f) : parseHand(s, act_hand);
+				}
+				if (!s) {
+					return false;
 				}
 			}
 			continue;
@@ -707,6 +1143,9 @@ bool DTrackSDK::receive()
 
 		// line for 6dj human model data
 		if (!strncmp(s, "6dj ", 4)) {
+			if (!(d_records & RECORD_HUMAN)) {
+				continue;  // record type not wanted
+			}
 			s += 4;
 
 			// get number of calibrated human models
@@ -715,47 +1154,33 @@ bool DTrackSDK::receive()
 			}
 			// adjust length of vector
 			if(n != act_num_human){
-				act_human.resize(n);
+				resize_records(act_human, act_human_f, d_float, n);
+				act_human_pose.resize(n);
+				act_human_gen.resize(n, 0);
 				act_num_human = n;
 			}
-			for(i=0; i<act_num_human; i++){
-				memset(&act_human[i], 0, sizeof(DTrack_Human_Type));
-				act_human[i].id = i;
-				act_human[i].num_joints = 0;
-			}
+			// new generation: all existing data becomes 'not tracked'
+			next_generation(d_human_gen);
 			
 			// get number of human models
 			if (!(s = string_get_i(s, &n))) { 
 				return false;
 			}
-			int id_human;
 			for (i=0; i<n; i++) {
-				if (!(s = string_get_block(s, "ii", iarr, NULL,NULL))){
-					return false;
-				}
-				if (iarr[0] > act_num_human - 1) // not expected
-					return false;
-
-				id_human = iarr[0];
-				act_human[id_human].id = iarr[0];
-				act_human[id_human].num_joints = iarr[1];
-
-				for (j = 0; j < iarr[1]; j++){
-					if (!(s = string_get_block(s, "id", &id, NULL, &d))){
-						return false;
-					}
-					act_human[id_human].joint[j].id = id;
-					act_human[id_human].joint[j].quality = d;
-
-					if (!(s = string_get_block(s, "dddddd", NULL, NULL, darr))){
+				if (d_lazy) {  // store begin of record, process later
+					if (!string_get_block<2>(s, iarr)) {
 						return false;
 					}
-					memcpy(act_human[id_human].joint[j].loc, &darr,  3*sizeof(double));
-					memcpy(act_human[id_human].joint[j].ang, &darr[3],  3*sizeof(double));
-
-					if (!(s = string_get_block(s, "ddddddddd", NULL, NULL, act_human[id_human].joint[j].rot))){
+					if ((iarr[0] < 0) || (iarr[0] > act_num_human - 1) || (iarr[1] < 0) || (iarr[1] > DTRACK_HUMAN_MAX_JOINTS)) {
 						return false;
 					}
+					lazy_store(d_lazy_human, iarr[0], s);
+					s = string_skip_blocks(s, 1 + 3 * iarr[1]);
+				} else {
+					s = d_float ? parseHuman(s, act_human_f) : parseHuman(s, act_human);
+				}
+				if (!s) {
+					return false;
 				}
 			}
 			continue;
@@ -763,40 +1188,43 @@ bool DTrackSDK::receive()
 
 		// line for single marker data:
 		if (!strncmp(s, "3d ", 3)) {
+			if (!(d_records & RECORD_MARKER)) {
+				continue;  // record type not wanted
+			}
 			s += 3;
 			// get number of markers
 			if (!(s = string_get_i(s, &act_num_marker))) {
 				act_num_marker = 0;
 				return false;
 			}
-			if (act_num_marker > (int )act_marker.size()) {
-				act_marker.resize(act_num_marker);
+			if (act_num_marker > (int )(d_float ? act_marker_f.size() : act_marker.size())) {
+				resize_records(act_marker, act_marker_f, d_float, act_num_marker);
 			}
 			// get data of single markers
-			for (i=0; i<act_num_marker; i++) {
-				if (!(s = string_get_block(s, "id", &act_marker[i].id, NULL, &act_marker[i].quality))) {
-					return false;
-				}
-				if (!(s = string_get_block(s, "ddd", NULL, NULL, act_marker[i].loc))) {
+			if (d_lazy) {  // store begin of data, process later
+				d_lazy_marker = s;
+				if (!string_skip_blocks(s, 2 * act_num_marker)) {
+					act_num_marker = 0;
 					return false;
 				}
+			} else if (!(d_float ? parseMarkers(s, act_marker_f) : parseMarkers(s, act_marker))) {
+				return false;
 			}
 			continue;
 		}
 
 		// ignore unknown line identifiers (could be valid in future DTracks)
-	} while((s = string_nextline(d_udpbuf, s, d_udpbufsize)));
+	}
+	if (rtype >= 0) {  // statistics: processing time of last line
+		d_stat.parse_count[rtype]++;
+		d_stat.parse_time[rtype] += net_clock() - t0;
+	}
 
 	// set number of calibrated standard bodies, if necessary:
 	if (loc_num_bodycal >= 0) {	// '6dcal' information was available
 		n = loc_num_bodycal - loc_num_flystick1 - loc_num_meatool;
 		if (n > act_num_body) {  // adjust length of vector
-			act_body.resize(n);
-			for (j=act_num_body; j<n; j++) {
-				memset(&act_body[j], 0, sizeof(DTrack_Body_Type));
-				act_body[j].id = j;
-				act_body[j].quality = -1;
-			}
+			resizeBody(n - 1);
 		}
 		act_num_body = n;
 	}
@@ -804,240 +1232,1825 @@ bool DTrackSDK::receive()
 	// set number of calibrated Fingertracking hands, if necessary:
 	if (loc_num_handcal >= 0) {  // 'glcal' information was available
 		if (loc_num_handcal > act_num_hand) {  // adjust length of vector
-			act_hand.resize(loc_num_handcal);
-			for (j=act_num_hand; j<loc_num_handcal; j++) {
-				memset(&act_hand[j], 0, sizeof(DTrack_Hand_Type));
-				act_hand[j].id = j;
-				act_hand[j].quality = -1;
-			}
+			resizeHand(loc_num_handcal - 1);
 		}
 		act_num_hand = loc_num_handcal;
 	}
 
+	if (d_poses && !d_lazy) {
+		convertPoses();
+	}
+
+	statFrame();
+
+	act_latency = net_time() - act_rxtimestamp;
+
+	if (d_shmframes != NULL) {
+		writeSharedFrame();
+	}
+
 	lastDataError = ERR_NONE;
 	return true;
 }
 
 
 /**
- * 	\brief	Get number of calibrated standard bodies (as far as known).
+ *	\brief	Fetch queued packets into the UDP buffer and choose the next one according to the drain policy.
  *
- *	Refers to last received frame.
- *	@return		number of calibrated standard bodies
+ *	@param[in]	tout_us		timeout for receiving tracking data in us
+ *	@return	slot of packet to be processed; -1 if timeout, -2 if network error occured
  */
-int DTrackSDK::getNumBody()
+int DTrackSDK::fetchPacket(int tout_us)
 {
-	return act_num_body;
+	int slot, free_slot, num, n;
+	int maxqueue = d_drain_queue;  // DRAIN_LATEST: 1
+
+	if (d_udpcount == 0) {
+		d_udphead = 0;  // use whole buffer without wrapping
+	}
+	// receive packets; DRAIN_ALL: only if there are no queued packets left
+	if ((d_drain != DRAIN_ALL) || (d_udpcount == 0)) {
+		do {
+			if (d_udpcount == DTRACK_UDP_SLOTS) {  // buffer full: drop oldest packets
+				dropPackets((d_udpcount > maxqueue) ? d_udpcount - maxqueue : 1);
+			}
+			free_slot = (d_udphead + d_udpcount) % DTRACK_UDP_SLOTS;
+			num = DTRACK_UDP_SLOTS - free_slot;  // free slots up to end of buffer
+			if (num > DTRACK_UDP_SLOTS - d_udpcount) {
+				num = DTRACK_UDP_SLOTS - d_udpcount;
+			}
+			n = receivePackets(free_slot, num, (d_udpcount == 0) ? tout_us : 0);
+			if (n <= 0) {
+				if (d_udpcount == 0) {
+					return (n == -1) ? -1 : -2;
+				}
+				break;  // no more queued packets
+			}
+			d_udpcount += n;
+		} while ((d_drain != DRAIN_ALL) && (n == num));  // all slots filled: there might be more queued packets
+	}
+	if ((d_drain != DRAIN_ALL) && (d_udpcount > maxqueue)) {
+		dropPackets(d_udpcount - maxqueue);
+	}
+
+	slot = d_udphead;
+	d_udphead = (d_udphead + 1) % DTRACK_UDP_SLOTS;
+	d_udpcount--;
+	return slot;
 }
 
 
 /**
- * 	\brief	Get standard body data
+ *	\brief	Receive queued packets into free slots of the UDP buffer.
  *
- *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
- *	@param[in]	id	id, range 0 .. (max standard body id - 1)
- *	@return		id-th standard body data
+ *	Receives from the UDP socket or from the local fan-out of another instance. Received packets
+ *	are passed on to the local fan-out of this instance.
+ *	@param[in]	slot		first free slot
+ *	@param[in]	num			number of free slots (without wrapping)
+ *	@param[in]	tout_us		timeout for receiving tracking data in us
+ *	@return	number of received packets, <0 if error/timeout occured (see udp_receive_batch())
  */
-DTrack_Body_Type_d* DTrackSDK::getBody(int id)
+int DTrackSDK::receivePackets(int slot, int num, int tout_us)
 {
-	if ((id >= 0) && (id < act_num_body))
-		return &act_body.at(id);
-	return NULL;
+	char* buf = d_udpbuf + slot * d_udpbufsize;
+	int n, i;
+
+	if (d_fanin_name.empty()) {
+		n = udp_receive_batch(d_udpsock, buf, d_udpbufsize, num, d_udplen + slot, tout_us, d_udprxtime + slot);
+	} else {
+		n = -2;
+		if (d_fanin != NULL) {
+			n = shm_packet_receive_batch(d_fanin, buf, d_udpbufsize, num, d_udplen + slot, tout_us, d_udprxtime + slot);
+			if (n == -2) {  // fan-out disabled by its instance, or replaced after the instance terminated
+				shm_packet_close(d_fanin);
+				d_fanin = NULL;
+			}
+		}
+		if (d_fanin == NULL) {  // attach again; as long as there's no fan-out, behave like a sender without data
+			if (shm_packet_open(&d_fanin, d_fanin_name.c_str())) {
+				d_fanin = NULL;
+				thread_sleep(tout_us);
+				return -1;
+			}
+			n = shm_packet_receive_batch(d_fanin, buf, d_udpbufsize, num, d_udplen + slot, tout_us, d_udprxtime + slot);
+		}
+	}
+
+	for (i = 0; i < n; i++) {
+		if (d_stat_on) {
+			statPacket(d_udprxtime[slot + i]);
+		}
+		if ((d_fanout != NULL) && (d_udplen[slot + i] >= 0)) {
+			shm_packet_write(d_fanout, buf + i * d_udpbufsize, d_udplen[slot + i], d_udprxtime[slot + i]);
+		}
+	}
+	return n;
 }
 
 
 /**
- * 	\brief	Get number of calibrated Flysticks.
+ *	\brief	Drop oldest packets of the UDP buffer.
  *
- *	Refers to last received frame.
- *	@return		number of calibrated Flysticks
+ *	@param[in]	num		number of packets
  */
-int DTrackSDK::getNumFlyStick()
+void DTrackSDK::dropPackets(int num)
 {
-	return act_num_flystick;
+	d_udphead = (d_udphead + num) % DTRACK_UDP_SLOTS;
+	d_udpcount -= num;
+	d_stat.dropped += num;
 }
 
 
+// ---------------------------------------------------------------------------------------------------
+// Statistics:
+// ---------------------------------------------------------------------------------------------------
+
+#define STAT_REORDER_WINDOW  100  // max distance of frame counter for frames arrived out of order (otherwise restart of tracking; less than DTRACK_STAT_SEEN_SIZE)
+
 /**
- * 	\brief	Get Flystick data.
+ *	\brief	Get histogram class of an interval (4 classes per octave, starting at 1 us).
  *
- *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
- *	@param[in]	id	id, range 0 .. (max flystick id - 1)
- *	@return		id-th Flystick data.
+ *	@param[in]	dt	interval in s
+ *	@return	class
  */
-DTrack_FlyStick_Type_d* DTrackSDK::getFlyStick(int id)
+static int stat_hist_class(double dt)
 {
-	if ((id >= 0) && (id < act_num_flystick))
-		return &act_flystick.at(id);
-	return NULL;
+	int e, k;
+	double m = frexp(dt * 1e6, &e);  // 2^(e-1) <= interval in us < 2^e
+
+	k = 4 * (e - 1);
+	if (m >= 0.8409) {  // 2^(3/4) / 2
+		k += 3;
+	} else if (m >= 0.7071) {  // 2^(1/2) / 2
+		k += 2;
+	} else if (m >= 0.5946) {  // 2^(1/4) / 2
+		k += 1;
+	}
+	if (k < 0)
+		return 0;
+	if (k >= DTRACK_STAT_HIST_SIZE)
+		return DTRACK_STAT_HIST_SIZE - 1;
+	return k;
 }
 
 
 /**
- * 	\brief	Get number of calibrated measurement tools.
+ *	\brief	Update statistics with arrival of a new packet.
  *
- *	Refers to last received frame.
- *	@return		number of calibrated measurement tools
+ *	@param[in]	rxtime		receive timestamp of packet
  */
-int DTrackSDK::getNumMeaTool()
+void DTrackSDK::statPacket(double rxtime)
 {
-	return act_num_meatool;
+	double dt;
+
+	if (d_stat_last_rxtime >= 0) {
+		dt = rxtime - d_stat_last_rxtime;
+		if (dt < 0) {
+			dt = 0;
+		}
+		if ((d_stat.intervals == 0) || (dt < d_stat.interval_min)) {
+			d_stat.interval_min = dt;
+		}
+		if ((d_stat.intervals == 0) || (dt > d_stat.interval_max)) {
+			d_stat.interval_max = dt;
+		}
+		d_stat_interval_sum += dt;
+		d_stat_hist[stat_hist_class(dt)]++;
+		d_stat.intervals++;
+	}
+	d_stat_last_rxtime = rxtime;
 }
 
 
 /**
- * 	\brief	Get measurement tool data.
+ *	\brief	Get if a frame counter was received (see d_stat_seen).
  *
- *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
- *	@param[in]	id	id, range 0 .. (max tool id - 1)
- *	@return		id-th measurement tool data.
+ *	@param[in]	seen	frames received
+ *	@param[in]	fc		frame counter
+ *	@return	received?
  */
-DTrack_MeaTool_Type_d* DTrackSDK::getMeaTool(int id)
+static bool stat_seen(const unsigned int* seen, unsigned int fc)
 {
-	if ((id >= 0) && (id < act_num_meatool))
-		return &act_meatool.at(id);
-	return NULL;
+	fc %= DTRACK_STAT_SEEN_SIZE;
+	return ((seen[fc / 32] >> (fc % 32)) & 1) != 0;
 }
 
 
 /**
- * 	\brief	Get number of calibrated measurement references.
+ *	\brief	Mark a frame counter as received or missing (see d_stat_seen).
  *
- *	Refers to last received frame.
- *	@return		number of calibrated measurement references
+ *	@param[in,out]	seen	frames received
+ *	@param[in]		fc		frame counter
+ *	@param[in]		on		received?
  */
-int DTrackSDK::getNumMeaRef()
+static void stat_set_seen(unsigned int* seen, unsigned int fc, bool on)
 {
-	return act_num_mearef;
+	fc %= DTRACK_STAT_SEEN_SIZE;
+	if (on) {
+		seen[fc / 32] |= 1u << (fc % 32);
+	} else {
+		seen[fc / 32] &= ~(1u << (fc % 32));
+	}
 }
 
 
 /**
- * 	\brief	Get measurement reference data.
+ *	\brief	Update statistics with frame counter of a new frame.
  *
- *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
- *	@param[in]	id	id, range 0 .. (max measurement reference id - 1)
- *	@return		id-th measurement reference data.
+ *	A frame arriving late fills a gap counted before: the gap is closed, shortened or split in two.
  */
-DTrack_MeaRef_Type_d* DTrackSDK::getMeaRef(int id)
+void DTrackSDK::statFrame()
 {
-	if ((id >= 0) && (id < act_num_mearef))
-		return &act_mearef.at(id);
-	return NULL;
+	unsigned int fc;
+	bool before, after;
+
+	d_stat.frames++;
+
+	if ((d_last_framecounter == 0) || (act_framecounter == 0)
+			|| ((act_framecounter < d_last_framecounter) && (d_last_framecounter - act_framecounter > STAT_REORDER_WINDOW))) {
+		// no reference, or tracking restarted
+		memset(d_stat_seen, 0, sizeof(d_stat_seen));
+		stat_set_seen(d_stat_seen, act_framecounter, true);
+		d_last_framecounter = act_framecounter;
+		return;
+	}
+	if (act_framecounter > d_last_framecounter) {
+		if (act_framecounter > d_last_framecounter + 1) {  // frames missing
+			d_stat.gaps++;
+			d_stat.skipped += act_framecounter - d_last_framecounter - 1;
+			if (act_framecounter - d_last_framecounter > DTRACK_STAT_SEEN_SIZE) {
+				memset(d_stat_seen, 0, sizeof(d_stat_seen));
+			} else {
+				for (fc = d_last_framecounter + 1; fc != act_framecounter; fc++) {
+					stat_set_seen(d_stat_seen, fc, false);
+				}
+			}
+		}
+		stat_set_seen(d_stat_seen, act_framecounter, true);
+		d_last_framecounter = act_framecounter;
+	} else if (stat_seen(d_stat_seen, act_framecounter)) {  // also a late frame arrived before
+		d_stat.duplicates++;
+	} else {  // frame was counted as missing before
+		d_stat.reordered++;
+		stat_set_seen(d_stat_seen, act_framecounter, true);
+		if (d_stat.skipped > 0) {
+			d_stat.skipped--;
+		}
+		// neighbours outside of the window (or before the first frame) are taken as received:
+		before = (act_framecounter == 1) || (d_last_framecounter - (act_framecounter - 1) > STAT_REORDER_WINDOW)
+				|| stat_seen(d_stat_seen, act_framecounter - 1);
+		after = stat_seen(d_stat_seen, act_framecounter + 1);
+		if (before && after) {  // gap closed
+			if (d_stat.gaps > 0) {
+				d_stat.gaps--;
+			}
+		} else if (!before && !after) {  // gap split
+			d_stat.gaps++;
+		}
+	}
 }
 
 
 /**
- * 	\brief	Get number of calibrated Fingertracking hands (as far as known).
- *
- *	Refers to last received frame.
- *	@return		number of calibrated fingertracking hands
+ *	\brief	Update statistics with error of last receive.
  */
-int DTrackSDK::getNumHand()
+void DTrackSDK::statError()
 {
-	return act_num_hand;
+	switch (lastDataError) {
+		case ERR_TIMEOUT:
+			d_stat.err_timeout++;
+			break;
+		case ERR_NET:
+			d_stat.err_net++;
+			break;
+		case ERR_PARSE:
+			d_stat.err_parse++;
+			break;
+		default:
+			break;
+	}
 }
 
 
 /**
- * 	\brief	Get Fingertracking hand data.
+ *	\brief	Get statistics of received tracking data (without check for receiver thread).
  *
- *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
- *	@param[in]	id	id, range 0 .. (max hand id - 1)
- *	@return		id-th Fingertracking hand data
+ * 	@param[out]	stats	statistics
  */
-DTrack_Hand_Type_d* DTrackSDK::getHand(int id)
+void DTrackSDK::fillStatistics(DTrack_Statistics_Type& stats)
 {
-	if ((id >= 0) && (id < act_num_hand))
-		return &act_hand.at(id);
-	return NULL;
-}
+	unsigned int num, sum;
+	int k;
 
+	stats = d_stat;
+	stats.interval_mean = stats.interval_p99 = -1;
+	if (d_stat.intervals == 0)
+		return;
 
-/**
-* 	\brief	Get human data
-*
-*	Refers to last received frame. Currently not tracked human models get a num_joints 0
-*	@return		  id-th human model data
-*/
-int DTrackSDK::getNumHuman()
-{
-	return act_num_human;
-}
-
+	stats.interval_mean = d_stat_interval_sum / d_stat.intervals;
 
-/**
-* 	\brief	Get human data
-*
-*	Refers to last received frame. Currently not tracked human models get a num_joints 0
-*	@param[in]	id	id, range 0 .. (max standard body id - 1)
-*	@return		id-th human model data
-*/
-DTrack_Human_Type* DTrackSDK::getHuman(int id)
-{
-	if ((id >= 0) && (id < act_num_human))
-		return &act_human.at(id);
-	return NULL;
+	// upper limit of histogram class containing the 99th percentile:
+	num = d_stat.intervals - d_stat.intervals / 100;
+	sum = 0;
+	for (k = 0; k < DTRACK_STAT_HIST_SIZE - 1; k++) {
+		sum += d_stat_hist[k];
+		if (sum >= num)
+			break;
+	}
+	stats.interval_p99 = pow(2.0, (k + 1) / 4.0) * 1e-6;
+	if (stats.interval_p99 > d_stat.interval_max) {
+		stats.interval_p99 = d_stat.interval_max;
+	}
 }
 
 
 /**
- * 	\brief	Get number of tracked single markers.
+ *	\brief	Adjust length of vectors for standard bodies, if necessary.
  *
- *	Refers to last received frame.
- *	@return	number of tracked single markers
+ *	@param[in]	id	id of standard body
  */
-int DTrackSDK::getNumMarker()
+void DTrackSDK::resizeBody(int id)
 {
-	return act_num_marker;
+	if (id >= act_num_body) {  // new records are not tracked (old generation)
+		resize_records(act_body, act_body_f, d_float, id + 1);
+		act_body_pose.resize(id + 1);
+		act_body_gen.resize(id + 1, 0);
+		act_num_body = id + 1;
+	}
 }
 
 
 /**
- * 	\brief	Get single marker data.
+ *	\brief	Adjust length of vectors for Fingertracking hands, if necessary.
  *
- *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
- *	@param[in]	index	index, range 0 .. (max marker id - 1)
- *	@return		i-th single marker data
+ *	@param[in]	id	id of hand
  */
-DTrack_Marker_Type_d* DTrackSDK::getMarker(int index)
+void DTrackSDK::resizeHand(int id)
 {
-	if ((index >= 0) && (index < act_num_marker))
-		return &act_marker.at(index);
-	return NULL;
+	if (id >= act_num_hand) {  // new records are not tracked (old generation)
+		resize_records(act_hand, act_hand_f, d_float, id + 1);
+		act_hand_pose.resize(id + 1);
+		act_hand_gen.resize(id + 1, 0);
+		act_num_hand = id + 1;
+	}
 }
 
 
 /**
- * 	\brief	Get frame counter.
+ *	\brief	Process data of one standard body ('6d' line).
  *
- *	Refers to last received frame.
- *	@return		frame counter
+ *	@param[in]	s		begin of record
+ *	@param[out]	body	standard body data (double or float)
+ *	@return	pointer behind record; NULL in case of error
  */
-unsigned int DTrackSDK::getFrameCounter()
+template<class T>
+char* DTrackSDK::parseBody(char* s, std::vector<T>& body)
 {
-	return act_framecounter;
+	int id;
+	char* p;
+
+	if (!(p = string_block_begin(s)) || !string_get_i(p, &id)) {
+		return NULL;
+	}
+	if (id < 0) {  // not expected
+		return NULL;
+	}
+	resizeBody(id);
+	act_body_gen[id] = d_body_gen;
+	if (!(s = string_get_block(s, &body[id].id, &body[id].quality))) {
+		return NULL;
+	}
+	if (!(s = string_get_block<3>(s, body[id].loc))) {
+		return NULL;
+	}
+	if (!(s = string_get_block<9>(s, body[id].rot))) {
+		return NULL;
+	}
+	return s;
 }
 
 
 /**
- * 	\brief	Get timestamp.
+ *	\brief	Process data of one Flystick ('6df' line, older format).
  *
- *	Refers to last received frame.
- *	@return		timestamp (-1 if information not available)
+ *	@param[in]	s		begin of record
+ *	@param[out]	fly		Flystick data (double or float)
+ *	@param[in]	i		index of Flystick
+ *	@return	pointer behind record; NULL in case of error
  */
-double DTrackSDK::getTimeStamp()
+template<class T>
+char* DTrackSDK::parseFlyStick1(char* s, T& fly, int i)
 {
-	return act_timestamp;
+	int j, k, bt;
+
+	if (!(s = string_get_block(s, &fly.id, &fly.quality, &bt))) {
+		return NULL;
+	}
+	if (fly.id != i) {	// not expected
+		return NULL;
+	}
+	fly.num_button = 8;
+	k = bt;
+	for (j=0; j<8; j++) {
+		fly.button[j] = k & 0x01;
+		k >>= 1;
+	}
+	fly.num_joystick = 2;  // additionally to buttons 5-8
+	if (bt & 0x20) {
+		fly.joystick[0] = -1;
+	} else
+	if (bt & 0x80) {
+		fly.joystick[0] = 1;
+	} else {
+		fly.joystick[0] = 0;
+	}
+	if(bt & 0x10){
+		fly.joystick[1] = -1;
+	}else if(bt & 0x40){
+		fly.joystick[1] = 1;
+	}else{
+		fly.joystick[1] = 0;
+	}
+	if (!(s = string_get_block<3>(s, fly.loc))) {
+		return NULL;
+	}
+	if (!(s = string_get_block<9>(s, fly.rot))) {
+		return NULL;
+	}
+	return s;
 }
 
 
 /**
- *	\brief	Send DTrack command via UDP.
+ *	\brief	Process data of one Flystick ('6df2' line, newer format).
  *
- *	Answer is not received and therefore not processed.
- *	@param[in]	command		command string
- *	@return		sending command succeeded? if not, a DTrack error is available
+ *	@param[in]	s		begin of record
+ *	@param[out]	fly		Flystick data (double or float)
+ *	@param[in]	i		index of Flystick
+ *	@return	pointer behind record; NULL in case of error
+ */
+template<class T>
+char* DTrackSDK::parseFlyStick2(char* s, T& fly, int i)
+{
+	int j, bt;
+
+	if (!(s = string_get_block(s, &fly.id, &fly.quality, &fly.num_button, &fly.num_joystick))) {
+		return NULL;
+	}
+	if (fly.id != i) {  // not expected
+		return NULL;
+	}
+	if ((fly.num_button < 0) || (fly.num_button > DTRACK_FLYSTICK_MAX_BUTTON) ||
+	    (fly.num_joystick < 0) || (fly.num_joystick > DTRACK_FLYSTICK_MAX_JOYSTICK)) {
+		return NULL;
+	}
+	if (!(s = string_get_block<3>(s, fly.loc))){
+		return NULL;
+	}
+	if (!(s = string_get_block<9>(s, fly.rot))){
+		return NULL;
+	}
+	// block with buttons (32 per value) and joystick values
+	if (!(s = string_block_begin(s))) {
+		return NULL;
+	}
+	bt = 0;
+	for (j=0; j<fly.num_button; j++) {
+		if ((j % 32) == 0) {
+			if (!(s = string_get_i(s, &bt))) {
+				return NULL;
+			}
+		}
+		fly.button[j] = bt & 0x01;
+		bt >>= 1;
+	}
+	for (j=0; j<fly.num_joystick; j++) {
+		if (!(s = string_get_value(s, &fly.joystick[j]))) {
+			return NULL;
+		}
+	}
+	return string_block_end(s);
+}
+
+
+/**
+ *	\brief	Process data of one measurement tool ('6dmt' line).
+ *
+ *	@param[in]	s		begin of record
+ *	@param[out]	tool	measurement tool data (double or float)
+ *	@param[in]	i		index of measurement tool
+ *	@return	pointer behind record; NULL in case of error
+ */
+template<class T>
+char* DTrackSDK::parseMeaTool(char* s, T& tool, int i)
+{
+	int bt;
+
+	if (!(s = string_get_block(s, &tool.id, &tool.quality, &bt))) {
+		return NULL;
+	}
+	if (tool.id != i) {  // not expected
+		return NULL;
+	}
+	tool.num_button = 1;
+	tool.button[0] = bt & 0x01;
+	if (!(s = string_get_block<3>(s, tool.loc))) {
+		return NULL;
+	}
+	if (!(s = string_get_block<9>(s, tool.rot))) {
+		return NULL;
+	}
+	return s;
+}
+
+
+/**
+ *	\brief	Process data of one measurement reference ('6dmtr' line).
+ *
+ *	@param[in]	s		begin of record
+ *	@param[out]	ref		measurement reference data (double or float)
+ *	@return	pointer behind record; NULL in case of error
+ */
+template<class T>
+char* DTrackSDK::parseMeaRef(char* s, T& ref)
+{
+	if (!(s = string_get_block(s, &ref.id, &ref.quality))) {
+		return NULL;
+	}
+	if (!(s = string_get_block<3>(s, ref.loc))) {
+		return NULL;
+	}
+	if (!(s = string_get_block<9>(s, ref.rot))) {
+		return NULL;
+	}
+	return s;
+}
+
+
+/**
+ *	\brief	Process data of one Fingertracking hand ('gl' line).
+ *
+ *	@param[in]	s		begin of record
+ *	@param[out]	hand	Fingertracking hand data (double or float)
+ *	@return	pointer behind record; NULL in case of error
+ */
+template<class T>
+char* DTrackSDK::parseHand(char* s, std::vector<T>& hand)
+{
+	int j, id;
+	char* p;
+
+	if (!(p = string_block_begin(s)) || !string_get_i(p, &id)) {
+		return NULL;
+	}
+	if (id < 0) {  // not expected
+		return NULL;
+	}
+	resizeHand(id);
+	act_hand_gen[id] = d_hand_gen;
+	T& h = hand[id];
+	if (!(s = string_get_block(s, &h.id, &h.quality, &h.lr, &h.nfinger))){
+		return NULL;
+	}
+	if ((h.nfinger < 0) || (h.nfinger > DTRACK_HAND_MAX_FINGER)) {
+		h.nfinger = 0;
+		return NULL;
+	}
+	if (!(s = string_get_block<3>(s, h.loc))) {
+		return NULL;
+	}
+	if (!(s = string_get_block<9>(s, h.rot))){
+		return NULL;
+	}
+	// get data of fingers
+	for (j = 0; j < h.nfinger; j++) {
+		if (!(s = string_get_block<3>(s, h.finger[j].loc))) {
+			return NULL;
+		}
+		if (!(s = string_get_block<9>(s, h.finger[j].rot))){
+			return NULL;
+		}
+		if (!(s = string_get_block(s, &h.finger[j].radiustip,
+				&h.finger[j].lengthphalanx[0], &h.finger[j].anglephalanx[0],
+				&h.finger[j].lengthphalanx[1], &h.finger[j].anglephalanx[1],
+				&h.finger[j].lengthphalanx[2]))){
+			return NULL;
+		}
+	}
+	return s;
+}
+
+
+/**
+ *	\brief	Process data of one human model ('6dj' line).
+ *
+ *	@param[in]	s		begin of record
+ *	@param[out]	human	human model data (double or float)
+ *	@return	pointer behind record; NULL in case of error
+ */
+template<class T>
+char* DTrackSDK::parseHuman(char* s, std::vector<T>& human)
+{
+	int j, iarr[2];
+
+	if (!(s = string_get_block<2>(s, iarr))){
+		return NULL;
+	}
+	if ((iarr[0] < 0) || (iarr[0] > act_num_human - 1)) // not expected
+		return NULL;
+	if ((iarr[1] < 0) || (iarr[1] > DTRACK_HUMAN_MAX_JOINTS))
+		return NULL;
+
+	T& h = human[iarr[0]];
+	act_human_gen[iarr[0]] = d_human_gen;
+	h.id = iarr[0];
+	h.num_joints = iarr[1];
+
+	for (j = 0; j < h.num_joints; j++){
+		if (!(s = string_get_block(s, &h.joint[j].id, &h.joint[j].quality))){
+			return NULL;
+		}
+
+		if (!(s = string_get_block(s, &h.joint[j].loc[0], &h.joint[j].loc[1], &h.joint[j].loc[2],
+				&h.joint[j].ang[0], &h.joint[j].ang[1], &h.joint[j].ang[2]))){
+			return NULL;
+		}
+
+		if (!(s = string_get_block<9>(s, h.joint[j].rot))){
+			return NULL;
+		}
+	}
+	return s;
+}
+
+
+/**
+ *	\brief	Process data of all single markers ('3d' line).
+ *
+ *	Number of markers has to be set before.
+ *	@param[in]	s		begin of first record
+ *	@param[out]	marker	single marker data (double or float)
+ *	@return	pointer behind last record; NULL in case of error
+ */
+template<class T>
+char* DTrackSDK::parseMarkers(char* s, std::vector<T>& marker)
+{
+	int i;
+
+	for (i=0; i<act_num_marker; i++) {
+		if (!(s = string_get_block(s, &marker[i].id, &marker[i].quality))) {
+			return NULL;
+		}
+		if (!(s = string_get_block<3>(s, marker[i].loc))) {
+			return NULL;
+		}
+	}
+	return s;
+}
+
+
+/**
+ *	\brief	Discard records of last frame, which have not been processed yet.
+ */
+void DTrackSDK::clearLazyRecords()
+{
+	d_lazy_body.assign(d_lazy_body.size(), NULL);
+	d_lazy_flystick.assign(d_lazy_flystick.size(), NULL);
+	d_lazy_meatool.assign(d_lazy_meatool.size(), NULL);
+	d_lazy_mearef.assign(d_lazy_mearef.size(), NULL);
+	d_lazy_hand.assign(d_lazy_hand.size(), NULL);
+	d_lazy_human.assign(d_lazy_human.size(), NULL);
+	d_lazy_marker = NULL;
+}
+
+
+/**
+ *	\brief	Reset standard body, Flystick, ... data to 'not tracked'.
+ *
+ *	@param[out]	rec		record (double or float)
+ *	@param[in]	id		id of record
+ */
+template<class T>
+static void reset_record(T& rec, int id)
+{
+	memset(&rec, 0, sizeof(rec));
+	rec.id = id;
+	rec.quality = -1;
+}
+
+
+/**
+ *	\brief	Reset human model data to 'not tracked'.
+ *
+ *	@param[out]	rec		record (double or float)
+ *	@param[in]	id		id of human model
+ */
+template<class T>
+static void reset_human(T& rec, int id)
+{
+	memset(&rec, 0, sizeof(rec));
+	rec.id = id;
+	rec.num_joints = 0;
+}
+
+
+/**
+ *	\brief	Bring one record up to date with last frame.
+ *
+ *	Processes the record, if not done yet (lazy processing). In case of an error, the record is
+ *	marked as not tracked and lastDataError is set to ERR_PARSE.
+ *	Resets standard bodies, hands and human models, which were not tracked in last frame (old generation).
+ *	Works on float or double data, depending on setFloatMode().
+ *	@param[in]	type	record type (one of RecordTypes)
+ *	@param[in]	i		index of record
+ */
+void DTrackSDK::updateRecord(int type, int i)
+{
+	char* s;
+	bool ok;
+
+	switch (type) {
+		case RECORD_BODY:
+			if (i >= act_num_body)
+				return;
+			if ((i < (int )d_lazy_body.size()) && (s = d_lazy_body[i])) {
+				d_lazy_body[i] = NULL;
+				ok = d_float ? (parseBody(s, act_body_f) != NULL) : (parseBody(s, act_body) != NULL);
+				if (!ok) {
+					if (d_float) {
+						act_body_f[i].quality = -1;
+					} else {
+						act_body[i].quality = -1;
+					}
+					lastDataError = ERR_PARSE;
+					d_stat.err_parse++;
+				}
+			}
+			if (act_body_gen[i] != d_body_gen) {  // not tracked in last frame
+				if (d_float) {
+					reset_record(act_body_f[i], i);
+				} else {
+					reset_record(act_body[i], i);
+				}
+				act_body_gen[i] = d_body_gen;
+			}
+			return;
+
+		case RECORD_FLYSTICK:
+			if ((i >= act_num_flystick) || (i >= (int )d_lazy_flystick.size()) || !(s = d_lazy_flystick[i]))
+				return;
+			d_lazy_flystick[i] = NULL;
+			if (d_lazy_flystick2) {
+				ok = d_float ? (parseFlyStick2(s, act_flystick_f[i], i) != NULL) : (parseFlyStick2(s, act_flystick[i], i) != NULL);
+			} else {
+				ok = d_float ? (parseFlyStick1(s, act_flystick_f[i], i) != NULL) : (parseFlyStick1(s, act_flystick[i], i) != NULL);
+			}
+			if (!ok) {
+				if (d_float) {
+					act_flystick_f[i].quality = -1;
+				} else {
+					act_flystick[i].quality = -1;
+				}
+				lastDataError = ERR_PARSE;
+				d_stat.err_parse++;
+			}
+			return;
+
+		case RECORD_MEATOOL:
+			if ((i >= act_num_meatool) || (i >= (int )d_lazy_meatool.size()) || !(s = d_lazy_meatool[i]))
+				return;
+			d_lazy_meatool[i] = NULL;
+			ok = d_float ? (parseMeaTool(s, act_meatool_f[i], i) != NULL) : (parseMeaTool(s, act_meatool[i], i) != NULL);
+			if (!ok) {
+				if (d_float) {
+					act_meatool_f[i].quality = -1;
+				} else {
+					act_meatool[i].quality = -1;
+				}
+				lastDataError = ERR_PARSE;
+				d_stat.err_parse++;
+			}
+			return;
+
+		case RECORD_MEAREF:
+			if ((i >= act_num_mearef) || (i >= (int )d_lazy_mearef.size()) || !(s = d_lazy_mearef[i]))
+				return;
+			d_lazy_mearef[i] = NULL;
+			ok = d_float ? (parseMeaRef(s, act_mearef_f[i]) != NULL) : (parseMeaRef(s, act_mearef[i]) != NULL);
+			if (!ok) {
+				if (d_float) {
+					act_mearef_f[i].quality = -1;
+				} else {
+					act_mearef[i].quality = -1;
+				}
+				lastDataError = ERR_PARSE;
+				d_stat.err_parse++;
+			}
+			return;
+
+		case RECORD_HAND:
+			if (i >= act_num_hand)
+				return;
+			if ((i < (int )d_lazy_hand.size()) && (s = d_lazy_hand[i])) {
+				d_lazy_hand[i] = NULL;
+				ok = d_float ? (parseHand(s, act_hand_f) != NULL) : (parseHand(s, act_hand) != NULL);
+				if (!ok) {
+					if (d_float) {
+						act_hand_f[i].quality = -1;
+					} else {
+						act_hand[i].quality = -1;
+					}
+					lastDataError = ERR_PARSE;
+					d_stat.err_parse++;
+				}
+			}
+			if (act_hand_gen[i] != d_hand_gen) {  // not tracked in last frame
+				if (d_float) {
+					reset_record(act_hand_f[i], i);
+				} else {
+					reset_record(act_hand[i], i);
+				}
+				act_hand_gen[i] = d_hand_gen;
+			}
+			return;
+
+		case RECORD_HUMAN:
+			if (i >= act_num_human)
+				return;
+			if ((i < (int )d_lazy_human.size()) && (s = d_lazy_human[i])) {
+				d_lazy_human[i] = NULL;
+				ok = d_float ? (parseHuman(s, act_human_f) != NULL) : (parseHuman(s, act_human) != NULL);
+				if (!ok) {
+					if (d_float) {
+						act_human_f[i].num_joints = 0;
+					} else {
+						act_human[i].num_joints = 0;
+					}
+					lastDataError = ERR_PARSE;
+					d_stat.err_parse++;
+				}
+			}
+			if (act_human_gen[i] != d_human_gen) {  // not tracked in last frame
+				if (d_float) {
+					reset_human(act_human_f[i], i);
+				} else {
+					reset_human(act_human[i], i);
+				}
+				act_human_gen[i] = d_human_gen;
+			}
+			return;
+
+		case RECORD_MARKER:
+			if (!(s = d_lazy_marker))
+				return;
+			d_lazy_marker = NULL;
+			ok = d_float ? (parseMarkers(s, act_marker_f) != NULL) : (parseMarkers(s, act_marker) != NULL);
+			if (!ok) {
+				act_num_marker = 0;
+				lastDataError = ERR_PARSE;
+				d_stat.err_parse++;
+			}
+			return;
+	}
+}
+
+
+/**
+ *	\brief	Bring all records up to date with last frame (see updateRecord()).
+ */
+void DTrackSDK::updateRecords()
+{
+	int i;
+
+	for (i=0; i<act_num_body; i++)
+		updateRecord(RECORD_BODY, i);
+	for (i=0; i<act_num_flystick; i++)
+		updateRecord(RECORD_FLYSTICK, i);
+	for (i=0; i<act_num_meatool; i++)
+		updateRecord(RECORD_MEATOOL, i);
+	for (i=0; i<act_num_mearef; i++)
+		updateRecord(RECORD_MEAREF, i);
+	for (i=0; i<act_num_hand; i++)
+		updateRecord(RECORD_HAND, i);
+	for (i=0; i<act_num_human; i++)
+		updateRecord(RECORD_HUMAN, i);
+	updateRecord(RECORD_MARKER, 0);
+}
+
+
+// ---------------------------------------------------------------------------------------------------
+// Conversion of tracking data between float and double:
+
+/**
+ * 	\brief	Convert values (float <-> double).
+ */
+template<class D, class S>
+static inline void convert_values(D* dst, const S* src, int n)
+{
+	for (int i=0; i<n; i++)
+		dst[i] = (D )src[i];
+}
+
+/**
+ * 	\brief	Convert standard body or measurement reference data (float <-> double).
+ */
+template<class D, class S>
+static void convert_6d(D& dst, const S& src)
+{
+	dst.id = src.id;
+	convert_values(&dst.quality, &src.quality, 1);
+	convert_values(dst.loc, src.loc, 3);
+	convert_values(dst.rot, src.rot, 9);
+}
+
+/**
+ * 	\brief	Convert Flystick data (float <-> double).
+ */
+template<class D, class S>
+static void convert_flystick(D& dst, const S& src)
+{
+	convert_6d(dst, src);
+	dst.num_button = src.num_button;
+	memcpy(dst.button, src.button, sizeof(dst.button));
+	dst.num_joystick = src.num_joystick;
+	convert_values(dst.joystick, src.joystick, DTRACK_FLYSTICK_MAX_JOYSTICK);
+}
+
+/**
+ * 	\brief	Convert measurement tool data (float <-> double).
+ */
+template<class D, class S>
+static void convert_meatool(D& dst, const S& src)
+{
+	convert_6d(dst, src);
+	dst.num_button = src.num_button;
+	memcpy(dst.button, src.button, sizeof(dst.button));
+}
+
+/**
+ * 	\brief	Convert Fingertracking hand data (float <-> double).
+ */
+template<class D, class S>
+static void convert_hand(D& dst, const S& src)
+{
+	convert_6d(dst, src);
+	dst.lr = src.lr;
+	dst.nfinger = src.nfinger;
+	for (int j=0; j<DTRACK_HAND_MAX_FINGER; j++) {
+		convert_values(dst.finger[j].loc, src.finger[j].loc, 3);
+		convert_values(dst.finger[j].rot, src.finger[j].rot, 9);
+		convert_values(&dst.finger[j].radiustip, &src.finger[j].radiustip, 1);
+		convert_values(dst.finger[j].lengthphalanx, src.finger[j].lengthphalanx, 3);
+		convert_values(dst.finger[j].anglephalanx, src.finger[j].anglephalanx, 2);
+	}
+}
+
+/**
+ * 	\brief	Convert human model data (float <-> double).
+ */
+template<class D, class S>
+static void convert_human(D& dst, const S& src)
+{
+	dst.id = src.id;
+	dst.num_joints = src.num_joints;
+	for (int j=0; j<src.num_joints; j++) {
+		dst.joint[j].id = src.joint[j].id;
+		convert_values(&dst.joint[j].quality, &src.joint[j].quality, 1);
+		convert_values(dst.joint[j].loc, src.joint[j].loc, 3);
+		convert_values(dst.joint[j].ang, src.joint[j].ang, 3);
+		convert_values(dst.joint[j].rot, src.joint[j].rot, 9);
+	}
+}
+
+/**
+ * 	\brief	Convert single marker data (float <-> double).
+ */
+template<class D, class S>
+static void convert_marker(D& dst, const S& src)
+{
+	dst.id = src.id;
+	convert_values(&dst.quality, &src.quality, 1);
+	convert_values(dst.loc, src.loc, 3);
+}
+
+/**
+ * 	\brief	Get record of the precision not in use, as target of a conversion.
+ *
+ *	The vector is sized for all records of the frame at once, so pointers to converted records stay valid.
+ */
+template<class T>
+static T& unused_record(std::vector<T>& rec, int num, int i)
+{
+	if ((int )rec.size() < num) {
+		rec.resize(num);
+	}
+	return rec[i];
+}
+
+// ---------------------------------------------------------------------------------------------------
+
+
+/**
+ *	\brief	Convert one record into the precision not used for processing (see setFloatMode()).
+ *
+ *	Record has to be up to date (see updateRecord()).
+ *	@param[in]	type	record type (one of RecordTypes)
+ *	@param[in]	i		index of record
+ */
+void DTrackSDK::convertRecord(int type, int i)
+{
+	switch (type) {
+		case RECORD_BODY:
+			if (d_float) convert_6d(unused_record(act_body, act_num_body, i), act_body_f[i]);
+			else convert_6d(unused_record(act_body_f, act_num_body, i), act_body[i]);
+			return;
+		case RECORD_FLYSTICK:
+			if (d_float) convert_flystick(unused_record(act_flystick, act_num_flystick, i), act_flystick_f[i]);
+			else convert_flystick(unused_record(act_flystick_f, act_num_flystick, i), act_flystick[i]);
+			return;
+		case RECORD_MEATOOL:
+			if (d_float) convert_meatool(unused_record(act_meatool, act_num_meatool, i), act_meatool_f[i]);
+			else convert_meatool(unused_record(act_meatool_f, act_num_meatool, i), act_meatool[i]);
+			return;
+		case RECORD_MEAREF:
+			if (d_float) convert_6d(unused_record(act_mearef, act_num_mearef, i), act_mearef_f[i]);
+			else convert_6d(unused_record(act_mearef_f, act_num_mearef, i), act_mearef[i]);
+			return;
+		case RECORD_HAND:
+			if (d_float) convert_hand(unused_record(act_hand, act_num_hand, i), act_hand_f[i]);
+			else convert_hand(unused_record(act_hand_f, act_num_hand, i), act_hand[i]);
+			return;
+		case RECORD_HUMAN:
+			if (d_float) convert_human(unused_record(act_human, act_num_human, i), act_human_f[i]);
+			else convert_human(unused_record(act_human_f, act_num_human, i), act_human[i]);
+			return;
+		case RECORD_MARKER:
+			if (d_float) convert_marker(unused_record(act_marker, act_num_marker, i), act_marker_f[i]);
+			else convert_marker(unused_record(act_marker_f, act_num_marker, i), act_marker[i]);
+			return;
+	}
+}
+
+
+/**
+ *	\brief	Convert all records into the precision not used for processing (see convertRecord()).
+ */
+void DTrackSDK::convertRecords()
+{
+	int i;
+
+	for (i=0; i<act_num_body; i++)
+		convertRecord(RECORD_BODY, i);
+	for (i=0; i<act_num_flystick; i++)
+		convertRecord(RECORD_FLYSTICK, i);
+	for (i=0; i<act_num_meatool; i++)
+		convertRecord(RECORD_MEATOOL, i);
+	for (i=0; i<act_num_mearef; i++)
+		convertRecord(RECORD_MEAREF, i);
+	for (i=0; i<act_num_hand; i++)
+		convertRecord(RECORD_HAND, i);
+	for (i=0; i<act_num_human; i++)
+		convertRecord(RECORD_HUMAN, i);
+	for (i=0; i<act_num_marker; i++)
+		convertRecord(RECORD_MARKER, i);
+}
+
+
+/**
+ *	\brief	Convert one record into compact poses (see setCompactPoses()).
+ *
+ *	Brings the record up to date first (see updateRecord()).
+ *	@param[in]	type	record type (RECORD_BODY, RECORD_HAND or RECORD_HUMAN)
+ *	@param[in]	i		index of record
+ */
+void DTrackSDK::convertPose(int type, int i)
+{
+	updateRecord(type, i);
+
+	switch (type) {
+		case RECORD_BODY:
+			if (d_float) pose_convert(act_body_pose[i], act_body_f[i]); else pose_convert(act_body_pose[i], act_body[i]);
+			return;
+		case RECORD_HAND:
+			if (d_float) pose_convert(act_hand_pose[i], act_hand_f[i]); else pose_convert(act_hand_pose[i], act_hand[i]);
+			return;
+		case RECORD_HUMAN:
+			if (d_float) pose_convert(act_human_pose[i], act_human_f[i]); else pose_convert(act_human_pose[i], act_human[i]);
+			return;
+	}
+}
+
+
+/**
+ *	\brief	Convert all standard bodies, hands and human models into compact poses (see convertPose()).
+ */
+void DTrackSDK::convertPoses()
+{
+	int i;
+
+	for (i=0; i<act_num_body; i++)
+		convertPose(RECORD_BODY, i);
+	for (i=0; i<act_num_hand; i++)
+		convertPose(RECORD_HAND, i);
+	for (i=0; i<act_num_human; i++)
+		convertPose(RECORD_HUMAN, i);
+}
+
+
+/**
+ *	\brief	Start receiver thread.
+ *
+ *	The thread receives and processes tracking data in the background and hands over complete
+ *	frames through latestFrame(). While the thread is running, receive() fails and the data getters
+ *	(getFrameCounter(), getBody(), ...) must not be used.
+ *	@return	thread started? (false if already running or on error)
+ */
+bool DTrackSDK::startReceiverThread()
+{
+	if ((d_thread != NULL) || d_thread_external || !isLocalDataPortValid())
+		return false;
+
+	initFrames();
+	d_thread_run = 1;
+	if (thread_start(&d_thread, receiverThread, this)) {
+		d_thread = NULL;
+		d_thread_run = 0;
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ *	\brief	Stop receiver thread.
+ *
+ *	Waits until the thread has finished (at most 100 ms).
+ */
+void DTrackSDK::stopReceiverThread()
+{
+	if (d_thread == NULL)
+		return;
+	atomic_store(&d_thread_run, 0);
+	thread_join(d_thread);
+	d_thread = NULL;
+}
+
+
+/**
+ *	\brief	Is receiver thread running?
+ *
+ *	Also true while a DTrackMultiReceiver thread receives data for this instance.
+ *	@return	thread running?
+ */
+bool DTrackSDK::isReceiverThreadRunning()
+{
+	return (d_thread != NULL) || d_thread_external;
+}
+
+
+/**
+ *	\brief	Reset triple buffer of receiver thread (no frame available).
+ */
+void DTrackSDK::initFrames()
+{
+	// triple buffer: each index owned by exactly one side, no frame available yet
+	d_frame_back = 0;
+	d_frame_middle = 1;
+	d_frame_front = 2;
+	d_frame_valid = false;
+}
+
+
+/**
+ *	\brief	Get latest frame processed by the receiver thread.
+ *
+ *	Never blocks. The returned frame stays unchanged until the next call of latestFrame(),
+ *	it is the same frame as before if no newer one has been processed in the meantime.
+ *	@return	latest frame, NULL if no frame is available yet
+ */
+const DTrack_Frame_Type_d* DTrackSDK::latestFrame()
+{
+	if (atomic_load(&d_frame_middle) & FRAME_NEW) {  // swap in the newer frame
+		d_frame_front = atomic_exchange(&d_frame_middle, d_frame_front) & ~FRAME_NEW;
+		d_frame_valid = true;
+	}
+	if (!d_frame_valid)
+		return NULL;
+	return &d_frame[d_frame_front];
+}
+
+
+/**
+ *	\brief	Main loop of receiver thread.
+ *
+ *	@param[in]	arg		DTrackSDK instance
+ */
+void DTrackSDK::receiverThread(void* arg)
+{
+	DTrackSDK* dt = (DTrackSDK* )arg;
+	int tout_us = (dt->d_udptimeout_us < THREAD_TIMEOUT_US) ? dt->d_udptimeout_us : THREAD_TIMEOUT_US;
+
+	while (atomic_load(&dt->d_thread_run)) {
+		if (dt->receiveData(tout_us)) {
+			dt->publishFrame();
+		} else if (dt->lastDataError != ERR_TIMEOUT) {  // timeouts are part of waiting for stop
+			dt->statError();
+			if (dt->lastDataError == ERR_NET) {  // socket fails without waiting: don't retry at once
+				thread_sleep(tout_us);
+			}
+		}
+	}
+}
+
+
+/**
+ * 	\brief	Copy first num records of a vector (keeps capacity of destination).
+ */
+template<typename T>
+static void copy_records(std::vector<T>& dst, int& dst_num, const std::vector<T>& src, int num)
+{
+	if (num < 0)
+		num = 0;
+	dst.assign(src.begin(), src.begin() + num);
+	dst_num = num;
+}
+
+
+/**
+ *	\brief	Copy current tracking data into the triple buffer and hand it over to latestFrame().
+ */
+void DTrackSDK::publishFrame()
+{
+	DTrack_Frame_Type_d* frame = &d_frame[d_frame_back];
+
+	updateRecords();
+	if (d_float) {  // frame contains double data
+		convertRecords();
+	}
+
+	frame->framecounter = act_framecounter;
+	frame->timestamp = act_timestamp;
+	frame->rxtimestamp = act_rxtimestamp;
+	copy_records(frame->body, frame->num_body, act_body, act_num_body);
+	copy_records(frame->flystick, frame->num_flystick, act_flystick, act_num_flystick);
+	copy_records(frame->meatool, frame->num_meatool, act_meatool, act_num_meatool);
+	copy_records(frame->mearef, frame->num_mearef, act_mearef, act_num_mearef);
+	copy_records(frame->hand, frame->num_hand, act_hand, act_num_hand);
+	copy_records(frame->human, frame->num_human, act_human, act_num_human);
+	copy_records(frame->marker, frame->num_marker, act_marker, act_num_marker);
+	fillStatistics(frame->statistics);
+	frame->latency = net_time() - act_rxtimestamp;  // including processing of lazy records and copying
+
+	d_frame_back = atomic_exchange(&d_frame_middle, d_frame_back | FRAME_NEW) & ~FRAME_NEW;
+}
+
+
+/**
+ * 	\brief	Copy first records of a vector into a frame in shared memory.
+ *
+ *	@return	number of copied records (limited by max)
+ */
+template<typename T>
+static int copy_shm_records(char* frame, int offset, const std::vector<T>& src, int num, int max)
+{
+	if (num > (int )src.size())
+		num = (int )src.size();
+	if (num > max)
+		num = max;
+	if (num <= 0)
+		return 0;
+	memcpy(frame + offset, &src[0], num * sizeof(T));
+	return num;
+}
+
+
+/**
+ *	\brief	Write current tracking data as next frame into shared memory.
+ */
+void DTrackSDK::writeSharedFrame()
+{
+	char* frame;
+	DTrack_Shm_Frame_Type* h;
+
+	updateRecords();
+	if (d_float) {  // frame contains double data
+		convertRecords();
+	}
+
+	frame = (char* )shm_frame_begin(d_shmframes);
+	h = (DTrack_Shm_Frame_Type* )frame;
+	*h = d_shmheader;  // offsets
+	h->framecounter = act_framecounter;
+	h->timestamp = act_timestamp;
+	h->rxtimestamp = act_rxtimestamp;
+	h->num_body = copy_shm_records(frame, h->offset_body, act_body, act_num_body, d_shmlayout.max_body);
+	h->num_flystick = copy_shm_records(frame, h->offset_flystick, act_flystick, act_num_flystick, d_shmlayout.max_flystick);
+	h->num_meatool = copy_shm_records(frame, h->offset_meatool, act_meatool, act_num_meatool, d_shmlayout.max_meatool);
+	h->num_mearef = copy_shm_records(frame, h->offset_mearef, act_mearef, act_num_mearef, d_shmlayout.max_mearef);
+	h->num_hand = copy_shm_records(frame, h->offset_hand, act_hand, act_num_hand, d_shmlayout.max_hand);
+	h->num_human = copy_shm_records(frame, h->offset_human, act_human, act_num_human, d_shmlayout.max_human);
+	h->num_marker = copy_shm_records(frame, h->offset_marker, act_marker, act_num_marker, d_shmlayout.max_marker);
+	shm_frame_commit(d_shmframes);
+}
+
+
+/**
+ * 	\brief	Get number of calibrated standard bodies (as far as known).
+ *
+ *	Refers to last received frame.
+ *	@return		number of calibrated standard bodies
+ */
+int DTrackSDK::getNumBody()
+{
+	return act_num_body;
+}
+
+
+/**
+ * 	\brief	Get standard body data
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from float data, if float mode is on (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max standard body id - 1)
+ *	@return		id-th standard body data
+ */
+DTrack_Body_Type_d* DTrackSDK::getBody(int id)
+{
+	if ((id >= 0) && (id < act_num_body)) {
+		updateRecord(RECORD_BODY, id);
+		if (d_float) {  // processed as float
+			convertRecord(RECORD_BODY, id);
+		}
+		return &act_body.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get float standard body data
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from double data, if float mode is off (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max standard body id - 1)
+ *	@return		id-th standard body data
+ */
+DTrack_Body_Type_f* DTrackSDK::getBodyFloat(int id)
+{
+	if ((id >= 0) && (id < act_num_body)) {
+		updateRecord(RECORD_BODY, id);
+		if (!d_float) {  // processed as double
+			convertRecord(RECORD_BODY, id);
+		}
+		return &act_body_f.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get compact pose of standard body.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted on every call, if compact poses are off (see setCompactPoses()).
+ *	@param[in]	id	id, range 0 .. (max standard body id - 1)
+ *	@return		id-th standard body data
+ */
+DTrack_Body_Pose_Type* DTrackSDK::getBodyPose(int id)
+{
+	if ((id >= 0) && (id < act_num_body)) {
+		if (!d_poses || d_lazy) {  // not filled by receive()
+			convertPose(RECORD_BODY, id);
+		}
+		return &act_body_pose.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get number of calibrated Flysticks.
+ *
+ *	Refers to last received frame.
+ *	@return		number of calibrated Flysticks
+ */
+int DTrackSDK::getNumFlyStick()
+{
+	return act_num_flystick;
+}
+
+
+/**
+ * 	\brief	Get Flystick data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from float data, if float mode is on (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max flystick id - 1)
+ *	@return		id-th Flystick data.
+ */
+DTrack_FlyStick_Type_d* DTrackSDK::getFlyStick(int id)
+{
+	if ((id >= 0) && (id < act_num_flystick)) {
+		updateRecord(RECORD_FLYSTICK, id);
+		if (d_float) {  // processed as float
+			convertRecord(RECORD_FLYSTICK, id);
+		}
+		return &act_flystick.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get float Flystick data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from double data, if float mode is off (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max flystick id - 1)
+ *	@return		id-th Flystick data.
+ */
+DTrack_FlyStick_Type_f* DTrackSDK::getFlyStickFloat(int id)
+{
+	if ((id >= 0) && (id < act_num_flystick)) {
+		updateRecord(RECORD_FLYSTICK, id);
+		if (!d_float) {  // processed as double
+			convertRecord(RECORD_FLYSTICK, id);
+		}
+		return &act_flystick_f.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get number of calibrated measurement tools.
+ *
+ *	Refers to last received frame.
+ *	@return		number of calibrated measurement tools
+ */
+int DTrackSDK::getNumMeaTool()
+{
+	return act_num_meatool;
+}
+
+
+/**
+ * 	\brief	Get measurement tool data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from float data, if float mode is on (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max tool id - 1)
+ *	@return		id-th measurement tool data.
+ */
+DTrack_MeaTool_Type_d* DTrackSDK::getMeaTool(int id)
+{
+	if ((id >= 0) && (id < act_num_meatool)) {
+		updateRecord(RECORD_MEATOOL, id);
+		if (d_float) {  // processed as float
+			convertRecord(RECORD_MEATOOL, id);
+		}
+		return &act_meatool.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get float measurement tool data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from double data, if float mode is off (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max tool id - 1)
+ *	@return		id-th measurement tool data.
+ */
+DTrack_MeaTool_Type_f* DTrackSDK::getMeaToolFloat(int id)
+{
+	if ((id >= 0) && (id < act_num_meatool)) {
+		updateRecord(RECORD_MEATOOL, id);
+		if (!d_float) {  // processed as double
+			convertRecord(RECORD_MEATOOL, id);
+		}
+		return &act_meatool_f.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get number of calibrated measurement references.
+ *
+ *	Refers to last received frame.
+ *	@return		number of calibrated measurement references
+ */
+int DTrackSDK::getNumMeaRef()
+{
+	return act_num_mearef;
+}
+
+
+/**
+ * 	\brief	Get measurement reference data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from float data, if float mode is on (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max measurement reference id - 1)
+ *	@return		id-th measurement reference data.
+ */
+DTrack_MeaRef_Type_d* DTrackSDK::getMeaRef(int id)
+{
+	if ((id >= 0) && (id < act_num_mearef)) {
+		updateRecord(RECORD_MEAREF, id);
+		if (d_float) {  // processed as float
+			convertRecord(RECORD_MEAREF, id);
+		}
+		return &act_mearef.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get float measurement reference data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from double data, if float mode is off (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max measurement reference id - 1)
+ *	@return		id-th measurement reference data.
+ */
+DTrack_MeaRef_Type_f* DTrackSDK::getMeaRefFloat(int id)
+{
+	if ((id >= 0) && (id < act_num_mearef)) {
+		updateRecord(RECORD_MEAREF, id);
+		if (!d_float) {  // processed as double
+			convertRecord(RECORD_MEAREF, id);
+		}
+		return &act_mearef_f.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get number of calibrated Fingertracking hands (as far as known).
+ *
+ *	Refers to last received frame.
+ *	@return		number of calibrated fingertracking hands
+ */
+int DTrackSDK::getNumHand()
+{
+	return act_num_hand;
+}
+
+
+/**
+ * 	\brief	Get Fingertracking hand data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from float data, if float mode is on (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max hand id - 1)
+ *	@return		id-th Fingertracking hand data
+ */
+DTrack_Hand_Type_d* DTrackSDK::getHand(int id)
+{
+	if ((id >= 0) && (id < act_num_hand)) {
+		updateRecord(RECORD_HAND, id);
+		if (d_float) {  // processed as float
+			convertRecord(RECORD_HAND, id);
+		}
+		return &act_hand.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get float Fingertracking hand data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from double data, if float mode is off (see setFloatMode()).
+ *	@param[in]	id	id, range 0 .. (max hand id - 1)
+ *	@return		id-th Fingertracking hand data
+ */
+DTrack_Hand_Type_f* DTrackSDK::getHandFloat(int id)
+{
+	if ((id >= 0) && (id < act_num_hand)) {
+		updateRecord(RECORD_HAND, id);
+		if (!d_float) {  // processed as double
+			convertRecord(RECORD_HAND, id);
+		}
+		return &act_hand_f.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get compact poses of Fingertracking hand.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted on every call, if compact poses are off (see setCompactPoses()).
+ *	@param[in]	id	id, range 0 .. (max hand id - 1)
+ *	@return		id-th Fingertracking hand data
+ */
+DTrack_Hand_Pose_Type* DTrackSDK::getHandPose(int id)
+{
+	if ((id >= 0) && (id < act_num_hand)) {
+		if (!d_poses || d_lazy) {  // not filled by receive()
+			convertPose(RECORD_HAND, id);
+		}
+		return &act_hand_pose.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+* 	\brief	Get human data
+*
+*	Refers to last received frame. Currently not tracked human models get a num_joints 0
+*	@return		  id-th human model data
+*/
+int DTrackSDK::getNumHuman()
+{
+	return act_num_human;
+}
+
+
+/**
+* 	\brief	Get human data
+*
+*	Refers to last received frame. Currently not tracked human models get a num_joints 0
+*	Converted from float data, if float mode is on (see setFloatMode()).
+*	@param[in]	id	id, range 0 .. (max standard body id - 1)
+*	@return		id-th human model data
+*/
+DTrack_Human_Type* DTrackSDK::getHuman(int id)
+{
+	if ((id >= 0) && (id < act_num_human)) {
+		updateRecord(RECORD_HUMAN, id);
+		if (d_float) {  // processed as float
+			convertRecord(RECORD_HUMAN, id);
+		}
+		return &act_human.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+* 	\brief	Get float human data
+*
+*	Refers to last received frame. Currently not tracked human models get a num_joints 0
+*	Converted from double data, if float mode is off (see setFloatMode()).
+*	@param[in]	id	id, range 0 .. (max standard body id - 1)
+*	@return		id-th human model data
+*/
+DTrack_Human_Type_f* DTrackSDK::getHumanFloat(int id)
+{
+	if ((id >= 0) && (id < act_num_human)) {
+		updateRecord(RECORD_HUMAN, id);
+		if (!d_float) {  // processed as double
+			convertRecord(RECORD_HUMAN, id);
+		}
+		return &act_human_f.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+* 	\brief	Get compact poses of human model joints
+*
+*	Refers to last received frame. Currently not tracked human models get a num_joints 0
+*	Converted on every call, if compact poses are off (see setCompactPoses()).
+*	@param[in]	id	id, range 0 .. (max standard body id - 1)
+*	@return		id-th human model data
+*/
+DTrack_Human_Pose_Type* DTrackSDK::getHumanPose(int id)
+{
+	if ((id >= 0) && (id < act_num_human)) {
+		if (!d_poses || d_lazy) {  // not filled by receive()
+			convertPose(RECORD_HUMAN, id);
+		}
+		return &act_human_pose.at(id);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get number of tracked single markers.
+ *
+ *	Refers to last received frame.
+ *	@return	number of tracked single markers
+ */
+int DTrackSDK::getNumMarker()
+{
+	return act_num_marker;
+}
+
+
+/**
+ * 	\brief	Get single marker data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from float data, if float mode is on (see setFloatMode()).
+ *	@param[in]	index	index, range 0 .. (max marker id - 1)
+ *	@return		i-th single marker data
+ */
+DTrack_Marker_Type_d* DTrackSDK::getMarker(int index)
+{
+	updateRecord(RECORD_MARKER, 0);
+	if ((index >= 0) && (index < act_num_marker)) {
+		if (d_float) {  // processed as float
+			convertRecord(RECORD_MARKER, index);
+		}
+		return &act_marker.at(index);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get float single marker data.
+ *
+ *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+ *	Converted from double data, if float mode is off (see setFloatMode()).
+ *	@param[in]	index	index, range 0 .. (max marker id - 1)
+ *	@return		i-th single marker data
+ */
+DTrack_Marker_Type_f* DTrackSDK::getMarkerFloat(int index)
+{
+	updateRecord(RECORD_MARKER, 0);
+	if ((index >= 0) && (index < act_num_marker)) {
+		if (!d_float) {  // processed as double
+			convertRecord(RECORD_MARKER, index);
+		}
+		return &act_marker_f.at(index);
+	}
+	return NULL;
+}
+
+
+/**
+ * 	\brief	Get frame counter.
+ *
+ *	Refers to last received frame.
+ *	@return		frame counter
+ */
+unsigned int DTrackSDK::getFrameCounter()
+{
+	return act_framecounter;
+}
+
+
+/**
+ * 	\brief	Get timestamp.
+ *
+ *	Refers to last received frame.
+ *	@return		timestamp (-1 if information not available)
+ */
+double DTrackSDK::getTimeStamp()
+{
+	return act_timestamp;
+}
+
+
+/**
+ * 	\brief	Get receive timestamp.
+ *
+ *	Time when the packet of the last received frame arrived. On Linux this is taken by the kernel
+ *	(SO_TIMESTAMPNS), on other systems when the packet is fetched from the socket.
+ *	Together with getTimeStamp() it shows the delay caused by the tracking system and the network,
+ *	if the clocks of both computers are synchronized.
+ *	@return		receive timestamp in s since 1970-01-01 00:00:00 UTC (-1 if information not available)
+ */
+double DTrackSDK::getReceiveTimeStamp()
+{
+	return act_rxtimestamp;
+}
+
+
+/**
+ * 	\brief	Get receive latency.
+ *
+ *	Time between arrival of the packet (see getReceiveTimeStamp()) and the end of its processing by
+ *	receive(), i.e. the delay caused by this computer. Records processed later in lazy mode
+ *	(see setLazyParsing()) are not included.
+ *	@return		latency in s (-1 if information not available)
+ */
+double DTrackSDK::getReceiveLatency()
+{
+	return act_latency;
+}
+
+
+/**
+ *	\brief	Send DTrack command via UDP.
+ *
+ *	Answer is not received and therefore not processed.
+ *	@param[in]	command		command string
+ *	@return		sending command succeeded? if not, a DTrack error is available
  */
 bool DTrackSDK::sendCommand(const std::string command)
 {
@@ -1081,20 +3094,56 @@ bool DTrackSDK::sendCommand(const std::string command)
 
 
 /**
- * 	\brief Send DTrack2 command to DTrack and receive answer (TCP command interface).
+ * 	\brief Send DTrack2 command to DTrack and receive answer (TCP command interface).
+ *
+ *	Answers like "dtrack2 ok" and "dtrack2 err .." are processed. Both cases are reflected in
+ *	the return value. getLastDTrackError() and getLastDTrackErrorDescription() will return more information.
+ *	Answers of asynchronous commands sent before are processed meanwhile (see sendDTrack2CommandAsync()).
+ *
+ * 	@param[in]	command	DTrack2 command string
+ * 	@param[out]	answer	buffer for answer; NULL if specific answer is not needed
+ * 	@return	0	specific answer, needs to be parsed
+ *  @return 1   answer is "dtrack2 ok"
+ *  @return 2   answer is "dtrack2 err ..". Refer to getLastDTrackError() and getLastDTrackErrorDescription().
+ * 	@return <0 if error occured (-1 receive timeout, -2 wrong system type, -3 command too long, -4 answer too long,
+ *  -9 broken tcp connection, -10 tcp connection invalid, -11 send command failed)
+ */
+int DTrackSDK::sendDTrack2Command(const std::string command, std::string *answer)
+{
+	if (answer)
+		*answer = "";
+
+	int id = sendDTrack2CommandAsync(command);
+	if (id < 0)
+		return id;
+
+	int err = waitDTrack2Command(id, answer);
+
+	// no answer yet: drop answer arriving later
+	for (std::deque<DTrack2Request>::iterator it = d_cmd_pending.begin(); it != d_cmd_pending.end(); it++) {
+		if (it->id == id)
+			it->keep = false;
+	}
+
+	return err;
+}
+
+
+/**
+ * 	\brief Send DTrack2 command to DTrack without waiting for the answer (TCP command interface).
  *
- *	Answers like "dtrack2 ok" and "dtrack2 err .." are processed. Both cases are reflected in
- *	the return value. getLastDTrackError() and getLastDTrackErrorDescription() will return more information.
+ *	Several commands can be sent one after the other (pipelining), DTrack answers them in order.
+ *	Answers are received by processDTrack2Answers() and waitDTrack2Command(), and handed over
+ *	either to the callback or, without callback, to waitDTrack2Command(). If DTRACK_CMD_PIPELINE
+ *	commands are waiting for their answers already, the oldest answer is received first.
+ *	Commands are not thread-safe, i.e. must be used by one thread only.
  *
- * 	@param[in]	command	DTrack2 command string
- * 	@param[out]	answer	buffer for answer; NULL if specific answer is not needed
- * 	@return	0	specific answer, needs to be parsed
- *  @return 1   answer is "dtrack2 ok"
- *  @return 2   answer is "dtrack2 err ..". Refer to getLastDTrackError() and getLastDTrackErrorDescription().
- * 	@return <0 if error occured (-1 receive timeout, -2 wrong system type, -3 command too long,
- *  -9 broken tcp connection, -10 tcp connection invalid, -11 send command failed)
+ * 	@param[in]	command		DTrack2 command string
+ * 	@param[in]	callback	callback for answer; NULL to fetch the answer by waitDTrack2Command()
+ * 	@param[in]	userdata	user data handed over to the callback
+ * 	@return	id of command (>0), <0 if error occured (same as sendDTrack2Command())
  */
-int DTrackSDK::sendDTrack2Command(const std::string command, std::string *answer)
+int DTrackSDK::sendDTrack2CommandAsync(const std::string command, DTrack2CommandCallback callback, void* userdata)
 {
 	// Params via TCP are not supported in DTrack
 	if (rsType != SYS_DTRACK_2)
@@ -1115,75 +3164,333 @@ int DTrackSDK::sendDTrack2Command(const std::string command, std::string *answer
 		return -10;
 	}
 
+	// limit number of commands waiting for their answers (DTrack2 would stop reading commands):
+	while (d_cmd_pending.size() >= DTRACK_CMD_PIPELINE) {
+		int err = receiveDTrack2Answers(d_tcptimeout_us);
+		if (err < 0)
+			return err;
+
+		if (!isCommandInterfaceValid()) {	// closed by a callback
+			lastServerError = ERR_NET;
+			return -10;
+		}
+	}
+
 	// send TCP command string:
 	if ((tcp_send(d_tcpsock, command.c_str(), command.length() + 1, d_tcptimeout_us))) {
 		lastServerError = ERR_NET;
 		return -11;
 	}
 
-	// receive TCP response string:
-	char ans[DTRACK_PROT_MAXLEN];
+	d_cmd_id = (d_cmd_id < 0x7fffffff) ? d_cmd_id + 1 : 1;
+
+	DTrack2Request req;
+	req.id = d_cmd_id;
+	req.callback = callback;
+	req.userdata = userdata;
+	req.keep = (callback == NULL);
+	req.result = 0;
+	req.error = ERR_NONE;
+	req.dtrack_error = 0;
+	d_cmd_pending.push_back(req);
+
+	return req.id;
+}
+
+
+/**
+ * 	\brief Wait for the answer of an asynchronous DTrack2 command.
+ *
+ *	Answers of older commands are processed meanwhile, i.e. their callbacks are called.
+ *	On timeout the command keeps waiting for its answer, so waitDTrack2Command() can be called again.
+ *
+ * 	@param[in]	id		id of command sent by sendDTrack2CommandAsync() without callback
+ * 	@param[out]	answer	buffer for answer; NULL if specific answer is not needed
+ * 	@return	result, same as return value of sendDTrack2Command() (-12 unknown id)
+ */
+int DTrackSDK::waitDTrack2Command(int id, std::string *answer)
+{
+	if (answer)
+		*answer = "";
+
+	std::map<int, DTrack2Request>::iterator it;
+	while ((it = d_cmd_done.find(id)) == d_cmd_done.end()) {
+		bool pending = false;
+		for (std::deque<DTrack2Request>::iterator itp = d_cmd_pending.begin(); itp != d_cmd_pending.end(); itp++) {
+			if (itp->id == id && itp->keep)
+				pending = true;
+		}
+
+		if (!pending) {
+			setLastDTrackError();
+			return -12;
+		}
+
+		int err = receiveDTrack2Answers(d_tcptimeout_us);
+		if (err < 0 && d_cmd_done.find(id) == d_cmd_done.end())
+			return err;
+	}
+
+	// hand over result:
+	int result = it->second.result;
+	lastServerError = it->second.error;
+	setLastDTrackError(it->second.dtrack_error, it->second.dtrack_error_string);
+	if (answer)
+		*answer = it->second.answer;
+
+	d_cmd_done.erase(it);
+	return result;
+}
+
+
+/**
+ * 	\brief Receive answers of asynchronous DTrack2 commands.
+ *
+ *	Processes all answers available, calls the callbacks of the answered commands.
+ *
+ * 	@param[in]	tout_us		timeout in us to wait for the first answer; default is 0 (no waiting)
+ * 	@return	number of answered commands, <0 if error occured (-9 broken tcp connection, -10 tcp connection invalid)
+ */
+int DTrackSDK::processDTrack2Answers(int tout_us)
+{
+	// connection invalid
+	if (!isCommandInterfaceValid()) {
+		lastServerError = ERR_NET;
+		return -10;
+	}
+
+	int num = 0;
+	int err = 0;
+	while (!d_cmd_pending.empty()) {
+		err = receiveDTrack2Answers((num == 0) ? tout_us : 0);
+		if (err <= 0)
+			break;
+
+		num += err;
+	}
+
+	if (err < -1)
+		return err;
+
+	return num;
+}
+
+
+/**
+ * 	\brief Get number of asynchronous DTrack2 commands waiting for their answers.
+ *
+ * 	@return	number of commands
+ */
+int DTrackSDK::getNumPendingDTrack2Commands()
+{
+	return (int )d_cmd_pending.size();
+}
+
+
+/**
+ *	\brief	Receive answers of asynchronous DTrack2 commands and hand them over.
+ *
+ *	@param[in]	tout_us		timeout in us to wait for data
+ *	@return	number of answered commands, <0 if error occured (see sendDTrack2Command())
+ */
+int DTrackSDK::receiveDTrack2Answers(int tout_us)
+{
+	// receive TCP response strings (several answers might arrive at once):
+	char buf[DTRACK_PROT_MAXLEN * DTRACK_CMD_PIPELINE];
 	int err;
-	if ((err = tcp_receive(d_tcpsock, ans, DTRACK_PROT_MAXLEN, d_tcptimeout_us)) < 0) {
+	if ((err = tcp_receive_stream(d_tcpsock, buf, sizeof(buf), tout_us)) < 0) {
 
 		if (err == -1) {	// timeout
 			lastServerError = ERR_TIMEOUT;
+			return -1;
 		}
-		else
+
+		lastServerError = ERR_NET;	// network error
+
 		if (err == -9) {	// broken connection
 			tcp_exit(d_tcpsock);
 			d_tcpsock = NULL;
+			d_cmd_buf = "";
+			d_cmd_skip = false;
+			failDTrack2Requests(-9);
 		}
-		else
-			lastServerError = ERR_NET;	// network error
-
-		if (answer)
-			*answer = "";
 
 		return err;
 	}
 
-	// parse answer:
+	d_cmd_buf.append(buf, err);
+
+	// answers are terminated by '\0', assign them in order of sending:
+	int num = 0;
+	std::string::size_type len;
+	while ((len = d_cmd_buf.find('\0')) != std::string::npos) {
+		std::string ans = d_cmd_buf.substr(0, len);
+		d_cmd_buf.erase(0, len + 1);
+
+		if (d_cmd_skip) {	// end of answer that was too long
+			d_cmd_skip = false;
+			continue;
+		}
+
+		if (d_cmd_pending.empty())	// answer without command
+			continue;
+
+		DTrack2Request req = d_cmd_pending.front();
+		d_cmd_pending.pop_front();
+
+		if (len >= DTRACK_PROT_MAXLEN) {
+			req.result = -4;
+			req.error = ERR_NET;
+		} else {
+			parseDTrack2Answer(ans.c_str(), req);
+		}
+
+		finishDTrack2Request(req);
+		num++;
+	}
+
+	// answer too long: skip rest of it
+	if (d_cmd_buf.length() >= DTRACK_PROT_MAXLEN) {
+		d_cmd_buf = "";
+
+		if (!d_cmd_skip && !d_cmd_pending.empty()) {
+			DTrack2Request req = d_cmd_pending.front();
+			d_cmd_pending.pop_front();
+
+			req.result = -4;
+			req.error = ERR_NET;
+			d_cmd_skip = true;
+
+			finishDTrack2Request(req);
+			num++;
+		} else {
+			d_cmd_skip = true;
+		}
+	}
+
+	return num;
+}
+
+
+/**
+ *	\brief	Process answer of DTrack2 command.
+ *
+ *	@param[in]	ans		answer string
+ *	@param[out]	req		request to store the result in
+ */
+void DTrackSDK::parseDTrack2Answer(const char* ans, DTrack2Request& req)
+{
+	req.answer = "";
+	req.error = ERR_NONE;
+	req.dtrack_error = 0;
+	req.dtrack_error_string = "";
 
 	// check for "dtrack2 ok" / no error
-	if (0 == strcmp(ans, "dtrack2 ok"))
-		return 1;
+	if (0 == strcmp(ans, "dtrack2 ok")) {
+		req.result = 1;
+		return;
+	}
 
 	// got error msg?
 	if (0 == strncmp(ans, "dtrack2 err ", 12)) {
-		char *s = ans + 12;
+		char *s = (char *)ans + 12;
 		int i;
 
 		// parse error code
 		if (!(s = string_get_i((char *)s, &i))) {
-			setLastDTrackError(-1100, "SDK error -1100");
-			lastServerError = ERR_PARSE;
-			return -1100;
+			req.dtrack_error = -1100;
+			req.dtrack_error_string = "SDK error -1100";
+			req.error = ERR_PARSE;
+			req.result = -1100;
+			return;
 		}
-		lastDTrackError = i;
+		req.dtrack_error = i;
 
 		// parse error string
-		if (!(s = string_get_quoted_text((char *)s, lastDTrackErrorString))) {
-			setLastDTrackError(-1100, "SDK error -1100");
-			lastServerError = ERR_PARSE;
-			return -1101;
+		if (!(s = string_get_quoted_text((char *)s, req.dtrack_error_string))) {
+			req.dtrack_error = -1100;
+			req.dtrack_error_string = "SDK error -1100";
+			req.error = ERR_PARSE;
+			req.result = -1101;
+			return;
 		}
 
-		return 2;
+		req.result = 2;
+		return;
 	}
 
 	// not 'dtrack2 ok'/'dtrack2 err ..' -> return msg
-	if (answer)
-		*answer = ans;
+	req.answer = ans;
+	req.result = 0;
+}
 
-	lastServerError = ERR_NONE;
-	return 0;
+
+/**
+ *	\brief	Hand over result of DTrack2 command to its callback or to waitDTrack2Command().
+ *
+ *	@param[in]	req		answered request
+ */
+void DTrackSDK::finishDTrack2Request(DTrack2Request& req)
+{
+	if (req.callback) {
+		lastServerError = req.error;
+		setLastDTrackError(req.dtrack_error, req.dtrack_error_string);
+
+		req.callback(this, req.id, req.result, req.answer, req.userdata);
+	}
+	else
+	if (req.keep) {
+		d_cmd_done[req.id] = req;
+	}
+}
+
+
+/**
+ *	\brief	Finish all DTrack2 commands waiting for their answers with an error.
+ *
+ *	@param[in]	err		result of commands (see sendDTrack2Command())
+ */
+void DTrackSDK::failDTrack2Requests(int err)
+{
+	while (!d_cmd_pending.empty()) {
+		DTrack2Request req = d_cmd_pending.front();
+		d_cmd_pending.pop_front();
+
+		req.result = err;
+		req.error = ERR_NET;
+		finishDTrack2Request(req);
+	}
+}
+
+
+/**
+ *	\brief	Get category and name of a DTrack2 parameter string.
+ *
+ *	@param[in]	parameter	parameter string (e.g. "category name" or "category name value")
+ *	@return	first two words, separated by one space
+ */
+static std::string param_name(const std::string& parameter)
+{
+	std::string name;
+	size_t pos = 0;
+	for (int i = 0; i < 2; i++) {
+		size_t begin = parameter.find_first_not_of(' ', pos);
+		if (begin == std::string::npos)
+			break;
+
+		pos = parameter.find(' ', begin);
+		if (i > 0)
+			name += ' ';
+		name += parameter.substr(begin, pos - begin);
+	}
+	return name;
 }
 
 
 /**
  * 	\brief	Set DTrack2 parameter.
  *
+ *	Removes the parameter from the parameter cache (see setParamCache()).
  *	@param[in] 	category	parameter category
  *	@param[in] 	name		parameter name
  *	@param[in] 	value		parameter value
@@ -1198,11 +3505,22 @@ bool DTrackSDK::setParam(const std::string category, const std::string name, con
 /**
  * 	\brief	Set DTrack2 parameter.
  *
+ *	Removes the parameter from the parameter cache (see setParamCache()).
  * 	@param[in]	parameter	 complete parameter string without starting "dtrack set "
  *	@return		success? (if not, a DTrack error message is available)
  */
 bool DTrackSDK::setParam(const std::string parameter)
 {
+	std::string name = param_name(parameter);
+	std::map<std::string, std::string>::iterator it = d_param_cache.begin();
+	while (it != d_param_cache.end()) {
+		if (param_name(it->first) == name) {
+			d_param_cache.erase(it++);
+		} else {
+			it++;
+		}
+	}
+
 	// send command, 1 means answer "dtrack2 ok"
 	return (1 == sendDTrack2Command("dtrack2 set " + parameter));
 }
@@ -1211,6 +3529,7 @@ bool DTrackSDK::setParam(const std::string parameter)
 /**
  * 	\brief	Get DTrack2 parameter.
  *
+ *	Answered from the parameter cache, if enabled and the parameter is cached (see setParamCache()).
  *	@param[in] 	category	parameter category
  *	@param[in] 	name		parameter name
  *	@param[out]	value		parameter value
@@ -1225,6 +3544,7 @@ bool DTrackSDK::getParam(const std::string category, const std::string name, std
 /**
  * 	\brief	Get DTrack2 parameter.
  *
+ *	Answered from the parameter cache, if enabled and the parameter is cached (see setParamCache()).
  *	@param[in] 	parameter	complete parameter string without starting "dtrack get "
  *	@param[out]	value		parameter value
  *	@return		success? (if not, a DTrack error message is available)
@@ -1235,28 +3555,165 @@ bool DTrackSDK::getParam(const std::string parameter, std::string& value)
 	if (rsType != SYS_DTRACK_2)
 		return false;
 
+	// cached?
+	if (d_param_cache_on) {
+		std::map<std::string, std::string>::iterator it = d_param_cache.find(parameter);
+		if (it != d_param_cache.end()) {
+			setLastDTrackError();
+			value = it->second;
+			return true;
+		}
+	}
+
 	std::string res;
 	// expected answer is "dtrack2 set" -> return value 0
 	if (0 != sendDTrack2Command("dtrack2 get " + parameter, &res))
 		return false;
 
-	// parse parameter from answer
-	if (0 == strncmp(res.c_str(), "dtrack2 set ", 12)) {
-		char *str = strdup(res.c_str() + 12);
-		char *s = str;
-		if (!(s = string_cmp_parameter(s, parameter.c_str()))) {
-			free(str);
-			lastServerError = ERR_PARSE;
-			return false;
+	if (!parseParamAnswer(parameter, res, value))
+		return false;
+
+	if (d_param_cache_on)
+		d_param_cache[parameter] = value;
+
+	return true;
+}
+
+
+/**
+ * 	\brief	Get several DTrack2 parameters at once.
+ *
+ *	All requests are sent without waiting for the answers in between (see sendDTrack2CommandAsync()),
+ *	so this costs about one round trip to DTrack2 instead of one per parameter. Cached parameters
+ *	are not requested again (see setParamCache()).
+ *	@param[in] 	parameters	complete parameter strings without starting "dtrack get " (e.g. "category name")
+ *	@param[out]	values		parameter values in the same order (empty string if not available)
+ *	@return		number of parameters available; if less than requested, a DTrack error message might be available
+ */
+int DTrackSDK::getParams(const std::vector<std::string>& parameters, std::vector<std::string>& values)
+{
+	int n = (int )parameters.size();
+	values.assign(n, "");
+
+	// Params via TCP are not supported in DTrack
+	if (rsType != SYS_DTRACK_2)
+		return 0;
+
+	// send all requests (ids: 0 if cached, <0 if not sent):
+	std::vector<int> ids(n, 0);
+	int num = 0;
+	bool sending = true;
+	for (int i = 0; i < n; i++) {
+		if (d_param_cache_on) {
+			std::map<std::string, std::string>::iterator it = d_param_cache.find(parameters[i]);
+			if (it != d_param_cache.end()) {
+				values[i] = it->second;
+				num++;
+				continue;
+			}
+		}
+
+		ids[i] = -1;
+		if (sending) {
+			ids[i] = sendDTrack2CommandAsync("dtrack2 get " + parameters[i]);
+			sending = (ids[i] > 0);
+		}
+	}
+
+	// collect answers in order of sending:
+	int lastError = 0;
+	std::string lastErrorString;
+	for (int i = 0; i < n; i++) {
+		if (ids[i] <= 0)
+			continue;
+
+		std::string res;
+		int err = waitDTrack2Command(ids[i], &res);
+		if (err == 0 && parseParamAnswer(parameters[i], res, values[i])) {
+			if (d_param_cache_on)
+				d_param_cache[parameters[i]] = values[i];
+
+			num++;
+			continue;
+		}
+
+		if (getLastDTrackError() != 0) {	// keep DTrack error of a failed parameter
+			lastError = getLastDTrackError();
+			lastErrorString = getLastDTrackErrorDescription();
+		}
+
+		if (err == -1) {	// timeout: drop remaining answers
+			for (int j = i; j < n; j++) {
+				for (std::deque<DTrack2Request>::iterator it = d_cmd_pending.begin(); it != d_cmd_pending.end(); it++) {
+					if (it->id == ids[j])
+						it->keep = false;
+				}
+				d_cmd_done.erase(ids[j]);
+			}
+			break;
 		}
+	}
+
+	setLastDTrackError(lastError, lastErrorString);
+	return num;
+}
+
+
+/**
+ * 	\brief	Enable or disable cache for DTrack2 parameters.
+ *
+ *	With cache, getParam() and getParams() ask DTrack2 only once per parameter and afterwards
+ *	return the cached value. setParam() removes the parameter it sets; changes made in another way
+ *	(e.g. parameters adjusted by DTrack2 as a consequence, changes by the DTrack2 frontend or by
+ *	sendDTrack2Command()) need clearParamCache().
+ *	@param[in]	enable	use cache? default is disabled
+ */
+void DTrackSDK::setParamCache(bool enable)
+{
+	d_param_cache_on = enable;
+	if (!enable)
+		d_param_cache.clear();
+}
+
+
+/**
+ * 	\brief	Remove parameters from cache (see setParamCache()).
+ *
+ *	@param[in]	parameter	complete parameter string as used by getParam(); empty string to remove all parameters
+ */
+void DTrackSDK::clearParamCache(const std::string parameter)
+{
+	if (parameter.empty()) {
+		d_param_cache.clear();
+	} else {
+		d_param_cache.erase(parameter);
+	}
+}
+
+
+/**
+ *	\brief	Get value of DTrack2 parameter from answer of "dtrack2 get".
+ *
+ *	@param[in]	parameter	complete parameter string without starting "dtrack get "
+ *	@param[in]	answer		answer of DTrack2
+ *	@param[out]	value		parameter value
+ *	@return	answer contains parameter?
+ */
+bool DTrackSDK::parseParamAnswer(const std::string& parameter, const std::string& answer, std::string& value)
+{
+	// parse parameter from answer "dtrack2 set <parameter> <value>" (string_cmp_parameter() doesn't modify the answer)
+	if (0 != strncmp(answer.c_str(), "dtrack2 set ", 12))
+		return false;
 
-		// assign result
-		value = s;
-		free(str);
-		return true;
+	const char* s = string_cmp_parameter((char *)answer.c_str() + 12, parameter.c_str());
+	if (!s) {
+		lastServerError = ERR_PARSE;
+		return false;
 	}
 
-	return false;
+	// assign result
+	value = s;
+	return true;
 }
 
 
@@ -1325,6 +3782,142 @@ unsigned short DTrackSDK::getDataPort()
 }
 
 
+/**
+ * 	\brief	Get options of the UDP socket receiving tracking data.
+ *
+ *	Returns the values actually applied by the OS, which may differ from the requested ones
+ *	(e.g. receive buffer limited by the system, busy polling or io_uring not supported).
+ *	@param[out]	sockopt		socket options
+ *	@return	UDP socket valid?
+ */
+bool DTrackSDK::getSocketOptions(DTrack_Socket_Options_Type& sockopt)
+{
+	sockopt = d_sockopt;
+	return (d_udpsock != NULL);
+}
+
+
+/**
+ *	\brief	Enable local fan-out of received tracking data.
+ *
+ *	Every packet received from the network is also written into a ring in shared memory, which
+ *	instances in other processes receive from (see DTrackSDK(fanout_name)). Costs one copy and one
+ *	wakeup per packet, independent of the number of consumers; consumers need no syscall as long
+ *	as packets are available. A consumer falling behind by more than num_packets loses packets.
+ *	Consumers of a fan-out left by a terminated instance attach to the new one automatically.
+ *	Not possible while the receiver thread is running.
+ *	@param[in]	name			name of local fan-out (shared memory; replaces an existing one)
+ *	@param[in]	num_packets		number of packets kept in the ring
+ *	@return	fan-out enabled?
+ */
+bool DTrackSDK::enableFanout(const std::string name, int num_packets)
+{
+	if (isReceiverThreadRunning() || !isLocalDataPortValid() || name.empty())
+		return false;
+
+	disableFanout();
+	if (shm_packet_create(&d_fanout, name.c_str(), num_packets, d_udpbufsize)) {
+		d_fanout = NULL;
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ *	\brief	Disable local fan-out.
+ *
+ *	Consumers get timeouts (like without data) until a new fan-out with the same name is enabled,
+ *	they attach to it automatically.
+ *	Not possible while the receiver thread is running.
+ */
+void DTrackSDK::disableFanout()
+{
+	if (isReceiverThreadRunning())
+		return;
+
+	shm_packet_close(d_fanout);
+	d_fanout = NULL;
+}
+
+
+/**
+ * 	\brief	Reserve space for an array of records in a frame in shared memory.
+ *
+ *	@return	offset of array
+ */
+static int shm_reserve(int& size, int num, size_t recsize)
+{
+	int offset = size;
+	size += (int )((num * recsize + SHM_FRAME_ALIGN - 1) / SHM_FRAME_ALIGN * SHM_FRAME_ALIGN);
+	return offset;
+}
+
+
+/**
+ *	\brief	Enable handover of frames through shared memory.
+ *
+ *	Every processed frame is written into a ring of frames with fixed size in shared memory, which
+ *	DTrackFrameReader instances in other processes read from without copying. Costs one copy of the
+ *	records (double) and one wakeup per frame, independent of the number of readers; records
+ *	beyond the limits given by layout are not handed over.
+ *	Not possible while the receiver thread is running.
+ *	@param[in]	name		name of shared memory (replaces an existing one)
+ *	@param[in]	num_frames	number of frames kept in the ring
+ *	@param[in]	layout		max number of records per type (NULL: 32 bodies, 8 Flysticks, 8 measurement tools,
+ *							8 measurement references, 4 hands, 4 human models, 256 markers)
+ *	@return	handover enabled?
+ */
+bool DTrackSDK::enableSharedFrames(const std::string name, int num_frames, const DTrack_Shm_Layout_Type* layout)
+{
+	int size;
+
+	if (isReceiverThreadRunning() || name.empty())
+		return false;
+
+	disableSharedFrames();
+	d_shmlayout = (layout != NULL) ? *layout : SHM_DEFAULT_LAYOUT;
+	if ((d_shmlayout.max_body < 0) || (d_shmlayout.max_flystick < 0) || (d_shmlayout.max_meatool < 0)
+			|| (d_shmlayout.max_mearef < 0) || (d_shmlayout.max_hand < 0) || (d_shmlayout.max_human < 0)
+			|| (d_shmlayout.max_marker < 0))
+		return false;
+
+	memset(&d_shmheader, 0, sizeof(d_shmheader));
+	size = 0;
+	shm_reserve(size, 1, sizeof(DTrack_Shm_Frame_Type));
+	d_shmheader.offset_body = shm_reserve(size, d_shmlayout.max_body, sizeof(DTrack_Body_Type_d));
+	d_shmheader.offset_flystick = shm_reserve(size, d_shmlayout.max_flystick, sizeof(DTrack_FlyStick_Type_d));
+	d_shmheader.offset_meatool = shm_reserve(size, d_shmlayout.max_meatool, sizeof(DTrack_MeaTool_Type_d));
+	d_shmheader.offset_mearef = shm_reserve(size, d_shmlayout.max_mearef, sizeof(DTrack_MeaRef_Type_d));
+	d_shmheader.offset_hand = shm_reserve(size, d_shmlayout.max_hand, sizeof(DTrack_Hand_Type_d));
+	d_shmheader.offset_human = shm_reserve(size, d_shmlayout.max_human, sizeof(DTrack_Human_Type_d));
+	d_shmheader.offset_marker = shm_reserve(size, d_shmlayout.max_marker, sizeof(DTrack_Marker_Type_d));
+
+	if (shm_frame_create(&d_shmframes, name.c_str(), num_frames, size)) {
+		d_shmframes = NULL;
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ *	\brief	Disable handover of frames through shared memory.
+ *
+ *	Readers get timeouts (like without data) until a new handover with the same name is enabled,
+ *	they attach to it automatically.
+ *	Not possible while the receiver thread is running.
+ */
+void DTrackSDK::disableSharedFrames()
+{
+	if (isReceiverThreadRunning())
+		return;
+
+	shm_frame_close(d_shmframes);
+	d_shmframes = NULL;
+}
+
+
 /**
  *	\brief Get origin of last DTrack2 message.
  *
@@ -45,7 +45,7 @@
  *
  * Classes in folder 'Compatibility' provide legacy support for older SDK versions (DTracklib, DTrack, DTrack2).
  *
- * Files in folder 'Lib' provide type definitions, basic UDP/TCP functionality and string parsing.
+ * Files in folder 'Lib' provide type definitions, basic UDP/TCP functionality, string parsing and threading.
  */
 
 #ifndef _ART_DTRACKSDK_HPP_
@@ -54,20 +54,48 @@
 #include "Lib/DTrackDataTypes.h"
 #include "Lib/DTrackNet.h"
 #include "Lib/DTrackParse.hpp"
+#include "Lib/DTrackThread.h"
+#include "Lib/DTrackShm.h"
+#include "Lib/DTrackPose.h"
 
 using namespace DTrackSDK_Datatypes;
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <map>
 
 //! Max message size
 #define DTRACK_PROT_MAXLEN 200
 
+//! Max number of DTrack2 commands sent without waiting for their answers (see sendDTrack2CommandAsync())
+#define DTRACK_CMD_PIPELINE 16
+
+//! Number of packet slots in UDP buffer (queued packets fetched at once)
+#define DTRACK_UDP_SLOTS 8
+
+//! Number of receive buffers registered with io_uring (see DTrack_Socket_Options_Type)
+#define DTRACK_URING_BUFS 64
+
+//! Number of packets kept by local fan-out (default, see enableFanout())
+#define DTRACK_FANOUT_SLOTS 64
+
+//! Number of frames kept in shared memory (default, see enableSharedFrames())
+#define DTRACK_SHM_FRAMES 16
+
+//! Number of histogram classes for intervals between packets (statistics; 4 classes per octave, starting at 1 us)
+#define DTRACK_STAT_HIST_SIZE 80
+
+//! Number of frame counters remembered for frames arrived out of order (statistics; multiple of 32)
+#define DTRACK_STAT_SEEN_SIZE 128
+
 /**
  * 	\brief DTrack SDK main class.
  */
 class DTrackSDK
 {
+	friend class DTrackMultiReceiver;  // receives data of several instances in one thread
+
 public:
 
 	//! Compatibility modes for older SDKs
@@ -85,12 +113,44 @@ public:
 		ERR_PARSE		//!< error while parsing command
 	} Errors;
 
+	//! Record types of tracking data (can be combined, see setParsedRecords())
+	typedef enum {
+		RECORD_BODY     = 0x0001,	//!< standard bodies ('6d', '6dcal')
+		RECORD_FLYSTICK = 0x0002,	//!< Flysticks ('6df', '6df2')
+		RECORD_MEATOOL  = 0x0004,	//!< measurement tools ('6dmt')
+		RECORD_MEAREF   = 0x0008,	//!< measurement references ('6dmtr')
+		RECORD_HAND     = 0x0010,	//!< Fingertracking hands ('gl', 'glcal')
+		RECORD_HUMAN    = 0x0020,	//!< human models ('6dj')
+		RECORD_MARKER   = 0x0040,	//!< single markers ('3d')
+		RECORD_ALL      = 0x007f	//!< all record types (default)
+	} RecordTypes;
+
+	//! Handling of tracking data packets queued since the last receive() (see setDrainPolicy())
+	typedef enum {
+		DRAIN_LATEST = 0,	//!< process newest packet only, drop older ones (default)
+		DRAIN_ALL,			//!< process all packets in order of arrival, one per receive()
+		DRAIN_QUEUE			//!< process packets in order of arrival, but drop all except the newest ones
+	} DrainPolicy;
+
+	/**
+	 *	\brief	Callback for the answer of an asynchronous DTrack2 command (see sendDTrack2CommandAsync()).
+	 *
+	 *	getLastDTrackError() and getLastDTrackErrorDescription() refer to this command while the callback is running.
+	 *	@param[in]	sdk			DTrackSDK instance
+	 *	@param[in]	id			id of command
+	 *	@param[in]	result		result, same as return value of sendDTrack2Command()
+	 *	@param[in]	answer		specific answer (if result is 0), empty otherwise
+	 *	@param[in]	userdata	user data given to sendDTrack2CommandAsync()
+	 */
+	typedef void (*DTrack2CommandCallback)(DTrackSDK* sdk, int id, int result, const std::string& answer, void* userdata);
+
 	/**
 	 * 	\brief	Constructor. Use for listening mode.
 	 *
 	 *	@param[in]	data_port		port number to receive tracking data from DTrack
+	 *	@param[in]	sockopt			options for the UDP socket (see getSocketOptions()); default is OS defaults
 	 */
-	DTrackSDK(unsigned short data_port);
+	DTrackSDK(unsigned short data_port, const DTrack_Socket_Options_Type* sockopt = NULL);
 
 	/**
 	 * 	\brief	Constructor. Use for DTrack2.
@@ -104,12 +164,25 @@ public:
 	 * 	\brief	Constructor. Use for DTrack.
 	 *
 	 * 	This constructor can also be used for DTrack2. In this case server_port must be 50105.
+	 *	With a multicast IP address as server_host and server_port 0 it listens to multicast.
 	 *
 	 *	@param[in]	server_host		hostname or IP address of ARTtrack Controller (empty string if not used)
 	 *	@param[in]	server_port		port number of DTrack
 	 *	@param[in]	data_port		port number to receive tracking data from DTrack
+	 *	@param[in]	sockopt			options for the UDP socket (see getSocketOptions()); default is OS defaults
 	 */
-	DTrackSDK(const std::string server_host, unsigned short server_port, unsigned short data_port);
+	DTrackSDK(const std::string server_host, unsigned short server_port, unsigned short data_port,
+			const DTrack_Socket_Options_Type* sockopt = NULL);
+
+	/**
+	 * 	\brief	Constructor. Use for receiving tracking data from the local fan-out of another instance.
+	 *
+	 *	Tracking data is taken from shared memory instead of a UDP socket (see enableFanout()).
+	 *	Fails if the fan-out doesn't exist (see isLocalDataPortValid()).
+	 *
+	 *	@param[in]	fanout_name		name of local fan-out
+	 */
+	explicit DTrackSDK(const std::string fanout_name);
 
 	/**
 	 * 	\brief	General constructor.
@@ -121,6 +194,7 @@ public:
 	 *	@param[in]	data_bufsize	size of buffer for UDP packets in bytes; default is 32kb (32768 bytes)
 	 *	@param[in]	data_timeout_us	timeout for receiving tracking data in us; default is 1s (1,000,000 us)
 	 *	@param[in]	srv_timeout_us	timeout for reply of ARTtrack Controller in us; default is 10s (10,000,000 us)
+	 *	@param[in]	sockopt			options for the UDP socket (see getSocketOptions()); default is OS defaults
 	 */
 	DTrackSDK(const std::string server_host,
 			unsigned short server_port,
@@ -128,7 +202,8 @@ public:
 			RemoteSystemType remote_type,
 			int data_bufsize = 32768,
 			int data_timeout_us = 1000000,
-			int srv_timeout_us = 10000000
+			int srv_timeout_us = 10000000,
+			const DTrack_Socket_Options_Type* sockopt = NULL
 	);
 
 	/**
@@ -144,6 +219,40 @@ public:
 	 */
 	bool receive();
 
+	/**
+	 *	\brief	Start receiver thread.
+	 *
+	 *	The thread receives and processes tracking data in the background and hands over complete
+	 *	frames through latestFrame(). While the thread is running, receive() fails and the data getters
+	 *	(getFrameCounter(), getBody(), ...) must not be used.
+	 *	@return	thread started? (false if already running or on error)
+	 */
+	bool startReceiverThread();
+
+	/**
+	 *	\brief	Stop receiver thread.
+	 *
+	 *	Waits until the thread has finished (at most 100 ms).
+	 */
+	void stopReceiverThread();
+
+	/**
+	 *	\brief	Is receiver thread running?
+	 *
+	 *	Also true while a DTrackMultiReceiver thread receives data for this instance.
+	 *	@return	thread running?
+	 */
+	bool isReceiverThreadRunning();
+
+	/**
+	 *	\brief	Get latest frame processed by the receiver thread.
+	 *
+	 *	Never blocks. The returned frame stays unchanged until the next call of latestFrame(),
+	 *	it is the same frame as before if no newer one has been processed in the meantime.
+	 *	@return	latest frame, NULL if no frame is available yet
+	 */
+	const DTrack_Frame_Type_d* latestFrame();
+
 	/**
 	 * 	\brief Start measurement.
 	 *
@@ -166,6 +275,66 @@ public:
 	 */
 	unsigned short getDataPort();
 
+	/**
+	 * 	\brief	Get options of the UDP socket receiving tracking data.
+	 *
+	 *	Returns the values actually applied by the OS, which may differ from the requested ones
+	 *	(e.g. receive buffer limited by the system, busy polling or io_uring not supported).
+	 *	@param[out]	sockopt		socket options
+	 *	@return	UDP socket valid?
+	 */
+	bool getSocketOptions(DTrack_Socket_Options_Type& sockopt);
+
+	/**
+	 *	\brief	Enable local fan-out of received tracking data.
+	 *
+	 *	Every packet received from the network is also written into a ring in shared memory, which
+	 *	instances in other processes receive from (see DTrackSDK(fanout_name)). Costs one copy and one
+	 *	wakeup per packet, independent of the number of consumers; consumers need no syscall as long
+	 *	as packets are available. A consumer falling behind by more than num_packets loses packets.
+	 *	Consumers of a fan-out left by a terminated instance attach to the new one automatically.
+	 *	Not possible while the receiver thread is running.
+	 *	@param[in]	name			name of local fan-out (shared memory; replaces an existing one)
+	 *	@param[in]	num_packets		number of packets kept in the ring
+	 *	@return	fan-out enabled?
+	 */
+	bool enableFanout(const std::string name, int num_packets = DTRACK_FANOUT_SLOTS);
+
+	/**
+	 *	\brief	Disable local fan-out.
+	 *
+	 *	Consumers get timeouts (like without data) until a new fan-out with the same name is enabled,
+	 *	they attach to it automatically.
+	 *	Not possible while the receiver thread is running.
+	 */
+	void disableFanout();
+
+	/**
+	 *	\brief	Enable handover of frames through shared memory.
+	 *
+	 *	Every processed frame is written into a ring of frames with fixed size in shared memory, which
+	 *	DTrackFrameReader instances in other processes read from without copying. Costs one copy of the
+	 *	records (double) and one wakeup per frame, independent of the number of readers; records
+	 *	beyond the limits given by layout are not handed over.
+	 *	Not possible while the receiver thread is running.
+	 *	@param[in]	name		name of shared memory (replaces an existing one)
+	 *	@param[in]	num_frames	number of frames kept in the ring
+	 *	@param[in]	layout		max number of records per type (NULL: 32 bodies, 8 Flysticks, 8 measurement tools,
+	 *							8 measurement references, 4 hands, 4 human models, 256 markers)
+	 *	@return	handover enabled?
+	 */
+	bool enableSharedFrames(const std::string name, int num_frames = DTRACK_SHM_FRAMES,
+			const DTrack_Shm_Layout_Type* layout = NULL);
+
+	/**
+	 *	\brief	Disable handover of frames through shared memory.
+	 *
+	 *	Readers get timeouts (like without data) until a new handover with the same name is enabled,
+	 *	they attach to it automatically.
+	 *	Not possible while the receiver thread is running.
+	 */
+	void disableSharedFrames();
+
 	/**
 	 *	\brief Is UDP socket open to receive tracking data on local machine?
 	 *	An open socket is needed to receive data, but does not guarantee this.
@@ -219,6 +388,162 @@ public:
 	 */
 	bool setControllerTimeoutUS(int timeout);
 
+	/**
+	 * 	\brief	Set record types processed by receive().
+	 *
+	 *	Lines of other record types are skipped without being parsed; data of these types is
+	 *	reset and stays empty. Frame counter and timestamp are always processed.
+	 *	Must not be called while the receiver thread is running.
+	 * 	@param[in]	records		record types (combination of RecordTypes); default is RECORD_ALL
+	 */
+	void setParsedRecords(int records);
+
+	/**
+	 * 	\brief	Get record types processed by receive().
+	 *
+	 * 	@return		record types (combination of RecordTypes)
+	 */
+	int getParsedRecords();
+
+	/**
+	 * 	\brief	Set lazy processing of tracking data.
+	 *
+	 *	In lazy mode receive() only stores where the records of each target begin. A record is
+	 *	processed on the first access through getBody(), getHand(), ... in this frame, so data
+	 *	of targets never asked for is not converted at all. Numbers of targets are always known
+	 *	after receive(). Errors inside a record are detected on access: the record is marked as
+	 *	not tracked and getLastDataError() returns ERR_PARSE. Records not accessed before the next
+	 *	receive() are dropped. Default is off.
+	 * 	@param[in]	lazy	process records on first access instead of in receive()?
+	 */
+	void setLazyParsing(bool lazy);
+
+	/**
+	 * 	\brief	Get lazy processing of tracking data.
+	 *
+	 * 	@return		records processed on first access?
+	 */
+	bool isLazyParsing();
+
+	/**
+	 * 	\brief	Set handling of queued tracking data packets.
+	 *
+	 *	DRAIN_LATEST suits applications that only need the current pose: each receive() processes the
+	 *	newest packet, older ones are dropped. DRAIN_ALL processes one packet per receive() in order of
+	 *	arrival without dropping any (packets may still get lost in the network or, if receive() is
+	 *	called too rarely, in the socket buffer). DRAIN_QUEUE works like DRAIN_ALL, but keeps only the
+	 *	newest maxqueue packets, so the lag is limited. Default is DRAIN_LATEST.
+	 *	Must not be called while the receiver thread is running.
+	 * 	@param[in]	policy		handling of queued packets
+	 * 	@param[in]	maxqueue	DRAIN_QUEUE: max number of queued packets, range 1 .. DTRACK_UDP_SLOTS - 1
+	 * 	@return		Success? (i.e. valid maxqueue)
+	 */
+	bool setDrainPolicy(DrainPolicy policy, int maxqueue = DTRACK_UDP_SLOTS - 1);
+
+	/**
+	 * 	\brief	Get handling of queued tracking data packets.
+	 *
+	 * 	@return		handling of queued packets
+	 */
+	DrainPolicy getDrainPolicy();
+
+	/**
+	 * 	\brief	Get number of dropped frames.
+	 *
+	 *	Counts packets received, but dropped according to the drain policy (see setDrainPolicy()).
+	 * 	@return		number of dropped frames since start or resetFrameCounters()
+	 */
+	unsigned int getDroppedFrames();
+
+	/**
+	 * 	\brief	Get number of skipped frames.
+	 *
+	 *	Counts frames missing between two successive frames processed by receive() (gaps in the frame
+	 *	counter). Includes dropped frames (see getDroppedFrames()) as well as frames lost in the network
+	 *	or by the tracking system.
+	 * 	@return		number of skipped frames since start or resetFrameCounters()
+	 */
+	unsigned int getSkippedFrames();
+
+	/**
+	 * 	\brief	Reset numbers of dropped and skipped frames.
+	 */
+	void resetFrameCounters();
+
+	/**
+	 * 	\brief	Get statistics of received tracking data.
+	 *
+	 *	Covers all frames since start or resetStatistics(): errors, gaps and order of the frame counter,
+	 *	intervals between arrival of packets (using receive timestamps, see getReceiveTimeStamp()) and time
+	 *	for processing each record type. In lazy mode (see setLazyParsing()) only the processing in receive()
+	 *	is measured. While the receiver thread is running, use the statistics of latestFrame() instead.
+	 * 	@param[out]	stats	statistics
+	 * 	@return		Success? (i.e. receiver thread not running)
+	 */
+	bool getStatistics(DTrack_Statistics_Type& stats);
+
+	/**
+	 * 	\brief	Reset statistics of received tracking data (including numbers of dropped and skipped frames).
+	 *
+	 *	Must not be called while the receiver thread is running.
+	 */
+	void resetStatistics();
+
+	/**
+	 * 	\brief	Set statistics of intervals between packets and of processing times.
+	 *
+	 *	These statistics read the clock for every packet and every line of a packet. Without them
+	 *	getStatistics() only reports frames, errors, gaps and order of the frame counter.
+	 *	Default is on.
+	 * 	@param[in]	on		measure intervals and processing times?
+	 */
+	void setStatistics(bool on);
+
+	/**
+	 * 	\brief	Get statistics of intervals between packets and of processing times.
+	 *
+	 * 	@return		intervals and processing times measured?
+	 */
+	bool isStatistics();
+
+	/**
+	 * 	\brief	Set float mode.
+	 *
+	 *	In float mode tracking data is processed into the float types (DTrack_Body_Type_f, ...),
+	 *	which are returned by getBodyFloat(), getHandFloat(), ... without conversion. The double
+	 *	getters (getBody(), ...) still work, but convert on every call. Without float mode it is
+	 *	the other way round. Default is off. Only records of the precision in use are kept; those
+	 *	of the other precision are released when switching, and filled by the first conversion.
+	 * 	@param[in]	on		process tracking data as float instead of double?
+	 */
+	void setFloatMode(bool on);
+
+	/**
+	 * 	\brief	Get float mode.
+	 *
+	 * 	@return		tracking data processed as float?
+	 */
+	bool isFloatMode();
+
+	/**
+	 * 	\brief	Set compact poses.
+	 *
+	 *	With compact poses receive() additionally fills poses with unit quaternions in float
+	 *	(DTrack_Body_Pose_Type, ...) for all standard bodies, hands with their fingers and joints of
+	 *	human models, which are returned by getBodyPose(), getHandPose() and getHumanPose() without
+	 *	conversion. In lazy mode (see setLazyParsing()) or without compact poses these getters convert
+	 *	on every call. See DTrackSDK_Pose for conversion and composition of compact poses. Default is off.
+	 * 	@param[in]	on		fill compact poses in receive()?
+	 */
+	void setCompactPoses(bool on);
+
+	/**
+	 * 	\brief	Get compact poses.
+	 *
+	 * 	@return		compact poses filled in receive()?
+	 */
+	bool isCompactPoses();
+
 	/**
 	 * 	\brief	Get last error as error code (data transmission).
 	 *
@@ -261,17 +586,63 @@ public:
 	 *
 	 *	Answers like "dtrack2 ok" and "dtrack2 err .." are processed. Both cases are reflected in
 	 *	the return value. getLastDTrackError() and getLastDTrackErrorDescription() will return more information.
+	 *	Answers of asynchronous commands sent before are processed meanwhile (see sendDTrack2CommandAsync()).
 	 *
 	 * 	@param[in]	command	DTrack2 command string
 	 * 	@param[out]	answer	buffer for answer; NULL if specific answer is not needed
 	 * 	@return	0	specific answer, needs to be parsed
 	 *  @return 1   answer is "dtrack2 ok"
 	 *  @return 2   answer is "dtrack2 err ..". Refer to getLastDTrackError() and getLastDTrackErrorDescription().
-	 * 	@return <0 if error occured (-1 receive timeout, -2 wrong system type, -3 command too long,
+	 * 	@return <0 if error occured (-1 receive timeout, -2 wrong system type, -3 command too long, -4 answer too long,
 	 *  -9 broken tcp connection, -10 tcp connection invalid, -11 send command failed)
 	 */
 	int sendDTrack2Command(const std::string command, std::string *answer = NULL);
 
+	/**
+	 * 	\brief Send DTrack2 command to DTrack without waiting for the answer (TCP command interface).
+	 *
+	 *	Several commands can be sent one after the other (pipelining), DTrack answers them in order.
+	 *	Answers are received by processDTrack2Answers() and waitDTrack2Command(), and handed over
+	 *	either to the callback or, without callback, to waitDTrack2Command(). If DTRACK_CMD_PIPELINE
+	 *	commands are waiting for their answers already, the oldest answer is received first.
+	 *	Commands are not thread-safe, i.e. must be used by one thread only.
+	 *
+	 * 	@param[in]	command		DTrack2 command string
+	 * 	@param[in]	callback	callback for answer; NULL to fetch the answer by waitDTrack2Command()
+	 * 	@param[in]	userdata	user data handed over to the callback
+	 * 	@return	id of command (>0), <0 if error occured (same as sendDTrack2Command())
+	 */
+	int sendDTrack2CommandAsync(const std::string command, DTrack2CommandCallback callback = NULL, void* userdata = NULL);
+
+	/**
+	 * 	\brief Wait for the answer of an asynchronous DTrack2 command.
+	 *
+	 *	Answers of older commands are processed meanwhile, i.e. their callbacks are called.
+	 *	On timeout the command keeps waiting for its answer, so waitDTrack2Command() can be called again.
+	 *
+	 * 	@param[in]	id		id of command sent by sendDTrack2CommandAsync() without callback
+	 * 	@param[out]	answer	buffer for answer; NULL if specific answer is not needed
+	 * 	@return	result, same as return value of sendDTrack2Command() (-12 unknown id)
+	 */
+	int waitDTrack2Command(int id, std::string *answer = NULL);
+
+	/**
+	 * 	\brief Receive answers of asynchronous DTrack2 commands.
+	 *
+	 *	Processes all answers available, calls the callbacks of the answered commands.
+	 *
+	 * 	@param[in]	tout_us		timeout in us to wait for the first answer; default is 0 (no waiting)
+	 * 	@return	number of answered commands, <0 if error occured (-9 broken tcp connection, -10 tcp connection invalid)
+	 */
+	int processDTrack2Answers(int tout_us = 0);
+
+	/**
+	 * 	\brief Get number of asynchronous DTrack2 commands waiting for their answers.
+	 *
+	 * 	@return	number of commands
+	 */
+	int getNumPendingDTrack2Commands();
+
 	/**
 	 * 	\brief	Get frame counter.
 	 *
@@ -288,6 +659,27 @@ public:
 	 */
 	double getTimeStamp();
 
+	/**
+	 * 	\brief	Get receive timestamp.
+	 *
+	 *	Time when the packet of the last received frame arrived. On Linux this is taken by the kernel
+	 *	(SO_TIMESTAMPNS), on other systems when the packet is fetched from the socket.
+	 *	Together with getTimeStamp() it shows the delay caused by the tracking system and the network,
+	 *	if the clocks of both computers are synchronized.
+	 *	@return		receive timestamp in s since 1970-01-01 00:00:00 UTC (-1 if information not available)
+	 */
+	double getReceiveTimeStamp();
+
+	/**
+	 * 	\brief	Get receive latency.
+	 *
+	 *	Time between arrival of the packet (see getReceiveTimeStamp()) and the end of its processing by
+	 *	receive(), i.e. the delay caused by this computer. Records processed later in lazy mode
+	 *	(see setLazyParsing()) are not included.
+	 *	@return		latency in s (-1 if information not available)
+	 */
+	double getReceiveLatency();
+
 	/**
 	 * 	\brief	Get number of calibrated standard bodies (as far as known).
 	 *
@@ -300,11 +692,32 @@ public:
 	 * 	\brief	Get standard body data
 	 *
 	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from float data, if float mode is on (see setFloatMode()).
 	 *	@param[in]	id	id, range 0 .. (max standard body id - 1)
 	 *	@return		id-th standard body data
 	 */
 	DTrack_Body_Type_d* getBody(int id);
 
+	/**
+	 * 	\brief	Get float standard body data
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from double data, if float mode is off (see setFloatMode()).
+	 *	@param[in]	id	id, range 0 .. (max standard body id - 1)
+	 *	@return		id-th standard body data
+	 */
+	DTrack_Body_Type_f* getBodyFloat(int id);
+
+	/**
+	 * 	\brief	Get compact pose of standard body.
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted on every call, if compact poses are off (see setCompactPoses()).
+	 *	@param[in]	id	id, range 0 .. (max standard body id - 1)
+	 *	@return		id-th standard body data
+	 */
+	DTrack_Body_Pose_Type* getBodyPose(int id);
+
 	/**
 	 * 	\brief	Get number of calibrated Flysticks.
 	 *
@@ -317,11 +730,22 @@ public:
 	 * 	\brief	Get Flystick data.
 	 *
 	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from float data, if float mode is on (see setFloatMode()).
 	 *	@param[in]	id	id, range 0 .. (max flystick id - 1)
 	 *	@return		id-th Flystick data.
 	 */
 	DTrack_FlyStick_Type_d* getFlyStick(int id);
 
+	/**
+	 * 	\brief	Get float Flystick data.
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from double data, if float mode is off (see setFloatMode()).
+	 *	@param[in]	id	id, range 0 .. (max flystick id - 1)
+	 *	@return		id-th Flystick data.
+	 */
+	DTrack_FlyStick_Type_f* getFlyStickFloat(int id);
+
 	/**
 	 * 	\brief	Get number of calibrated measurement tools.
 	 *
@@ -334,11 +758,22 @@ public:
 	 * 	\brief	Get measurement tool data.
 	 *
 	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from float data, if float mode is on (see setFloatMode()).
 	 *	@param[in]	id	id, range 0 .. (max tool id - 1)
 	 *	@return		id-th measurement tool data.
 	 */
 	DTrack_MeaTool_Type_d* getMeaTool(int id);
 
+	/**
+	 * 	\brief	Get float measurement tool data.
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from double data, if float mode is off (see setFloatMode()).
+	 *	@param[in]	id	id, range 0 .. (max tool id - 1)
+	 *	@return		id-th measurement tool data.
+	 */
+	DTrack_MeaTool_Type_f* getMeaToolFloat(int id);
+
 	/**
 	 * 	\brief	Get number of calibrated measurement references.
 	 *
@@ -351,11 +786,22 @@ public:
 	 * 	\brief	Get measurement reference data.
 	 *
 	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from float data, if float mode is on (see setFloatMode()).
 	 *	@param[in]	id	id, range 0 .. (max tool id - 1)
 	 *	@return		id-th measurement reference data.
 	 */
 	DTrack_MeaRef_Type_d* getMeaRef(int id);
 
+	/**
+	 * 	\brief	Get float measurement reference data.
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from double data, if float mode is off (see setFloatMode()).
+	 *	@param[in]	id	id, range 0 .. (max tool id - 1)
+	 *	@return		id-th measurement reference data.
+	 */
+	DTrack_MeaRef_Type_f* getMeaRefFloat(int id);
+
 	/**
 	 * 	\brief	Get number of calibrated Fingertracking hands (as far as known).
 	 *
@@ -368,11 +814,32 @@ public:
 	 * 	\brief	Get Fingertracking hand data.
 	 *
 	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from float data, if float mode is on (see setFloatMode()).
 	 *	@param[in]	id	id, range 0 .. (max hand id - 1)
 	 *	@return		id-th Fingertracking hand data
 	 */
 	DTrack_Hand_Type_d* getHand(int id);
 
+	/**
+	 * 	\brief	Get float Fingertracking hand data.
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from double data, if float mode is off (see setFloatMode()).
+	 *	@param[in]	id	id, range 0 .. (max hand id - 1)
+	 *	@return		id-th Fingertracking hand data
+	 */
+	DTrack_Hand_Type_f* getHandFloat(int id);
+
+	/**
+	 * 	\brief	Get compact poses of Fingertracking hand.
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted on every call, if compact poses are off (see setCompactPoses()).
+	 *	@param[in]	id	id, range 0 .. (max hand id - 1)
+	 *	@return		id-th Fingertracking hand data
+	 */
+	DTrack_Hand_Pose_Type* getHandPose(int id);
+
 	/**
 	* 	\brief	Get number of calibrated human models (as far as known).
 	*
@@ -385,11 +852,32 @@ public:
 	* 	\brief	Get human model data
 	*
 	*	Refers to last received frame. Currently not tracked human models get a num_joints 0
+	*	Converted from float data, if float mode is on (see setFloatMode()).
 	*	@param[in]	id	id, range 0 .. (max standard body id - 1)
 	*	@return		id-th human model data
 	*/
 	DTrack_Human_Type* getHuman(int id);
 
+	/**
+	* 	\brief	Get float human model data
+	*
+	*	Refers to last received frame. Currently not tracked human models get a num_joints 0
+	*	Converted from double data, if float mode is off (see setFloatMode()).
+	*	@param[in]	id	id, range 0 .. (max standard body id - 1)
+	*	@return		id-th human model data
+	*/
+	DTrack_Human_Type_f* getHumanFloat(int id);
+
+	/**
+	* 	\brief	Get compact poses of human model joints
+	*
+	*	Refers to last received frame. Currently not tracked human models get a num_joints 0
+	*	Converted on every call, if compact poses are off (see setCompactPoses()).
+	*	@param[in]	id	id, range 0 .. (max standard body id - 1)
+	*	@return		id-th human model data
+	*/
+	DTrack_Human_Pose_Type* getHumanPose(int id);
+
 
 	/**
 	 * 	\brief	Get number of tracked single markers.
@@ -403,14 +891,26 @@ public:
 	 * 	\brief	Get single marker data.
 	 *
 	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from float data, if float mode is on (see setFloatMode()).
 	 *	@param[in]	index	index, range 0 .. (max marker id - 1)
 	 *	@return		i-th single marker data
 	 */
 	DTrack_Marker_Type_d* getMarker(int index);
 
+	/**
+	 * 	\brief	Get float single marker data.
+	 *
+	 *	Refers to last received frame. Currently not tracked bodies get a quality of -1.
+	 *	Converted from double data, if float mode is off (see setFloatMode()).
+	 *	@param[in]	index	index, range 0 .. (max marker id - 1)
+	 *	@return		i-th single marker data
+	 */
+	DTrack_Marker_Type_f* getMarkerFloat(int index);
+
 	/**
 	 * 	\brief	Set DTrack2 parameter.
 	 *
+	 *	Removes the parameter from the parameter cache (see setParamCache()).
 	 *	@param[in] 	category	parameter category
 	 *	@param[in] 	name		parameter name
 	 *	@param[in] 	value		parameter value
@@ -421,6 +921,7 @@ public:
 	/**
 	 * 	\brief	Set DTrack2 parameter.
 	 *
+	 *	Removes the parameter from the parameter cache (see setParamCache()).
 	 * 	@param[in]	parameter	 complete parameter string without starting "dtrack set "
 	 *	@return		success? (if not, a DTrack error message is available)
 	 */
@@ -429,6 +930,7 @@ public:
 	/**
 	 * 	\brief	Get DTrack2 parameter.
 	 *
+	 *	Answered from the parameter cache, if enabled and the parameter is cached (see setParamCache()).
 	 *	@param[in] 	category	parameter category
 	 *	@param[in] 	name		parameter name
 	 *	@param[out]	value		parameter value
@@ -439,12 +941,43 @@ public:
 	/**
 	 * 	\brief	Get DTrack2 parameter.
 	 *
+	 *	Answered from the parameter cache, if enabled and the parameter is cached (see setParamCache()).
 	 *	@param[in] 	parameter	complete parameter string without starting "dtrack get "
 	 *	@param[out]	value		parameter value
 	 *	@return		success? (if not, a DTrack error message is available)
 	 */
 	bool getParam(const std::string parameter, std::string& value);
 
+	/**
+	 * 	\brief	Get several DTrack2 parameters at once.
+	 *
+	 *	All requests are sent without waiting for the answers in between (see sendDTrack2CommandAsync()),
+	 *	so this costs about one round trip to DTrack2 instead of one per parameter. Cached parameters
+	 *	are not requested again (see setParamCache()).
+	 *	@param[in] 	parameters	complete parameter strings without starting "dtrack get " (e.g. "category name")
+	 *	@param[out]	values		parameter values in the same order (empty string if not available)
+	 *	@return		number of parameters available; if less than requested, a DTrack error message might be available
+	 */
+	int getParams(const std::vector<std::string>& parameters, std::vector<std::string>& values);
+
+	/**
+	 * 	\brief	Enable or disable cache for DTrack2 parameters.
+	 *
+	 *	With cache, getParam() and getParams() ask DTrack2 only once per parameter and afterwards
+	 *	return the cached value. setParam() removes the parameter it sets; changes made in another way
+	 *	(e.g. parameters adjusted by DTrack2 as a consequence, changes by the DTrack2 frontend or by
+	 *	sendDTrack2Command()) need clearParamCache().
+	 *	@param[in]	enable	use cache? default is disabled
+	 */
+	void setParamCache(bool enable);
+
+	/**
+	 * 	\brief	Remove parameters from cache (see setParamCache()).
+	 *
+	 *	@param[in]	parameter	complete parameter string as used by getParam(); empty string to remove all parameters
+	 */
+	void clearParamCache(const std::string parameter = "");
+
 	/**
 	 *	\brief	Get DTrack2 message.
 	 *
@@ -489,6 +1022,20 @@ public:
 	std::string getMessageMsg();
 
 private:
+
+	//! Asynchronous DTrack2 command (see sendDTrack2CommandAsync())
+	struct DTrack2Request {
+		int id;                           //!< id of command
+		DTrack2CommandCallback callback;  //!< callback for answer (NULL if fetched by waitDTrack2Command())
+		void* userdata;                   //!< user data for callback
+		bool keep;                        //!< keep result for waitDTrack2Command()?
+		int result;                       //!< result (see sendDTrack2Command())
+		std::string answer;               //!< specific answer (if result is 0)
+		Errors error;                     //!< transmission error
+		int dtrack_error;                 //!< DTrack error: as code
+		std::string dtrack_error_string;  //!< DTrack error: as string
+	};
+
 	/**
 	 * 	\brief Set last dtrack error.
 	 *
@@ -507,12 +1054,272 @@ private:
 	 *	@param[in]	data_bufsize	size of buffer for UDP packets in bytes; default is 32kb (32768 bytes)
 	 *	@param[in]	data_timeout_us	timeout for receiving tracking data in us; default is 1s (1,000,000 us)
 	 *	@param[in]	srv_timeout_us	timeout for reply of ARTtrack Controller in us; default is 10s (10,000,000 us)
+	 *	@param[in]	sockopt			options for the UDP socket, NULL for OS defaults
+	 *	@param[in]	fanout_name		name of local fan-out to receive tracking data from instead of UDP socket (empty string if not used)
 	 */
 	void init(const std::string server_host, unsigned short server_port, unsigned short data_port,
 			RemoteSystemType remote_type, int data_bufsize = 32768,	int data_timeout_us = 1000000,
-			int srv_timeout_us = 10000000
+			int srv_timeout_us = 10000000, const DTrack_Socket_Options_Type* sockopt = NULL,
+			const std::string fanout_name = ""
 	);
 
+	/**
+	 *	\brief	Receive and process one tracking data packet.
+	 *
+	 *	@param[in]	tout_us		timeout for receiving tracking data in us
+	 *	@return	receive succeeded?
+	 */
+	bool receiveData(int tout_us);
+
+	/**
+	 *	\brief	Fetch queued packets into the UDP buffer and choose the next one according to the drain policy.
+	 *
+	 *	@param[in]	tout_us		timeout for receiving tracking data in us
+	 *	@return	slot of packet to be processed; -1 if timeout, -2 if network error occured
+	 */
+	int fetchPacket(int tout_us);
+
+	/**
+	 *	\brief	Receive queued packets into free slots of the UDP buffer.
+	 *
+	 *	@param[in]	slot		first free slot
+	 *	@param[in]	num			number of free slots (without wrapping)
+	 *	@param[in]	tout_us		timeout for receiving tracking data in us
+	 *	@return	number of received packets, <0 if error/timeout occured (see udp_receive_batch())
+	 */
+	int receivePackets(int slot, int num, int tout_us);
+
+	/**
+	 *	\brief	Drop oldest packets of the UDP buffer.
+	 *
+	 *	@param[in]	num		number of packets
+	 */
+	void dropPackets(int num);
+
+	/**
+	 *	\brief	Update statistics with arrival of a new packet.
+	 *
+	 *	@param[in]	rxtime		receive timestamp of packet
+	 */
+	void statPacket(double rxtime);
+
+	/**
+	 *	\brief	Update statistics with frame counter of a new frame.
+	 */
+	void statFrame();
+
+	/**
+	 *	\brief	Update statistics with error of last receive.
+	 */
+	void statError();
+
+	/**
+	 *	\brief	Get statistics of received tracking data (without check for receiver thread).
+	 *
+	 * 	@param[out]	stats	statistics
+	 */
+	void fillStatistics(DTrack_Statistics_Type& stats);
+
+	/**
+	 *	\brief	Reset triple buffer of receiver thread (no frame available).
+	 */
+	void initFrames();
+
+	/**
+	 *	\brief	Main loop of receiver thread.
+	 *
+	 *	@param[in]	arg		DTrackSDK instance
+	 */
+	static void receiverThread(void* arg);
+
+	/**
+	 *	\brief	Copy current tracking data into the triple buffer and hand it over to latestFrame().
+	 */
+	void publishFrame();
+
+	/**
+	 *	\brief	Write current tracking data as next frame into shared memory.
+	 */
+	void writeSharedFrame();
+
+	/**
+	 *	\brief	Receive answers of asynchronous DTrack2 commands and hand them over.
+	 *
+	 *	@param[in]	tout_us		timeout in us to wait for data
+	 *	@return	number of answered commands, <0 if error occured (see sendDTrack2Command())
+	 */
+	int receiveDTrack2Answers(int tout_us);
+
+	/**
+	 *	\brief	Process answer of DTrack2 command.
+	 *
+	 *	@param[in]	ans		answer string
+	 *	@param[out]	req		request to store the result in
+	 */
+	void parseDTrack2Answer(const char* ans, DTrack2Request& req);
+
+	/**
+	 *	\brief	Hand over result of DTrack2 command to its callback or to waitDTrack2Command().
+	 *
+	 *	@param[in]	req		answered request
+	 */
+	void finishDTrack2Request(DTrack2Request& req);
+
+	/**
+	 *	\brief	Finish all DTrack2 commands waiting for their answers with an error.
+	 *
+	 *	@param[in]	err		result of commands (see sendDTrack2Command())
+	 */
+	void failDTrack2Requests(int err);
+
+	/**
+	 *	\brief	Get value of DTrack2 parameter from answer of "dtrack2 get".
+	 *
+	 *	@param[in]	parameter	complete parameter string without starting "dtrack get "
+	 *	@param[in]	answer		answer of DTrack2
+	 *	@param[out]	value		parameter value
+	 *	@return	answer contains parameter?
+	 */
+	bool parseParamAnswer(const std::string& parameter, const std::string& answer, std::string& value);
+
+	/**
+	 *	\brief	Adjust length of vectors for standard bodies, if necessary.
+	 *
+	 *	@param[in]	id	id of standard body
+	 */
+	void resizeBody(int id);
+
+	/**
+	 *	\brief	Adjust length of vectors for Fingertracking hands, if necessary.
+	 *
+	 *	@param[in]	id	id of hand
+	 */
+	void resizeHand(int id);
+
+	/**
+	 *	\brief	Process data of one standard body ('6d' line).
+	 *
+	 *	@param[in]	s		begin of record
+	 *	@param[out]	body	standard body data (double or float)
+	 *	@return	pointer behind record; NULL in case of error
+	 */
+	template<class T> char* parseBody(char* s, std::vector<T>& body);
+
+	/**
+	 *	\brief	Process data of one Flystick ('6df' line, older format).
+	 *
+	 *	@param[in]	s		begin of record
+	 *	@param[out]	fly		Flystick data (double or float)
+	 *	@param[in]	i		index of Flystick
+	 *	@return	pointer behind record; NULL in case of error
+	 */
+	template<class T> char* parseFlyStick1(char* s, T& fly, int i);
+
+	/**
+	 *	\brief	Process data of one Flystick ('6df2' line, newer format).
+	 *
+	 *	@param[in]	s		begin of record
+	 *	@param[out]	fly		Flystick data (double or float)
+	 *	@param[in]	i		index of Flystick
+	 *	@return	pointer behind record; NULL in case of error
+	 */
+	template<class T> char* parseFlyStick2(char* s, T& fly, int i);
+
+	/**
+	 *	\brief	Process data of one measurement tool ('6dmt' line).
+	 *
+	 *	@param[in]	s		begin of record
+	 *	@param[out]	tool	measurement tool data (double or float)
+	 *	@param[in]	i		index of measurement tool
+	 *	@return	pointer behind record; NULL in case of error
+	 */
+	template<class T> char* parseMeaTool(char* s, T& tool, int i);
+
+	/**
+	 *	\brief	Process data of one measurement reference ('6dmtr' line).
+	 *
+	 *	@param[in]	s		begin of record
+	 *	@param[out]	ref		measurement reference data (double or float)
+	 *	@return	pointer behind record; NULL in case of error
+	 */
+	template<class T> char* parseMeaRef(char* s, T& ref);
+
+	/**
+	 *	\brief	Process data of one Fingertracking hand ('gl' line).
+	 *
+	 *	@param[in]	s		begin of record
+	 *	@param[out]	hand	Fingertracking hand data (double or float)
+	 *	@return	pointer behind record; NULL in case of error
+	 */
+	template<class T> char* parseHand(char* s, std::vector<T>& hand);
+
+	/**
+	 *	\brief	Process data of one human model ('6dj' line).
+	 *
+	 *	@param[in]	s		begin of record
+	 *	@param[out]	human	human model data (double or float)
+	 *	@return	pointer behind record; NULL in case of error
+	 */
+	template<class T> char* parseHuman(char* s, std::vector<T>& human);
+
+	/**
+	 *	\brief	Process data of all single markers ('3d' line).
+	 *
+	 *	Number of markers has to be set before.
+	 *	@param[in]	s		begin of first record
+	 *	@param[out]	marker	single marker data (double or float)
+	 *	@return	pointer behind last record; NULL in case of error
+	 */
+	template<class T> char* parseMarkers(char* s, std::vector<T>& marker);
+
+	/**
+	 *	\brief	Discard records of last frame, which have not been processed yet.
+	 */
+	void clearLazyRecords();
+
+	/**
+	 *	\brief	Bring one record up to date with last frame.
+	 *
+	 *	Processes the record, if not done yet (lazy processing). Resets standard bodies, hands and
+	 *	human models, which were not tracked in last frame (old generation).
+	 *	@param[in]	type	record type (one of RecordTypes)
+	 *	@param[in]	i		index of record
+	 */
+	void updateRecord(int type, int i);
+
+	/**
+	 *	\brief	Bring all records up to date with last frame (see updateRecord()).
+	 */
+	void updateRecords();
+
+	/**
+	 *	\brief	Convert one record into the precision not used for processing (see setFloatMode()).
+	 *
+	 *	Sizes the records of this precision for the current frame, if not done yet.
+	 *	@param[in]	type	record type (one of RecordTypes)
+	 *	@param[in]	i		index of record
+	 */
+	void convertRecord(int type, int i);
+
+	/**
+	 *	\brief	Convert all records into the precision not used for processing (see convertRecord()).
+	 */
+	void convertRecords();
+
+	/**
+	 *	\brief	Convert one record into compact poses (see setCompactPoses()).
+	 *
+	 *	Brings the record up to date first (see updateRecord()).
+	 *	@param[in]	type	record type (RECORD_BODY, RECORD_HAND or RECORD_HUMAN)
+	 *	@param[in]	i		index of record
+	 */
+	void convertPose(int type, int i);
+
+	/**
+	 *	\brief	Convert all standard bodies, hands and human models into compact poses (see convertPose()).
+	 */
+	void convertPoses();
+
 	RemoteSystemType rsType;	//!< Remote system type
 	Errors lastDataError;		//!< last transmission error (tracking data)
 	Errors lastServerError;     //!< last transmission error (commands)
@@ -522,36 +1329,105 @@ private:
 
 	void* d_tcpsock;                //!< socket number for TCP
 	int d_tcptimeout_us;            //!< timeout for receiving and sending TCP data
+	std::deque<DTrack2Request> d_cmd_pending;  //!< DTrack2 commands waiting for their answers (in order of sending)
+	std::map<int, DTrack2Request> d_cmd_done;  //!< answered DTrack2 commands, result not fetched by waitDTrack2Command() yet
+	std::string d_cmd_buf;          //!< received TCP data not completing an answer yet
+	int d_cmd_id;                   //!< id of last DTrack2 command sent by sendDTrack2CommandAsync()
+	bool d_cmd_skip;                //!< received TCP data belongs to an answer that was too long?
+	bool d_param_cache_on;          //!< use cache for DTrack2 parameters?
+	std::map<std::string, std::string> d_param_cache;  //!< cached DTrack2 parameters (parameter string to value)
 
 	void* d_udpsock;                //!< socket number for UDP
 	unsigned int d_remote_ip;       //!< IP address for remote access
 	unsigned short d_udpport;		//!< port number for UDP
+	DTrack_Socket_Options_Type d_sockopt;  //!< options of UDP socket (as applied by the OS)
+	void* d_fanout;                 //!< local fan-out of received packets (NULL if not enabled)
+	void* d_fanin;                  //!< local fan-out of another instance to receive from (NULL if not attached)
+	std::string d_fanin_name;       //!< name of local fan-out to receive from (empty if UDP socket is used)
+	void* d_shmframes;              //!< ring of frames in shared memory (NULL if not enabled)
+	DTrack_Shm_Layout_Type d_shmlayout;  //!< frames in shared memory: max number of records
+	DTrack_Shm_Frame_Type d_shmheader;   //!< frames in shared memory: header with offsets of records
 	unsigned short d_remoteport;	//!< port number for UDP (remote) / TCP
 	int d_udptimeout_us;        	//!< timeout for receiving UDP data
-
-	int d_udpbufsize;               //!< size of UDP buffer
-	char* d_udpbuf;                 //!< UDP buffer
+	int d_records;                  //!< record types processed by receive()
+	bool d_lazy;                    //!< lazy processing of records?
+	bool d_float;                   //!< processing of records as float (act_*_f) instead of double?
+	bool d_poses;                   //!< fill compact poses (act_*_pose) in receive()?
+
+	int d_udpbufsize;               //!< size of UDP buffer (per slot)
+	char* d_udpbuf;                 //!< UDP buffer (DTRACK_UDP_SLOTS slots)
+	int d_udplen[DTRACK_UDP_SLOTS]; //!< length of received packet per slot
+	double d_udprxtime[DTRACK_UDP_SLOTS]; //!< receive timestamp of packet per slot
+	int d_udphead;                  //!< slot of oldest packet not processed yet (slots are used as ring buffer)
+	int d_udpcount;                 //!< number of packets not processed yet
+	DrainPolicy d_drain;            //!< handling of queued packets
+	int d_drain_queue;              //!< max number of queued packets (1 if not DRAIN_QUEUE)
+	unsigned int d_last_framecounter; //!< highest frame counter processed so far (0 if not available)
+
+	DTrack_Statistics_Type d_stat;  //!< statistics (without interval_mean and interval_p99)
+	double d_stat_interval_sum;     //!< statistics: sum of intervals between packets
+	double d_stat_last_rxtime;      //!< statistics: receive timestamp of last packet (-1 if not available)
+	unsigned int d_stat_hist[DTRACK_STAT_HIST_SIZE];  //!< statistics: histogram of intervals between packets
+	unsigned int d_stat_seen[DTRACK_STAT_SEEN_SIZE / 32];  //!< statistics: frames received, one bit per frame counter (modulo DTRACK_STAT_SEEN_SIZE)
+	bool d_stat_on;                 //!< statistics: measure intervals between packets and processing times?
+	std::vector<int> d_linestart;   //!< offsets of lines in processed packet
 
 	unsigned int act_framecounter;                    //!< frame counter
 	double act_timestamp;                             //!< timestamp (-1, if information not available)
+	double act_rxtimestamp;                           //!< receive timestamp (-1, if information not available)
+	double act_latency;                               //!< time from packet arrival until end of processing (-1, if information not available)
 	int act_num_body;                                 //!< number of calibrated standard bodies (as far as known)
 	std::vector<DTrack_Body_Type_d> act_body;         //!< array containing standard body data
+	std::vector<DTrack_Body_Type_f> act_body_f;       //!< same data as float (only filled on demand, see setFloatMode())
+	std::vector<DTrack_Body_Pose_Type> act_body_pose; //!< same data as compact poses (see setCompactPoses())
+	std::vector<unsigned int> act_body_gen;           //!< generation of standard body data (tracked, if equal to d_body_gen)
+	unsigned int d_body_gen;                          //!< current generation of standard body data (new with every '6d' line)
 	int act_num_flystick;                             //!< number of calibrated Flysticks
 	std::vector<DTrack_FlyStick_Type_d> act_flystick; //!< array containing Flystick data
+	std::vector<DTrack_FlyStick_Type_f> act_flystick_f; //!< same data as float (only filled on demand, see setFloatMode())
 	int act_num_meatool;                              //!< number of calibrated measurement tools
 	std::vector<DTrack_MeaTool_Type_d> act_meatool;   //!< array containing measurement tool data
+	std::vector<DTrack_MeaTool_Type_f> act_meatool_f; //!< same data as float (only filled on demand, see setFloatMode())
 	int act_num_mearef;                               //!< number of calibrated measurement references
 	std::vector<DTrack_MeaRef_Type_d> act_mearef;     //!< array containing measurement reference data
+	std::vector<DTrack_MeaRef_Type_f> act_mearef_f;   //!< same data as float (only filled on demand, see setFloatMode())
 	int act_num_hand;                                 //!< number of calibrated Fingertracking hands (as far as known)
 	std::vector<DTrack_Hand_Type_d> act_hand;         //!< array containing Fingertracking hands data
+	std::vector<DTrack_Hand_Type_f> act_hand_f;       //!< same data as float (only filled on demand, see setFloatMode())
+	std::vector<DTrack_Hand_Pose_Type> act_hand_pose; //!< same data as compact poses (see setCompactPoses())
+	std::vector<unsigned int> act_hand_gen;           //!< generation of Fingertracking hands data (tracked, if equal to d_hand_gen)
+	unsigned int d_hand_gen;                          //!< current generation of Fingertracking hands data (new with every 'gl' line)
 	
 	//////////////////////////////////////////////////////////////////////////
 	//////////////////////////////////////////////////////////////////////////
 	int act_num_human;																//!< number of calibrated human models
 	std::vector<DTrack_Human_Type> act_human;					//!< array containing human model data
+	std::vector<DTrack_Human_Type_f> act_human_f;     //!< same data as float (only filled on demand, see setFloatMode())
+	std::vector<DTrack_Human_Pose_Type> act_human_pose; //!< same data as compact poses (see setCompactPoses())
+	std::vector<unsigned int> act_human_gen;          //!< generation of human model data (tracked, if equal to d_human_gen)
+	unsigned int d_human_gen;                         //!< current generation of human model data (new with every '6dj' line)
 
 	int act_num_marker;                               //!< number of tracked single markers
 	std::vector<DTrack_Marker_Type_d> act_marker;     //!< array containing single marker data
+	std::vector<DTrack_Marker_Type_f> act_marker_f;   //!< same data as float (only filled on demand, see setFloatMode())
+
+	std::vector<char*> d_lazy_body;      //!< lazy processing: begin of standard body records not processed yet
+	std::vector<char*> d_lazy_flystick;  //!< lazy processing: begin of Flystick records not processed yet
+	bool d_lazy_flystick2;               //!< lazy processing: Flystick records in newer format ('6df2')?
+	std::vector<char*> d_lazy_meatool;   //!< lazy processing: begin of measurement tool records not processed yet
+	std::vector<char*> d_lazy_mearef;    //!< lazy processing: begin of measurement reference records not processed yet
+	std::vector<char*> d_lazy_hand;      //!< lazy processing: begin of Fingertracking hand records not processed yet
+	std::vector<char*> d_lazy_human;     //!< lazy processing: begin of human model records not processed yet
+	char* d_lazy_marker;                 //!< lazy processing: begin of single marker data not processed yet
+
+	void* d_thread;                   //!< receiver thread (NULL if not running)
+	bool d_thread_external;           //!< receiver thread of a DTrackMultiReceiver is running for this instance?
+	volatile int d_thread_run;        //!< receiver thread: keep running?
+	DTrack_Frame_Type_d d_frame[3];   //!< receiver thread: triple buffer for frame handover
+	volatile int d_frame_middle;      //!< receiver thread: index of frame ready for handover (and flag for new frame)
+	int d_frame_back;                 //!< receiver thread: index of frame written by thread
+	int d_frame_front;                //!< receiver thread: index of frame read by latestFrame()
+	bool d_frame_valid;               //!< receiver thread: latestFrame() has got a frame
 
 	std::string d_message_origin;     //!< last DTrack2 message: origin of message
 	std::string d_message_status;     //!< last DTrack2 message: status of message
@@ -291,6 +291,176 @@ typedef struct{
 
 typedef DTrack_Human_Type_d DTrack_Human_Type;
 
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Compact pose (6DOF, float)
+ *
+ *	Orientation as unit quaternion instead of rotation matrix, see DTrackSDK::setCompactPoses().
+ */
+typedef struct{
+	float loc[3];    //!< location (in mm)
+	float quat[4];   //!< orientation as unit quaternion (order: w, x, y, z)
+} DTrack_Pose_Type_f;
+
+/**
+ * 	\brief	Standard body data (compact pose)
+ *
+ *	Currently not tracked bodies get a quality of -1 and the identity pose.
+ */
+typedef struct{
+	int id;                   //!< id number (starting with 0)
+	float quality;            //!< quality (0 <= qu <= 1, no tracking if -1)
+	DTrack_Pose_Type_f pose;  //!< pose
+} DTrack_Body_Pose_Type;
+
+/**
+ *	\brief	A.R.T.Fingertracking hand data (compact poses of back of the hand and fingers)
+ *
+ *	Currently not tracked hands get a quality of -1 and identity poses. Phalanxes are available
+ *	through DTrackSDK::getHand().
+ */
+typedef struct{
+	int id;                   //!< id number (starting with 0)
+	float quality;            //!< quality (0 <= qu <= 1, no tracking if -1)
+	int lr;                   //!< left (0) or right (1) hand
+	int nfinger;              //!< number of fingers (maximum 5)
+	DTrack_Pose_Type_f pose;  //!< back of the hand: pose
+	DTrack_Pose_Type_f finger[DTRACK_HAND_MAX_FINGER];  //!< pose of fingers (in hand coordinate system)
+} DTrack_Hand_Pose_Type;
+
+/**
+ * 	\brief	A.R.T human model (compact poses of joints)
+ *
+ * 	Currently not tracked human models get a num_joints 0.
+ */
+typedef struct{
+	int id;         //!< id of the human model (starting with 0)
+	int num_joints; //!< number of joints of the human model
+	struct {
+		int id;                   //!< id of the joint (starting with 0)
+		float quality;            //!< quality of the joint (0 <= qu <= 1, no tracking if -1)
+		DTrack_Pose_Type_f pose;  //!< pose of the joint (in room coordinate system)
+	} joint[DTRACK_HUMAN_MAX_JOINTS]; //!< poses of the joints
+} DTrack_Human_Pose_Type;
+
+// -----------------------------------------------------------------------------------------------------
+
+#define DTRACK_STAT_RECORDS 7  //!< Statistics: number of record types (standard body, Flystick, measurement tool, measurement reference, hand, human model, marker)
+
+/**
+ * 	\brief	Statistics of received tracking data
+ *
+ *	See DTrackSDK::getStatistics().
+ */
+typedef struct{
+	unsigned int frames;         //!< number of processed frames
+	unsigned int err_timeout;    //!< number of timeouts while waiting for data
+	unsigned int err_net;        //!< number of network errors
+	unsigned int err_parse;      //!< number of errors while parsing data
+	unsigned int dropped;        //!< number of frames dropped according to the drain policy
+	unsigned int skipped;        //!< number of frames missing in the frame counter (including dropped ones)
+	unsigned int gaps;           //!< number of gaps in the frame counter
+	unsigned int reordered;      //!< number of frames arrived out of order (older than the previous frame)
+	unsigned int duplicates;     //!< number of frames arrived twice
+	unsigned int intervals;      //!< number of measured intervals between arrival of two packets
+	double interval_min;         //!< min interval between arrival of two packets (in s; -1 if not available)
+	double interval_mean;        //!< mean interval (in s; -1 if not available)
+	double interval_p99;         //!< 99th percentile of intervals (in s, resolution about 20%; -1 if not available)
+	double interval_max;         //!< max interval (in s; -1 if not available)
+	unsigned int parse_count[DTRACK_STAT_RECORDS];  //!< number of processed lines per record type
+	double parse_time[DTRACK_STAT_RECORDS];         //!< total time for processing these lines per record type (in s)
+} DTrack_Statistics_Type;
+
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Options for the UDP socket receiving tracking data
+ *
+ *	Set options not needed to 0 (OS default). After creation of the socket the SDK reports the
+ *	values the OS actually applied, see DTrackSDK::getSocketOptions().
+ */
+typedef struct{
+	int rcvbuf;                 //!< size of socket receive buffer (SO_RCVBUF, in bytes; Linux reports twice the requested size)
+	int busy_poll_us;           //!< time for busy polling of the network device while waiting for data (SO_BUSY_POLL, Linux only; in us)
+	unsigned int multicast_if;  //!< IP address of local interface to receive multicast data (see DTrackSDK_Net::ip_name2ip())
+	int reuse_port;             //!< allow several sockets on the same port? (SO_REUSEPORT, if not available SO_REUSEADDR)
+	int io_uring;               //!< receive through io_uring? (Linux 6.0 or newer, otherwise receiving as without)
+} DTrack_Socket_Options_Type;
+
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Complete tracking data of one frame (double)
+ *
+ *	Used to hand over frames from the receiver thread, see DTrackSDK::latestFrame().
+ */
+typedef struct{
+	unsigned int framecounter;                      //!< frame counter
+	double timestamp;                               //!< timestamp (-1, if information not available)
+	double rxtimestamp;                             //!< receive timestamp (see DTrackSDK::getReceiveTimeStamp())
+	double latency;                                 //!< time from packet arrival until frame was handed over (in s)
+	int num_body;                                   //!< number of calibrated standard bodies (as far as known)
+	std::vector<DTrack_Body_Type_d> body;           //!< standard body data
+	int num_flystick;                               //!< number of calibrated Flysticks
+	std::vector<DTrack_FlyStick_Type_d> flystick;   //!< Flystick data
+	int num_meatool;                                //!< number of calibrated measurement tools
+	std::vector<DTrack_MeaTool_Type_d> meatool;     //!< measurement tool data
+	int num_mearef;                                 //!< number of calibrated measurement references
+	std::vector<DTrack_MeaRef_Type_d> mearef;       //!< measurement reference data
+	int num_hand;                                   //!< number of calibrated Fingertracking hands (as far as known)
+	std::vector<DTrack_Hand_Type_d> hand;           //!< Fingertracking hand data
+	int num_human;                                  //!< number of calibrated human models
+	std::vector<DTrack_Human_Type_d> human;         //!< human model data
+	int num_marker;                                 //!< number of tracked single markers
+	std::vector<DTrack_Marker_Type_d> marker;       //!< single marker data
+	DTrack_Statistics_Type statistics;              //!< statistics of received tracking data, up to this frame
+} DTrack_Frame_Type_d;
+
+// -----------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Max number of records of frames in shared memory
+ *
+ *	Frames in shared memory have a fixed size, further records are not handed over.
+ *	See DTrackSDK::enableSharedFrames().
+ */
+typedef struct{
+	int max_body;      //!< max number of standard bodies
+	int max_flystick;  //!< max number of Flysticks
+	int max_meatool;   //!< max number of measurement tools
+	int max_mearef;    //!< max number of measurement references
+	int max_hand;      //!< max number of Fingertracking hands
+	int max_human;     //!< max number of human models
+	int max_marker;    //!< max number of single markers
+} DTrack_Shm_Layout_Type;
+
+/**
+ * 	\brief	Header of a frame in shared memory
+ *
+ *	Followed by fixed-size arrays of records (double) of each type, their offsets are given
+ *	relative to the begin of the header. See DTrackFrameReader.
+ */
+typedef struct{
+	unsigned int framecounter;  //!< frame counter
+	double timestamp;           //!< timestamp (-1, if information not available)
+	double rxtimestamp;         //!< receive timestamp (see DTrackSDK::getReceiveTimeStamp())
+	int num_body;               //!< number of standard bodies (limited to DTrack_Shm_Layout_Type::max_body)
+	int offset_body;            //!< offset of standard body data (DTrack_Body_Type_d)
+	int num_flystick;           //!< number of Flysticks (limited)
+	int offset_flystick;        //!< offset of Flystick data (DTrack_FlyStick_Type_d)
+	int num_meatool;            //!< number of measurement tools (limited)
+	int offset_meatool;         //!< offset of measurement tool data (DTrack_MeaTool_Type_d)
+	int num_mearef;             //!< number of measurement references (limited)
+	int offset_mearef;          //!< offset of measurement reference data (DTrack_MeaRef_Type_d)
+	int num_hand;               //!< number of Fingertracking hands (limited)
+	int offset_hand;            //!< offset of Fingertracking hand data (DTrack_Hand_Type_d)
+	int num_human;              //!< number of human models (limited)
+	int offset_human;           //!< offset of human model data (DTrack_Human_Type_d)
+	int num_marker;             //!< number of single markers (limited)
+	int offset_marker;          //!< offset of single marker data (DTrack_Marker_Type_d)
+} DTrack_Shm_Frame_Type;
+
 }
 
 #endif /* ART_DTRACK_DATATYPES_H_ */
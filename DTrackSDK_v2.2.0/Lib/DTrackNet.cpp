@@ -26,6 +26,56 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
+#ifdef OS_LINUX
+	#include <string.h>
+	#include <errno.h>
+	#include <sys/epoll.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#ifdef __NR_io_uring_setup
+		#include <linux/io_uring.h>
+	#endif
+	#if defined(IORING_RECV_MULTISHOT) && defined(IORING_FEAT_EXT_ARG)
+		#define NET_IO_URING  // kernel headers support receiving through io_uring (kernel itself is checked at runtime)
+		#include <pthread.h>
+	#endif
+#endif
+
+#define NET_MAX_SLOT  64  // maximum number of packets received by one call of udp_receive_batch()
+#define NET_MAX_POLL  64  // maximum number of sockets reported by one call of udp_poll_wait() (select(): per poll set)
+
+#ifdef NET_IO_URING
+// internal io_uring type (receives UDP packets by multishot recvmsg into provided buffers)
+struct _ip_uring_struct {
+	int fd;							// io_uring instance
+	char* sqmem;					// submission queue ring (mapped)
+	size_t sqmemlen;
+	char* cqmem;					// completion queue ring (mapped)
+	size_t cqmemlen;
+	struct io_uring_sqe* sqes;		// submission queue entries (mapped)
+	size_t sqeslen;
+	unsigned int* sq_tail;
+	unsigned int* sq_mask;
+	unsigned int* sq_flags;			// IORING_SQ_TASKRUN: completions wait for the receiving thread to enter the kernel
+	unsigned int* sq_array;
+	unsigned int* cq_head;
+	unsigned int* cq_tail;
+	unsigned int* cq_mask;
+	struct io_uring_cqe* cqes;
+	struct io_uring_buf_ring* br;	// ring of provided buffers (mapped)
+	size_t brlen;
+	unsigned short br_tail;			// next entry of ring of provided buffers
+	char* buf;						// provided buffers
+	int nbuf;						// number of buffers (power of 2)
+	int buflen;						// length of one buffer (recvmsg header, control data, packet)
+	int slotlen;					// max length of packet
+	struct msghdr msg;				// layout of received messages (no address, control data for timestamp)
+	int armed;						// multishot recvmsg active?
+	unsigned long long gen;			// user data of active multishot recvmsg (completions of older ones are only drained)
+	pthread_t owner;				// thread which submitted the active multishot recvmsg (completes its packets)
+};
+#endif
 
 // internal socket type
 struct _ip_socket_struct {
@@ -35,8 +85,28 @@ struct _ip_socket_struct {
 #ifdef OS_WIN
 	SOCKET ossock;	// Windows Socket
 #endif
+#ifdef NET_IO_URING
+	struct _ip_uring_struct* ring;  // receiving through io_uring (NULL if not used)
+#endif
 };
 
+// internal poll set type
+struct _ip_poll_struct {
+#ifdef OS_LINUX
+	int epfd;		// epoll instance
+#else
+	int num;		// number of sockets
+	struct _ip_socket_struct* sock[NET_MAX_POLL];  // sockets
+	int id[NET_MAX_POLL];  // ids of sockets
+#endif
+#ifdef NET_IO_URING
+	int nring;		// number of sockets receiving through io_uring
+	struct _ip_socket_struct* ring[NET_MAX_POLL];  // sockets receiving through io_uring (armed by udp_poll_wait())
+#endif
+};
+
+using namespace DTrackSDK_Datatypes;
+
 namespace DTrackSDK_Net {
 
 /**
@@ -93,19 +163,558 @@ unsigned int ip_name2ip(const char* name)
 }
 
 
+/**
+ * 	\brief	Get current time.
+ *
+ *	Same clock as used for receive timestamps of UDP packets (see udp_receive()).
+ *	@return		time in s since 1970-01-01 00:00:00 UTC
+ */
+double net_time(void)
+{
+#ifdef OS_UNIX
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+#ifdef OS_WIN
+	FILETIME ft;
+	ULARGE_INTEGER t;
+	GetSystemTimeAsFileTime(&ft);  // in 100 ns since 1601-01-01
+	t.LowPart = ft.dwLowDateTime;
+	t.HighPart = ft.dwHighDateTime;
+	return (t.QuadPart - 116444736000000000ULL) * 1e-7;
+#endif
+}
+
+
+/**
+ * 	\brief	Get monotonic time with high resolution.
+ *
+ *	Suitable for measuring short durations, not related to calendar time.
+ *	@return		time in s since an arbitrary point in time
+ */
+double net_clock(void)
+{
+#ifdef OS_UNIX
+#ifdef CLOCK_MONOTONIC
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+	return net_time();
+#endif
+#endif
+#ifdef OS_WIN
+	LARGE_INTEGER count, freq;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&freq);
+	return (double )count.QuadPart / freq.QuadPart;
+#endif
+}
+
+
 // ---------------------------------------------------------------------------------------------------
 // Handling UDP data:
 // ---------------------------------------------------------------------------------------------------
 
+#ifdef OS_LINUX
+/**
+ * 	\brief	Get receive timestamp of a packet.
+ *
+ *	@param[in]	msg		received message, including control data
+ *	@return	kernel timestamp (SO_TIMESTAMPNS) if available, otherwise current time
+ */
+static double msg_rxtime(struct msghdr* msg)
+{
+	struct cmsghdr* cmsg;
+	struct timespec ts;
+	for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg))
+	{
+		if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPNS))
+		{
+			memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+			return ts.tv_sec + ts.tv_nsec * 1e-9;
+		}
+	}
+	return net_time();
+}
+#endif
+
+#ifdef NET_IO_URING
+/**
+ * 	\brief	Release io_uring instance.
+ *
+ *	@param[in]	u	io_uring instance (may be incomplete)
+ */
+static void uring_free(struct _ip_uring_struct* u)
+{
+	if (u == NULL)
+	{
+		return;
+	}
+	if (u->fd >= 0)
+	{
+		close(u->fd);  // also unregisters the provided buffers
+	}
+	if (u->sqmem != NULL)
+	{
+		munmap(u->sqmem, u->sqmemlen);
+	}
+	if (u->cqmem != NULL)
+	{
+		munmap(u->cqmem, u->cqmemlen);
+	}
+	if (u->sqes != NULL)
+	{
+		munmap(u->sqes, u->sqeslen);
+	}
+	if (u->br != NULL)
+	{
+		munmap(u->br, u->brlen);
+	}
+	free(u->buf);
+	free(u);
+}
+
+
+/**
+ * 	\brief	Hand buffer (back) to the kernel.
+ *
+ *	@param[in]	u	io_uring instance
+ *	@param[in]	bid	id of buffer
+ */
+static void uring_provide(struct _ip_uring_struct* u, int bid)
+{
+	// entries start at the begin of the ring (bufs[] of io_uring_buf_ring is misplaced by C++ compilers)
+	struct io_uring_buf* b = (struct io_uring_buf* )u->br + (u->br_tail & (u->nbuf - 1));
+	b->addr = (unsigned long long )(size_t )(u->buf + (size_t )bid * u->buflen);
+	b->len = u->buflen;
+	b->bid = (unsigned short )bid;
+	u->br_tail++;
+	__atomic_store_n(&u->br->tail, u->br_tail, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * 	\brief	Get next free submission queue entry.
+ *
+ *	@param[in]	u	io_uring instance
+ *	@param[in]	num	number of entries already taken for the next submission
+ *	@return	cleared entry
+ */
+static struct io_uring_sqe* uring_sqe(struct _ip_uring_struct* u, unsigned int num)
+{
+	unsigned int idx = (*u->sq_tail + num) & *u->sq_mask;
+	u->sq_array[idx] = idx;
+	memset(&u->sqes[idx], 0, sizeof(struct io_uring_sqe));
+	return &u->sqes[idx];
+}
+
+
+/**
+ * 	\brief	Submit multishot recvmsg.
+ *
+ *	One submission receives packets until it is terminated by the kernel (e.g. no buffer left).
+ *	Completions are processed by the kernel in the context of the submitting thread, so it is only
+ *	submitted by the thread fetching the packets; an active recvmsg of another thread (e.g. when
+ *	the application switches its receiving thread) is cancelled.
+ *	@param[in]	u		io_uring instance
+ *	@param[in]	sock	UDP socket
+ *	@return	0 if ok, <0 if error occured
+ */
+static int uring_arm(struct _ip_uring_struct* u, int sock)
+{
+	struct io_uring_sqe* sqe;
+	unsigned int num = 0;
+	if (u->armed)
+	{	// cancel recvmsg of other thread
+		sqe = uring_sqe(u, num++);
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = u->gen;
+		sqe->user_data = 0;
+	}
+	sqe = uring_sqe(u, num++);
+	sqe->opcode = IORING_OP_RECVMSG;
+	sqe->fd = sock;
+	sqe->addr = (unsigned long long )(size_t )&u->msg;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = 0;
+	sqe->user_data = u->gen + 1;
+	__atomic_store_n(u->sq_tail, *u->sq_tail + num, __ATOMIC_RELEASE);
+	if (syscall(__NR_io_uring_enter, u->fd, num, 0, 0, NULL, 0) != (long )num)
+	{
+		return -2;
+	}
+	u->gen++;
+	u->owner = pthread_self();
+	u->armed = 1;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Cancel multishot recvmsg.
+ *
+ *	Returns after the kernel has completed the cancellation, completions of the cancelled recvmsg
+ *	are only drained afterwards.
+ *	@param[in]	u		io_uring instance
+ *	@return	0 if ok, <0 if error occured
+ */
+static int uring_cancel(struct _ip_uring_struct* u)
+{
+	struct io_uring_sqe* sqe;
+	sqe = uring_sqe(u, 0);
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = u->gen;
+	sqe->user_data = 0;
+	__atomic_store_n(u->sq_tail, *u->sq_tail + 1, __ATOMIC_RELEASE);
+	if (syscall(__NR_io_uring_enter, u->fd, 1, 1, IORING_ENTER_GETEVENTS, NULL, 0) != 1)
+	{
+		return -2;
+	}
+	u->gen++;
+	u->armed = 0;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Make sure the multishot recvmsg is submitted by the calling thread.
+ *
+ *	@param[in]	u		io_uring instance
+ *	@param[in]	sock	UDP socket
+ *	@return	0 if ok, <0 if error occured
+ */
+static int uring_prepare(struct _ip_uring_struct* u, int sock)
+{
+	if (u->armed && pthread_equal(u->owner, pthread_self()))
+	{
+		return 0;
+	}
+	return uring_arm(u, sock);
+}
+
+
+/**
+ * 	\brief	Create io_uring instance receiving from a UDP socket.
+ *
+ *	Needs Linux 6.0 (multishot recvmsg, ring of provided buffers); older kernels return an error.
+ *	Receiving starts with the first receive in the thread fetching the packets (see uring_arm()),
+ *	which gets the completions without being interrupted (IORING_SETUP_COOP_TASKRUN).
+ *	@param[out]	ring	io_uring instance
+ *	@param[in]	sock	UDP socket
+ *	@param[in]	nbuf	number of buffers (rounded up to power of 2)
+ *	@param[in]	slotlen	max length of packet
+ *	@return	0 if ok, <0 if error occured
+ */
+static int uring_init(struct _ip_uring_struct** ring, int sock, int nbuf, int slotlen)
+{
+	struct _ip_uring_struct* u;
+	struct io_uring_params p;
+	struct io_uring_buf_reg reg;
+	unsigned int head;
+	int i;
+	u = (struct _ip_uring_struct *)calloc(1, sizeof(struct _ip_uring_struct));
+	if (u == NULL)
+	{
+		return -11;
+	}
+	u->nbuf = 1;
+	while (u->nbuf < nbuf)
+	{
+		u->nbuf <<= 1;
+	}
+	u->slotlen = slotlen;
+	u->msg.msg_controllen = CMSG_SPACE(sizeof(struct timespec));
+	u->buflen = (int )(sizeof(struct io_uring_recvmsg_out) + u->msg.msg_controllen) + slotlen;
+
+	// io_uring instance (completion queue large enough for all buffers):
+	memset(&p, 0, sizeof(p));
+	p.flags = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG;
+	p.cq_entries = 2 * u->nbuf;
+	u->fd = (int )syscall(__NR_io_uring_setup, 4, &p);
+	if (u->fd < 0)
+	{
+		free(u);
+		return -1;    // io_uring not available
+	}
+	if (!(p.features & IORING_FEAT_EXT_ARG))
+	{
+		uring_free(u);
+		return -1;    // kernel too old
+	}
+	u->sqmemlen = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+	u->sqmem = (char* )mmap(NULL, u->sqmemlen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+	u->cqmemlen = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	u->cqmem = (char* )mmap(NULL, u->cqmemlen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_CQ_RING);
+	u->sqeslen = p.sq_entries * sizeof(struct io_uring_sqe);
+	u->sqes = (struct io_uring_sqe* )mmap(NULL, u->sqeslen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQES);
+	if ((u->sqmem == (char* )MAP_FAILED) || (u->cqmem == (char* )MAP_FAILED) || (u->sqes == (struct io_uring_sqe* )MAP_FAILED))
+	{
+		if (u->sqmem == (char* )MAP_FAILED)
+		{
+			u->sqmem = NULL;
+		}
+		if (u->cqmem == (char* )MAP_FAILED)
+		{
+			u->cqmem = NULL;
+		}
+		if (u->sqes == (struct io_uring_sqe* )MAP_FAILED)
+		{
+			u->sqes = NULL;
+		}
+		uring_free(u);
+		return -2;
+	}
+	u->sq_tail = (unsigned int* )(u->sqmem + p.sq_off.tail);
+	u->sq_mask = (unsigned int* )(u->sqmem + p.sq_off.ring_mask);
+	u->sq_flags = (unsigned int* )(u->sqmem + p.sq_off.flags);
+	u->sq_array = (unsigned int* )(u->sqmem + p.sq_off.array);
+	u->cq_head = (unsigned int* )(u->cqmem + p.cq_off.head);
+	u->cq_tail = (unsigned int* )(u->cqmem + p.cq_off.tail);
+	u->cq_mask = (unsigned int* )(u->cqmem + p.cq_off.ring_mask);
+	u->cqes = (struct io_uring_cqe* )(u->cqmem + p.cq_off.cqes);
+
+	// ring of provided buffers (registered once, buffers are handed back without syscall):
+	u->brlen = u->nbuf * sizeof(struct io_uring_buf);
+	u->br = (struct io_uring_buf_ring* )mmap(NULL, u->brlen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (u->br == (struct io_uring_buf_ring* )MAP_FAILED)
+	{
+		u->br = NULL;
+		uring_free(u);
+		return -11;
+	}
+	u->buf = (char* )malloc((size_t )u->nbuf * u->buflen);
+	if (u->buf == NULL)
+	{
+		uring_free(u);
+		return -11;
+	}
+	memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = (unsigned long long )(size_t )u->br;
+	reg.ring_entries = u->nbuf;
+	reg.bgid = 0;
+	if (syscall(__NR_io_uring_register, u->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+	{
+		uring_free(u);
+		return -1;    // kernel too old
+	}
+	for (i = 0; i < u->nbuf; i++)
+	{
+		uring_provide(u, i);
+	}
+
+	// check recvmsg; an unsupported request is completed immediately with an error:
+	if (uring_arm(u, sock))
+	{
+		uring_free(u);
+		return -2;
+	}
+	head = *u->cq_head;
+	if ((head != __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE)) && (u->cqes[head & *u->cq_mask].res < 0)
+			&& !(u->cqes[head & *u->cq_mask].flags & IORING_CQE_F_MORE))
+	{
+		uring_free(u);
+		return -1;    // kernel too old
+	}
+	// not yet receiving: this thread might not be the one fetching the packets
+	if (uring_cancel(u))
+	{
+		uring_free(u);
+		return -2;
+	}
+	*ring = u;
+	return 0;
+}
+
+
+/**
+ *	\brief	Receive all completed UDP packets at once through io_uring.
+ *
+ *	Same semantics as udp_receive_batch(). Needs no syscall as long as packets are completed.
+ *	@param[in]	u		io_uring instance
+ *	@param[in]	sock	UDP socket (to submit recvmsg again)
+ *	@param[out] buffer 	buffer for UDP data, consists of nslot slots of slotlen bytes each
+ *	@param[in] 	slotlen	length of one slot
+ *	@param[in] 	nslot	number of slots
+ *	@param[out] len		number of received bytes per slot, -4 if packet didn't fit into its slot
+ *	@param[in]  tout_us timeout in us (micro sec)
+ *	@param[out]	rxtime	receive timestamp per slot in s (optional)
+ *	@return	number of received packets (oldest first), <0 if error/timeout occured
+ */
+static int uring_receive_batch(struct _ip_uring_struct* u, int sock, void *buffer, int slotlen, int nslot, int* len,
+		int tout_us, double* rxtime)
+{
+	struct io_uring_cqe* cqe;
+	struct io_uring_recvmsg_out* out;
+	struct io_uring_getevents_arg arg;
+	struct __kernel_timespec ts;
+	struct msghdr msg;
+	unsigned int head, tail;
+	int n = 0, err = -1, bid, waited = 0, flushed = 0;
+	while (1)
+	{
+		head = *u->cq_head;
+		tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+		while ((head != tail) && (n < nslot))
+		{
+			cqe = &u->cqes[head & *u->cq_mask];
+			if ((cqe->user_data == u->gen) && !(cqe->flags & IORING_CQE_F_MORE))
+			{	// recvmsg terminated (e.g. no buffer left), to be submitted again
+				u->armed = 0;
+			}
+			if (cqe->flags & IORING_CQE_F_BUFFER)
+			{
+				bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+				if (cqe->res >= 0)
+				{
+					out = (struct io_uring_recvmsg_out* )(u->buf + (size_t )bid * u->buflen);
+					len[n] = (int )out->payloadlen;
+					if ((len[n] >= slotlen) || (len[n] >= u->slotlen) || (out->flags & MSG_TRUNC))
+					{	// buffer overflow
+						len[n] = -4;
+					}
+					else
+					{
+						memcpy((char *)buffer + n * slotlen,
+								(char* )out + sizeof(struct io_uring_recvmsg_out) + out->namelen + out->controllen, len[n]);
+					}
+					if (rxtime != NULL)
+					{
+						memset(&msg, 0, sizeof(msg));
+						msg.msg_control = (char* )out + sizeof(struct io_uring_recvmsg_out) + out->namelen;
+						msg.msg_controllen = out->controllen;
+						rxtime[n] = msg_rxtime(&msg);
+					}
+					n++;
+				}
+				uring_provide(u, bid);
+			}
+			else if ((cqe->user_data == u->gen) && (cqe->res < 0) && (cqe->res != -ENOBUFS))
+			{	// receive error
+				err = -3;
+			}
+			head++;
+		}
+		__atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+		if (uring_prepare(u, sock))
+		{
+			return -3;
+		}
+		if (n > 0)
+		{
+			return n;
+		}
+		if ((err == -1) && !flushed && (__atomic_load_n(u->sq_flags, __ATOMIC_ACQUIRE) & IORING_SQ_TASKRUN))
+		{	// packets received, but completions wait for this thread to enter the kernel
+			syscall(__NR_io_uring_enter, u->fd, 0, 0, IORING_ENTER_GETEVENTS, NULL, 0);
+			flushed = 1;
+			continue;
+		}
+		if ((err != -1) || (tout_us <= 0) || waited)
+		{
+			return err;    // timeout (or receive error)
+		}
+		// waiting for data:
+		ts.tv_sec = tout_us / 1000000;
+		ts.tv_nsec = (tout_us % 1000000) * 1000;
+		memset(&arg, 0, sizeof(arg));
+		arg.ts = (unsigned long long )(size_t )&ts;
+		if ((syscall(__NR_io_uring_enter, u->fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg)) < 0)
+				&& (errno != ETIME) && (errno != EINTR))
+		{
+			return -2;    // error
+		}
+		waited = 1;
+	}
+}
+#endif
+
+/**
+ * 	\brief	Get value of an integer socket option.
+ *
+ *	@param[in]	s		socket
+ *	@param[in]	level	level of option
+ *	@param[in]	name	name of option
+ *	@return	value of option, 0 if not available
+ */
+static int sockopt_get(struct _ip_socket_struct* s, int level, int name)
+{
+	int value = 0;
+#ifdef OS_UNIX
+	socklen_t len = sizeof(value);
+#endif
+#ifdef OS_WIN
+	int len = sizeof(value);
+#endif
+	if (getsockopt(s->ossock, level, name, (char*)&value, &len) < 0)
+	{
+		return 0;
+	}
+	return value;
+}
+
+
+/**
+ * 	\brief	Set socket options before binding the socket.
+ *
+ *	Failing options are ignored, the values applied by the OS are returned in opt.
+ *	@param[in]		s		socket
+ *	@param[in,out]	opt		socket options
+ */
+static void sockopt_set(struct _ip_socket_struct* s, DTrack_Socket_Options_Type* opt)
+{
+	int value;
+	if (opt->rcvbuf > 0)
+	{
+		value = opt->rcvbuf;
+#ifdef SO_RCVBUFFORCE
+		// exceeding the system limit (net.core.rmem_max) needs CAP_NET_ADMIN:
+		if (setsockopt(s->ossock, SOL_SOCKET, SO_RCVBUFFORCE, (char*)&value, sizeof(value)) < 0)
+#endif
+		setsockopt(s->ossock, SOL_SOCKET, SO_RCVBUF, (char*)&value, sizeof(value));
+	}
+	opt->rcvbuf = sockopt_get(s, SOL_SOCKET, SO_RCVBUF);
+
+#ifdef SO_BUSY_POLL
+	if (opt->busy_poll_us > 0)
+	{
+		value = opt->busy_poll_us;
+		setsockopt(s->ossock, SOL_SOCKET, SO_BUSY_POLL, (char*)&value, sizeof(value));
+	}
+	opt->busy_poll_us = sockopt_get(s, SOL_SOCKET, SO_BUSY_POLL);
+#else
+	opt->busy_poll_us = 0;
+#endif
+
+	if (opt->reuse_port)
+	{
+		value = 1;
+#ifdef SO_REUSEPORT
+		setsockopt(s->ossock, SOL_SOCKET, SO_REUSEPORT, (char*)&value, sizeof(value));
+		opt->reuse_port = (sockopt_get(s, SOL_SOCKET, SO_REUSEPORT) != 0);
+#else
+		setsockopt(s->ossock, SOL_SOCKET, SO_REUSEADDR, (char*)&value, sizeof(value));
+		opt->reuse_port = (sockopt_get(s, SOL_SOCKET, SO_REUSEADDR) != 0);
+#endif
+	}
+}
+
+
 /**
  * 	\brief	Initialize UDP socket.
  *
+ *	Socket options are set as far as possible, failing options don't cause an error.
  *	@param[out]		sock	socket number
  *	@param[in,out]	port	port number, 0 if to be chosen by the OS
  *	@param[in]		ip		multicast ip to listen
+ *	@param[in,out]	opt		socket options (optional): requested values, returns values applied by the OS
  *	@return 0 if ok, < 0 if error occured
  */
-int udp_init(void** sock, unsigned short* port, unsigned int ip)
+int udp_init(void** sock, unsigned short* port, unsigned int ip, DTrack_Socket_Options_Type* opt)
 {
 	struct _ip_socket_struct* s;
 	struct sockaddr_in addr;
@@ -136,6 +745,14 @@ int udp_init(void** sock, unsigned short* port, unsigned int ip)
 		free(s);
 		return -2;
 	}
+#endif
+#ifdef NET_IO_URING
+	s->ring = NULL;
+#endif
+#ifdef OS_LINUX
+	// let the kernel timestamp received packets (optional, ignore errors):
+	int flag_ts = 1;
+	setsockopt(s->ossock, SOL_SOCKET, SO_TIMESTAMPNS, (char*)&flag_ts, sizeof(flag_ts));
 #endif
 	if (ip != 0) {
 		// set reuse port to on to allow multiple binds per host
@@ -147,6 +764,10 @@ int udp_init(void** sock, unsigned short* port, unsigned int ip)
 			return -4;
 		}
 	}
+	if (opt != NULL)
+	{
+		sockopt_set(s, opt);
+	}
 
 	// name socket:
 	addr.sin_family = AF_INET;
@@ -173,7 +794,7 @@ int udp_init(void** sock, unsigned short* port, unsigned int ip)
 		// construct an IGMP join request structure
 		struct ip_mreq ipmreq;
 		ipmreq.imr_multiaddr.s_addr = htonl(ip);
-		ipmreq.imr_interface.s_addr = htonl(INADDR_ANY);
+		ipmreq.imr_interface.s_addr = htonl(((opt != NULL) && (opt->multicast_if != 0)) ? opt->multicast_if : INADDR_ANY);
 		// send an ADD MEMBERSHIP message via setsockopt
 		if ((setsockopt(s->ossock, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char*)&ipmreq, sizeof(ipmreq))) < 0)
 		{
@@ -193,9 +814,10 @@ int udp_init(void** sock, unsigned short* port, unsigned int ip)
  *
  *	@param[in]	sock	socket number
  *	@param[in]	ip		multicast ip to drop
+ *	@param[in]	ip_if	local interface of multicast group (see DTrack_Socket_Options_Type)
  *	@return	0 ok, -1 error
  */
-int udp_exit(void* sock, unsigned int ip)
+int udp_exit(void* sock, unsigned int ip, unsigned int ip_if)
 {
 	int err;
 	struct _ip_socket_struct* s = (struct _ip_socket_struct *)sock;
@@ -207,13 +829,16 @@ int udp_exit(void* sock, unsigned int ip)
 	if (ip != 0) {
 		struct ip_mreq ipmreq;
 		ipmreq.imr_multiaddr.s_addr = htonl(ip);
-		ipmreq.imr_interface.s_addr = htonl(INADDR_ANY);
+		ipmreq.imr_interface.s_addr = htonl((ip_if != 0) ? ip_if : INADDR_ANY);
 		// send a DROP MEMBERSHIP message via setsockopt
 		if ((setsockopt(s->ossock, IPPROTO_IP, IP_DROP_MEMBERSHIP, (char*)&ipmreq, sizeof(ipmreq))) < 0)
 		{
 			perror("setsockopt() failed3");
 		}
 	}
+#ifdef NET_IO_URING
+	uring_free(s->ring);  // cancels pending receive
+#endif
 #ifdef OS_UNIX
 	err = close(s->ossock);
 #endif
@@ -230,6 +855,37 @@ int udp_exit(void* sock, unsigned int ip)
 }
 
 
+/**
+ * 	\brief	Receive through io_uring.
+ *
+ *	Packets are received by the kernel into registered buffers and taken from the completion
+ *	queue by udp_receive() and udp_receive_batch(), without a syscall as long as packets are
+ *	available. Receive timestamps are taken by the kernel as before. Needs Linux 6.0 or newer.
+ *	Receiving starts with the first call of udp_receive(), udp_receive_batch() or udp_poll_wait(),
+ *	as the kernel completes packets in the context of the thread fetching them.
+ *	@param[in]	sock	socket number
+ *	@param[in]	nbuf	number of buffers (packets received but not yet fetched)
+ *	@param[in]	slotlen	max length of packet
+ *	@return	0 if ok, <0 if error occured (-1 io_uring not available, socket keeps receiving as before)
+ */
+int udp_uring_init(void* sock, int nbuf, int slotlen)
+{
+#ifdef NET_IO_URING
+	struct _ip_socket_struct* s = (struct _ip_socket_struct *)sock;
+	if (s->ring != NULL)
+	{
+		return 0;
+	}
+	return uring_init(&s->ring, s->ossock, nbuf, slotlen);
+#else
+	(void )sock;
+	(void )nbuf;
+	(void )slotlen;
+	return -1;    // not available
+#endif
+}
+
+
 /**
  *	\brief	Receive UDP data.
  *
@@ -240,12 +896,32 @@ int udp_exit(void* sock, unsigned int ip)
  *	@param[in]  tout_us timeout in us (micro sec)
  *	@return	number of received bytes, <0 if error/timeout occured
  */
-int udp_receive(const void* sock, void *buffer, int maxlen, int tout_us)
+int udp_receive(const void* sock, void *buffer, int maxlen, int tout_us, double* rxtime)
 {
 	int nbytes, err;
 	fd_set set;
 	struct timeval tout;
 	struct _ip_socket_struct* s = (struct _ip_socket_struct *)sock;
+#ifdef OS_LINUX
+	struct msghdr msg;
+	struct iovec iov;
+	char ctrl[CMSG_SPACE(sizeof(struct timespec))];
+#endif
+#ifdef NET_IO_URING
+	if (s->ring != NULL)
+	{	// keep newest of the queued packets
+		nbytes = -1;
+		while ((err = uring_receive_batch(s->ring, s->ossock, buffer, maxlen, 1, &nbytes, tout_us, rxtime)) == 1)
+		{
+			tout_us = 0;
+		}
+		if ((err == -1) && (tout_us == 0))
+		{	// no more data available
+			return nbytes;
+		}
+		return err;
+	}
+#endif
 	// waiting for data:
 	FD_ZERO(&set);
 	FD_SET(s->ossock, &set);
@@ -263,11 +939,30 @@ int udp_receive(const void* sock, void *buffer, int maxlen, int tout_us)
 	// receiving packet:
 	while (1)
 	{	// receive one packet:
+#ifdef OS_LINUX
+		iov.iov_base = buffer;
+		iov.iov_len = maxlen;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = ctrl;
+		msg.msg_controllen = sizeof(ctrl);
+		nbytes = recvmsg(s->ossock, &msg, 0);
+#else
 		nbytes = recv(s->ossock, (char *)buffer, maxlen, 0);
+#endif
 		if (nbytes < 0)
 		{	// receive error
 			return -3;
 		}
+		if (rxtime != NULL)
+		{
+#ifdef OS_LINUX
+			*rxtime = msg_rxtime(&msg);
+#else
+			*rxtime = net_time();
+#endif
+		}
 		// check, if more data available: if so, receive another packet
 		FD_ZERO(&set);
 		FD_SET(s->ossock, &set);
@@ -287,6 +982,144 @@ int udp_receive(const void* sock, void *buffer, int maxlen, int tout_us)
 }
 
 
+/**
+ *	\brief	Receive all queued UDP packets at once.
+ *
+ *	Waits for data, then fetches as many queued packets as slots are available (one packet per slot).
+ *	Uses a single recvmmsg() call on Linux (or takes completed packets from io_uring, see udp_uring_init());
+ *	other systems receive the packets one by one.
+ *	@param[in]	sock	socket number
+ *	@param[out] buffer 	buffer for UDP data, consists of nslot slots of slotlen bytes each
+ *	@param[in] 	slotlen	length of one slot
+ *	@param[in] 	nslot	number of slots
+ *	@param[out] len		number of received bytes per slot, -4 if packet didn't fit into its slot
+ *	@param[in]  tout_us timeout in us (micro sec)
+ *	@return	number of received packets (oldest first), <0 if error/timeout occured
+ */
+int udp_receive_batch(const void* sock, void *buffer, int slotlen, int nslot, int* len, int tout_us, double* rxtime)
+{
+	int n, err;
+	fd_set set;
+	struct timeval tout;
+	struct _ip_socket_struct* s = (struct _ip_socket_struct *)sock;
+	if (nslot > NET_MAX_SLOT)
+	{
+		nslot = NET_MAX_SLOT;
+	}
+#ifdef NET_IO_URING
+	if (s->ring != NULL)
+	{
+		return uring_receive_batch(s->ring, s->ossock, buffer, slotlen, nslot, len, tout_us, rxtime);
+	}
+#endif
+#ifdef OS_LINUX
+	struct mmsghdr msgs[NET_MAX_SLOT];
+	struct iovec iov[NET_MAX_SLOT];
+	char ctrl[NET_MAX_SLOT][CMSG_SPACE(sizeof(struct timespec))];
+	for (n = 0; n < nslot; n++)
+	{
+		iov[n].iov_base = (char *)buffer + n * slotlen;
+		iov[n].iov_len = slotlen;
+		memset(&msgs[n], 0, sizeof(struct mmsghdr));
+		msgs[n].msg_hdr.msg_iov = &iov[n];
+		msgs[n].msg_hdr.msg_iovlen = 1;
+		msgs[n].msg_hdr.msg_control = ctrl[n];
+		msgs[n].msg_hdr.msg_controllen = sizeof(ctrl[n]);
+	}
+	// try to fetch already queued packets without waiting:
+	n = recvmmsg(s->ossock, msgs, nslot, MSG_DONTWAIT, NULL);
+	if (n < 0)
+	{
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{	// receive error
+			return -3;
+		}
+		if (tout_us <= 0)
+		{
+			return -1;    // timeout
+		}
+		// waiting for data:
+		FD_ZERO(&set);
+		FD_SET(s->ossock, &set);
+		tout.tv_sec = tout_us / 1000000;
+		tout.tv_usec = tout_us % 1000000;
+		switch ((err = select(FD_SETSIZE, &set, NULL, NULL, &tout)))
+		{
+			case 1:
+				break;        // data available
+			case 0:
+				return -1;    // timeout
+			default:
+			  return -2;    // error
+		}
+		n = recvmmsg(s->ossock, msgs, nslot, MSG_DONTWAIT, NULL);
+		if (n <= 0)
+		{	// receive error
+			return -3;
+		}
+	}
+	for (int i = 0; i < n; i++)
+	{
+		len[i] = (int )msgs[i].msg_len;
+		if ((len[i] >= slotlen) || (msgs[i].msg_hdr.msg_flags & MSG_TRUNC))
+		{	// buffer overflow
+			len[i] = -4;
+		}
+		if (rxtime != NULL)
+		{
+			rxtime[i] = msg_rxtime(&msgs[i].msg_hdr);
+		}
+	}
+	return n;
+#else
+	// waiting for data:
+	FD_ZERO(&set);
+	FD_SET(s->ossock, &set);
+	tout.tv_sec = tout_us / 1000000;
+	tout.tv_usec = tout_us % 1000000;
+	switch ((err = select(FD_SETSIZE, &set, NULL, NULL, &tout)))
+	{
+		case 1:
+			break;        // data available
+		case 0:
+			return -1;    // timeout
+		default:
+	      return -2;    // error
+	}
+	// receiving packets:
+	n = 0;
+	while (n < nslot)
+	{	// receive one packet:
+		len[n] = recv(s->ossock, (char *)buffer + n * slotlen, slotlen, 0);
+		if (len[n] < 0)
+		{	// receive error
+			return -3;
+		}
+		if (len[n] >= slotlen)
+		{	// buffer overflow
+			len[n] = -4;
+		}
+		if (rxtime != NULL)
+		{
+			rxtime[n] = net_time();
+		}
+		n++;
+		// check, if more data available: if so, receive another packet
+		FD_ZERO(&set);
+		FD_SET(s->ossock, &set);
+
+		tout.tv_sec = 0;   // no timeout
+		tout.tv_usec = 0;
+		if (select(FD_SETSIZE, &set, NULL, NULL, &tout) != 1)
+		{
+			break;
+		}
+	}
+	return n;
+#endif
+}
+
+
 /**
  *	\brief	Send UDP data.
  *
@@ -333,6 +1166,193 @@ int udp_send(const void* sock, void* buffer, int len, unsigned int ipaddr, unsig
 	return 0;
 }
 
+// ---------------------------------------------------------------------------------------------------
+// Waiting for data on several UDP sockets:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Initialize poll set.
+ *
+ *	@param[out]	poll	poll set
+ *	@return	0 if ok, <0 if error occured
+ */
+int udp_poll_init(void** poll)
+{
+	struct _ip_poll_struct* p;
+	p = (struct _ip_poll_struct *)malloc(sizeof(struct _ip_poll_struct));
+	if (p == NULL)
+	{
+		return -11;
+	}
+#ifdef OS_LINUX
+	p->epfd = epoll_create(NET_MAX_POLL);
+	if (p->epfd < 0)
+	{
+		free(p);
+		return -2;
+	}
+#else
+	p->num = 0;
+#endif
+#ifdef NET_IO_URING
+	p->nring = 0;
+#endif
+	*poll = p;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Deinitialize poll set.
+ *
+ *	The sockets of the set are not closed.
+ *	@param[in]	poll	poll set
+ *	@return	0 ok, -1 error
+ */
+int udp_poll_exit(void* poll)
+{
+	int err = 0;
+	struct _ip_poll_struct* p = (struct _ip_poll_struct *)poll;
+	if (poll == NULL)
+	{
+		return 0;
+	}
+#ifdef OS_LINUX
+	err = close(p->epfd);
+#endif
+	free(poll);
+	if (err < 0)
+	{
+		return -1;
+	}
+	return 0;
+}
+
+
+/**
+ * 	\brief	Add UDP socket to poll set.
+ *
+ *	@param[in]	poll	poll set
+ *	@param[in]	sock	socket number
+ *	@param[in]	id		id reported by udp_poll_wait() if data is available on this socket
+ *	@return	0 if ok, <0 if error occured
+ */
+int udp_poll_add(void* poll, const void* sock, int id)
+{
+	struct _ip_poll_struct* p = (struct _ip_poll_struct *)poll;
+	struct _ip_socket_struct* s = (struct _ip_socket_struct *)sock;
+#ifdef OS_LINUX
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.u32 = (unsigned int )id;
+#ifdef NET_IO_URING
+	if (s->ring != NULL)
+	{	// io_uring instance is readable as soon as packets are completed
+		if (p->nring >= NET_MAX_POLL)
+		{
+			return -2;
+		}
+		if (epoll_ctl(p->epfd, EPOLL_CTL_ADD, s->ring->fd, &ev) < 0)
+		{
+			return -2;
+		}
+		p->ring[p->nring++] = s;
+		return 0;
+	}
+#endif
+	if (epoll_ctl(p->epfd, EPOLL_CTL_ADD, s->ossock, &ev) < 0)
+	{
+		return -2;
+	}
+#else
+	if (p->num >= NET_MAX_POLL)
+	{	// poll set full
+		return -2;
+	}
+	p->sock[p->num] = s;
+	p->id[p->num] = id;
+	p->num++;
+#endif
+	return 0;
+}
+
+
+/**
+ *	\brief	Wait for data on the sockets of a poll set.
+ *
+ *	Uses epoll on Linux (timeout in ms resolution), select() on other systems.
+ *	@param[in]	poll	poll set
+ *	@param[out]	ids		ids of sockets with data available
+ *	@param[in]	maxids	length of ids
+ *	@param[in]	tout_us	timeout in us (micro sec)
+ *	@return	number of sockets with data available, <0 if error/timeout occured
+ */
+int udp_poll_wait(void* poll, int* ids, int maxids, int tout_us)
+{
+	int n, i;
+	struct _ip_poll_struct* p = (struct _ip_poll_struct *)poll;
+#ifdef OS_LINUX
+	struct epoll_event ev[NET_MAX_POLL];
+	if (maxids > NET_MAX_POLL)
+	{
+		maxids = NET_MAX_POLL;
+	}
+#ifdef NET_IO_URING
+	for (i = 0; i < p->nring; i++)
+	{	// start receiving in this thread (errors are reported by udp_receive_batch())
+		uring_prepare(p->ring[i]->ring, p->ring[i]->ossock);
+	}
+#endif
+	do
+	{	// io_uring (see udp_uring_init()) wakes up waiting when packets are to be completed
+		n = epoll_wait(p->epfd, ev, maxids, (tout_us + 999) / 1000);
+	}
+	while ((n < 0) && (errno == EINTR));
+	if (n == 0)
+	{
+		return -1;    // timeout
+	}
+	if (n < 0)
+	{
+		return -2;    // error
+	}
+	for (i = 0; i < n; i++)
+	{
+		ids[i] = (int )ev[i].data.u32;
+	}
+	return n;
+#else
+	fd_set set;
+	struct timeval tout;
+	FD_ZERO(&set);
+	for (i = 0; i < p->num; i++)
+	{
+		FD_SET(p->sock[i]->ossock, &set);
+	}
+	tout.tv_sec = tout_us / 1000000;
+	tout.tv_usec = tout_us % 1000000;
+	n = select(FD_SETSIZE, &set, NULL, NULL, &tout);
+	if (n == 0)
+	{
+		return -1;    // timeout
+	}
+	if (n < 0)
+	{
+		return -2;    // error
+	}
+	n = 0;
+	for (i = 0; (i < p->num) && (n < maxids); i++)
+	{
+		if (FD_ISSET(p->sock[i]->ossock, &set))
+		{
+			ids[n++] = p->id[i];
+		}
+	}
+	return n;
+#endif
+}
+
 // ---------------------------------------------------------------------------------------------------
 // Handling TCP data:
 // ---------------------------------------------------------------------------------------------------
@@ -476,6 +1496,51 @@ int tcp_receive(const void* sock, void *buffer, int maxlen, int tout_us)
 }
 
 
+/**
+ * 	\brief	Receive TCP data as stream.
+ *
+ *	Unlike tcp_receive(), a completely filled buffer is not an error: data exceeding the buffer
+ *	stays in the socket for the next call.
+ *	@param[in] 	sock	socket number
+ *	@param[out] buffer	buffer for TCP data
+ *	@param[in]	maxlen	length of buffer
+ *	@param[in]	tout_us	timeout in us (micro sec)
+ *	@return		number of received bytes, <0 if error/timeout occured, -9 broken connection
+ */
+int tcp_receive_stream(const void* sock, void *buffer, int maxlen, int tout_us)
+{
+	int nbytes, err;
+	fd_set set;
+	struct timeval tout;
+	struct _ip_socket_struct* s = (struct _ip_socket_struct *)sock;
+	// waiting for data:
+	FD_ZERO(&set);
+	FD_SET(s->ossock, &set);
+	tout.tv_sec = tout_us / 1000000;
+	tout.tv_usec = tout_us % 1000000;
+	switch ((err = select(FD_SETSIZE, &set, NULL, NULL, &tout)))
+	{
+		case 1:
+			break;        // data available
+		case 0:
+			return -1;    // timeout
+		default:
+	      return -2;    // error
+	}
+	// receiving data:
+	nbytes = recv(s->ossock, (char *)buffer, maxlen, 0);
+	if (nbytes == 0)
+	{	// broken connection
+		return -9;
+	}
+	if (nbytes < 0)
+	{	// receive error
+		return -3;
+	}
+	return nbytes;
+}
+
+
 /**
  * 	\brief	Send TCP data.
  *
@@ -30,8 +30,13 @@
 	#define OS_WIN   // for MS Windows (2000, XP, Vista, 7)
 #else
 	#define OS_UNIX  // for Unix (Linux, Irix)
+	#if defined(__linux__)
+		#define OS_LINUX  // Linux specific extensions (e.g. recvmmsg)
+	#endif
 #endif
 
+#include "DTrackDataTypes.h"
+
 #ifdef OS_UNIX
 	#include <unistd.h>
 	#include <netdb.h>
@@ -66,36 +71,92 @@ void net_exit(void);
  */
 unsigned int ip_name2ip(const char* name);
 
+/**
+ * 	\brief	Get current time.
+ *
+ *	Same clock as used for receive timestamps of UDP packets (see udp_receive()).
+ *	@return		time in s since 1970-01-01 00:00:00 UTC
+ */
+double net_time(void);
+
+/**
+ * 	\brief	Get monotonic time with high resolution.
+ *
+ *	Suitable for measuring short durations, not related to calendar time.
+ *	@return		time in s since an arbitrary point in time
+ */
+double net_clock(void);
+
 /**
  * 	\brief	Initialize UDP socket.
  *
+ *	Socket options are set as far as possible, failing options don't cause an error.
  *	@param[out]		sock	socket number
  *	@param[in,out]	port	port number, 0 if to be chosen by the OS
  *	@param[in]		ip		multicast ip to listen
+ *	@param[in,out]	opt		socket options (optional): requested values, returns values applied by the OS
  *	@return 0 if ok, < 0 if error occured
  */
-int udp_init(void** sock, unsigned short* port, unsigned int ip = 0);
+int udp_init(void** sock, unsigned short* port, unsigned int ip = 0,
+		DTrackSDK_Datatypes::DTrack_Socket_Options_Type* opt = NULL);
 
 /**
  * 	\brief	Deinitialize UDP socket.
  *
  *	@param[in]	sock	socket number
  *	@param[in]	ip		multicast ip to drop
+ *	@param[in]	ip_if	local interface of multicast group (see DTrack_Socket_Options_Type)
  *	@return	0 ok, -1 error
  */
-int udp_exit(void* sock, unsigned int ip = 0);
+int udp_exit(void* sock, unsigned int ip = 0, unsigned int ip_if = 0);
+
+/**
+ * 	\brief	Receive through io_uring.
+ *
+ *	Packets are received by the kernel into registered buffers and taken from the completion
+ *	queue by udp_receive() and udp_receive_batch(), without a syscall as long as packets are
+ *	available. Receive timestamps are taken by the kernel as before. Needs Linux 6.0 or newer.
+ *	Receiving starts with the first call of udp_receive(), udp_receive_batch() or udp_poll_wait(),
+ *	as the kernel completes packets in the context of the thread fetching them.
+ *	@param[in]	sock	socket number
+ *	@param[in]	nbuf	number of buffers (packets received but not yet fetched)
+ *	@param[in]	slotlen	max length of packet
+ *	@return	0 if ok, <0 if error occured (-1 io_uring not available, socket keeps receiving as before)
+ */
+int udp_uring_init(void* sock, int nbuf, int slotlen);
 
 /**
  *	\brief	Receive UDP data.
  *
  *	Tries to receive one packet, as long as data is available.
+ *	On Linux the receive timestamp is taken by the kernel (SO_TIMESTAMPNS) when the packet arrives,
+ *	otherwise it is taken when the packet is fetched from the socket (see net_time()).
  *	@param[in]	sock	socket number
  *	@param[out] buffer 	buffer for UDP data
  *	@param[in] 	maxlen	length of buffer
  *	@param[in]  tout_us timeout in us (micro sec)
+ *	@param[out]	rxtime	receive timestamp of packet in s (optional, see net_time())
  *	@return	number of received bytes, <0 if error/timeout occured
  */
-int udp_receive(const void* sock, void *buffer, int maxlen, int tout_us);
+int udp_receive(const void* sock, void *buffer, int maxlen, int tout_us, double* rxtime = NULL);
+
+/**
+ *	\brief	Receive all queued UDP packets at once.
+ *
+ *	Waits for data, then fetches as many queued packets as slots are available (one packet per slot).
+ *	Uses a single recvmmsg() call on Linux (or takes completed packets from io_uring, see udp_uring_init());
+ *	other systems receive the packets one by one.
+ *	Receive timestamps are taken as in udp_receive().
+ *	@param[in]	sock	socket number
+ *	@param[out] buffer 	buffer for UDP data, consists of nslot slots of slotlen bytes each
+ *	@param[in] 	slotlen	length of one slot
+ *	@param[in] 	nslot	number of slots
+ *	@param[out] len		number of received bytes per slot, -4 if packet didn't fit into its slot
+ *	@param[in]  tout_us timeout in us (micro sec)
+ *	@param[out]	rxtime	receive timestamp per slot in s (optional, see net_time())
+ *	@return	number of received packets (oldest first), <0 if error/timeout occured
+ */
+int udp_receive_batch(const void* sock, void *buffer, int slotlen, int nslot, int* len, int tout_us, double* rxtime = NULL);
 
 /**
  *	\brief	Send UDP data.
@@ -110,6 +171,47 @@ int udp_receive(const void* sock, void *buffer, int maxlen, int tout_us);
  */
 int udp_send(const void* sock, void* buffer, int len, unsigned int ipaddr, unsigned short port, int tout_us);
 
+/**
+ * 	\brief	Initialize poll set.
+ *
+ *	A poll set waits for data on several UDP sockets at once.
+ *	@param[out]	poll	poll set
+ *	@return	0 if ok, <0 if error occured
+ */
+int udp_poll_init(void** poll);
+
+/**
+ * 	\brief	Deinitialize poll set.
+ *
+ *	The sockets of the set are not closed.
+ *	@param[in]	poll	poll set
+ *	@return	0 ok, -1 error
+ */
+int udp_poll_exit(void* poll);
+
+/**
+ * 	\brief	Add UDP socket to poll set.
+ *
+ *	A closed socket is removed automatically on Linux, other systems need a new poll set.
+ *	@param[in]	poll	poll set
+ *	@param[in]	sock	socket number
+ *	@param[in]	id		id reported by udp_poll_wait() if data is available on this socket
+ *	@return	0 if ok, <0 if error occured (e.g. more than 64 sockets without epoll)
+ */
+int udp_poll_add(void* poll, const void* sock, int id);
+
+/**
+ *	\brief	Wait for data on the sockets of a poll set.
+ *
+ *	Uses epoll on Linux (timeout in ms resolution), select() on other systems.
+ *	@param[in]	poll	poll set
+ *	@param[out]	ids		ids of sockets with data available
+ *	@param[in]	maxids	length of ids
+ *	@param[in]	tout_us	timeout in us (micro sec)
+ *	@return	number of sockets with data available, <0 if error/timeout occured
+ */
+int udp_poll_wait(void* poll, int* ids, int maxids, int tout_us);
+
 /**
  *	\brief	Initialize client TCP socket.
  *
@@ -139,6 +241,19 @@ int tcp_exit(void* sock);
  */
 int tcp_receive(const void* sock, void *buffer, int maxlen, int tout_us);
 
+/**
+ * 	\brief	Receive TCP data as stream.
+ *
+ *	Unlike tcp_receive(), a completely filled buffer is not an error: data exceeding the buffer
+ *	stays in the socket for the next call.
+ *	@param[in] 	sock	socket number
+ *	@param[out] buffer	buffer for TCP data
+ *	@param[in]	maxlen	length of buffer
+ *	@param[in]	tout_us	timeout in us (micro sec)
+ *	@return		number of received bytes, <0 if error/timeout occured, -9 broken connection
+ */
+int tcp_receive_stream(const void* sock, void *buffer, int maxlen, int tout_us);
+
 /**
  * 	\brief	Send TCP data.
  *
@@ -24,6 +24,271 @@
 
 #include "DTrackParse.hpp"
 
+#ifdef DTRACK_PARSE_FROM_CHARS
+	#include <charconv>
+#endif
+
+// ---------------------------------------------------------------------------------------------------
+// Fast number conversion:
+//
+// DTrack sends plain decimal numbers (e.g. '-1234.567', '0.999876', '1'). These are converted
+// directly, without the locale handling of strtod()/strtol(). Anything else (more digits than
+// fit exactly, hexadecimal or octal numbers, 'inf', ...) is left to the C library, so results
+// are always identical to strtod()/strtol().
+//
+// Define DTRACK_PARSE_FROM_CHARS to convert floating point numbers with std::from_chars()
+// instead (C++17).
+// ---------------------------------------------------------------------------------------------------
+
+#define PARSE_MAXDIGITS_UI     9  // maximum number of digits of an 'unsigned int' without overflow
+#define PARSE_MAXDIGITS_D     19  // maximum number of significant digits fitting into 64 bit
+#define PARSE_MAXEXP_D        22  // maximum power of ten exactly representable as 'double'
+#define PARSE_MAXMANT_D  (((unsigned long long )1) << 53)  // maximum mantissa exactly representable as 'double'
+
+static const double parse_pow10[PARSE_MAXEXP_D + 1] = {
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+
+/**
+ * 	\brief	Skip white space (same characters as isspace() in the "C" locale)
+ *
+ *	@param[in] 	str		string
+ *	@return		pointer to first other character
+ */
+static inline char* parse_skip_space(char* str)
+{
+	while (*str == ' ' || (*str >= '\t' && *str <= '\r'))
+	{
+		str++;
+	}
+	return str;
+}
+
+
+/**
+ * 	\brief	Read plain decimal integer ('[+-]ddd') from string
+ *
+ *	@param[in] 	str		string
+ *	@param[out] ui		read absolute value
+ *	@param[out] neg		value is negative?
+ *	@return		pointer behind read value in str; NULL if not a plain decimal integer
+ */
+static inline char* parse_decimal_ui(char* str, unsigned int* ui, bool* neg)
+{
+	char* s = parse_skip_space(str);
+	char* digits;
+	unsigned int v = 0;
+	*neg = false;
+	if (*s == '-' || *s == '+')
+	{
+		*neg = (*s == '-');
+		s++;
+	}
+	if (*s == '0' && ((s[1] >= '0' && s[1] <= '9') || s[1] == 'x' || s[1] == 'X'))
+	{	// octal or hexadecimal number
+		return NULL;
+	}
+	digits = s;
+	while (*s >= '0' && *s <= '9')
+	{
+		v = v * 10 + (unsigned int )(*s - '0');
+		s++;
+	}
+	if (s == digits || s - digits > PARSE_MAXDIGITS_UI)
+	{	// no number or possible overflow
+		return NULL;
+	}
+	*ui = v;
+	return s;
+}
+
+
+#ifndef DTRACK_PARSE_FROM_CHARS
+
+/**
+ * 	\brief	Read plain decimal floating point number ('[+-]ddd.ddd[e[+-]dd]') from string
+ *
+ *	Only numbers that can be converted exactly (correctly rounded, like strtod()) are accepted.
+ *	@param[in] 	str		string
+ *	@param[out] d		read value
+ *	@return		pointer behind read value in str; NULL if not converted
+ */
+static inline char* parse_decimal_d(char* str, double* d)
+{
+	char* s = parse_skip_space(str);
+	char* e;
+	bool neg = false, expneg = false;
+	unsigned long long mant = 0;
+	int ndigits = 0, nsig = 0, exp = 0, expval = 0;
+	double v;
+	if (*s == '-' || *s == '+')
+	{
+		neg = (*s == '-');
+		s++;
+	}
+	if (*s == '0' && (s[1] == 'x' || s[1] == 'X'))
+	{	// hexadecimal number
+		return NULL;
+	}
+	// integer part:
+	while (*s >= '0' && *s <= '9')
+	{
+		if (mant != 0 || *s != '0')
+		{	// significant digit
+			mant = mant * 10 + (unsigned long long )(*s - '0');
+			nsig++;
+		}
+		ndigits++;
+		s++;
+	}
+	// fractional part:
+	if (*s == '.')
+	{
+		s++;
+		while (*s >= '0' && *s <= '9')
+		{
+			if (mant != 0 || *s != '0')
+			{	// significant digit
+				mant = mant * 10 + (unsigned long long )(*s - '0');
+				nsig++;
+			}
+			ndigits++;
+			exp--;
+			s++;
+		}
+	}
+	if (ndigits == 0 || nsig > PARSE_MAXDIGITS_D)
+	{	// no number or too many digits
+		return NULL;
+	}
+	// exponent:
+	if (*s == 'e' || *s == 'E')
+	{
+		e = s + 1;
+		if (*e == '-' || *e == '+')
+		{
+			expneg = (*e == '-');
+			e++;
+		}
+		if (*e >= '0' && *e <= '9')
+		{	// otherwise 'e' doesn't belong to the number
+			while (*e >= '0' && *e <= '9')
+			{
+				if (expval < 10000)
+				{
+					expval = expval * 10 + (*e - '0');
+				}
+				e++;
+			}
+			exp += expneg ? -expval : expval;
+			s = e;
+		}
+	}
+	if (mant > PARSE_MAXMANT_D || exp > PARSE_MAXEXP_D || exp < -PARSE_MAXEXP_D)
+	{	// conversion wouldn't be exact
+		if (mant != 0)
+		{
+			return NULL;
+		}
+		exp = 0;
+	}
+	v = (double )mant;
+	if (exp < 0)
+	{
+		v /= parse_pow10[-exp];
+	} else {
+		v *= parse_pow10[exp];
+	}
+	*d = neg ? -v : v;
+	return s;
+}
+
+#else
+
+/**
+ * 	\brief	Read floating point number from string using std::from_chars()
+ *
+ *	@param[in] 	str		string
+ *	@param[out] d		read value
+ *	@return		pointer behind read value in str; NULL if not converted
+ */
+static inline char* parse_decimal_d(char* str, double* d)
+{
+	char* s = parse_skip_space(str);
+	char* e;
+	if (*s == '+' && s[1] != '-')
+	{	// std::from_chars() doesn't accept a leading '+'
+		s++;
+	}
+	e = s;
+	while ((*e >= '0' && *e <= '9') || *e == '.' || *e == '-' || *e == '+' || *e == 'e' || *e == 'E')
+	{	// end of number
+		e++;
+	}
+	std::from_chars_result res = std::from_chars(s, e, *d);
+	if (res.ec != std::errc() || *res.ptr == 'x' || *res.ptr == 'X')
+	{	// let strtod() handle errors and special values
+		return NULL;
+	}
+	return (char* )res.ptr;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------------------------------
+// Line index:
+//
+// Line starts of a whole packet are searched with SSE2 or AVX2 (16 or 32 bytes per step), selected
+// at compile time (e.g. '-mavx2' or '/arch:AVX2'). Without SIMD support a plain loop is used.
+// ---------------------------------------------------------------------------------------------------
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define PARSE_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#include <emmintrin.h>
+	#define PARSE_SIMD_SSE2
+#endif
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+/**
+ * 	\brief	Is character a line delimiter (CR or LF)?
+ */
+static inline bool parse_is_eol(char c)
+{
+	return (c == '\r' || c == '\n');
+}
+
+#if defined(PARSE_SIMD_AVX2) || defined(PARSE_SIMD_SSE2)
+
+/**
+ * 	\brief	Index of lowest set bit
+ *
+ *	@param[in] 	x		value (not 0)
+ *	@return		bit index
+ */
+static inline int parse_lowest_bit(unsigned int x)
+{
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward(&i, x);
+	return (int )i;
+#else
+	return __builtin_ctz(x);
+#endif
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------
+
 namespace DTrackSDK_Parse {
 
 /**
@@ -55,6 +320,91 @@ char* string_nextline(char* str, char* start, int len)
 }
 
 
+/**
+ *	\brief	Search begin of all lines in buffer
+ *
+ *	The first line always begins at offset 0. A line begins behind any sequence of CR/LF characters;
+ *	searching stops at the end of the buffer or at a line beginning with '\0'.
+ *	@param[in] 	str		buffer (total)
+ *	@param[in] 	len		buffer length in bytes
+ *	@param[out]	start	offsets of the beginning of all lines
+ *	@return		number of lines
+ */
+int string_index_lines(const char* str, int len, std::vector<int>& start)
+{
+	int i = 0;
+	bool eol = false;  // previous character is a line delimiter
+
+	start.clear();
+	if (len <= 0)
+	{
+		return 0;
+	}
+	start.push_back(0);
+
+#if defined(PARSE_SIMD_AVX2) || defined(PARSE_SIMD_SSE2)
+	unsigned int carry = 0;  // previous block ended with a line delimiter
+#if defined(PARSE_SIMD_AVX2)
+	const int nblock = 32;
+	const __m256i cr = _mm256_set1_epi8('\r');
+	const __m256i lf = _mm256_set1_epi8('\n');
+#else
+	const int nblock = 16;
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n');
+#endif
+
+	for (; i + nblock <= len; i += nblock)
+	{
+		unsigned int m, b;
+#if defined(PARSE_SIMD_AVX2)
+		__m256i v = _mm256_loadu_si256((const __m256i* )(str + i));
+		m = (unsigned int )_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf)));
+		b = ~m & ((m << 1) | carry);
+		carry = m >> 31;
+#else
+		__m128i v = _mm_loadu_si128((const __m128i* )(str + i));
+		m = (unsigned int )_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)));
+		b = ~m & ((m << 1) | carry) & 0xffff;
+		carry = (m >> 15) & 1;
+#endif
+		while (b)
+		{	// begin of new line found
+			int pos = i + parse_lowest_bit(b);
+			if (str[pos] == '\0')
+			{	// end of buffer
+				return (int )start.size();
+			}
+			start.push_back(pos);
+			b &= b - 1;
+		}
+	}
+	eol = (carry != 0);
+#endif
+
+	for (; i < len; i++)
+	{
+		if (parse_is_eol(str[i]))
+		{	// crlf
+			eol = true;
+		}
+		else
+		{
+			if (eol)
+			{	// begin of new line found
+				if (str[i] == '\0')
+				{	// end of buffer
+					break;
+				}
+				start.push_back(i);
+			}
+			eol = false;
+		}
+	}
+	return (int )start.size();
+}
+
+
 /**
  * 	\brief	Read next 'int' value from string
  *
@@ -65,6 +415,13 @@ char* string_nextline(char* str, char* start, int len)
 char* string_get_i(char* str, int* i)
 {
 	char* s;
+	unsigned int ui;
+	bool neg;
+	if ((s = parse_decimal_ui(str, &ui, &neg)) != NULL)
+	{	// fast path: plain decimal number
+		*i = neg ? -(int )ui : (int )ui;
+		return s;
+	}
 	*i = (int )strtol(str, &s, 0);
 	return (s == str) ? NULL : s;
 }
@@ -80,6 +437,11 @@ char* string_get_i(char* str, int* i)
 char* string_get_ui(char* str, unsigned int* ui)
 {
 	char* s;
+	bool neg;
+	if (((s = parse_decimal_ui(str, ui, &neg)) != NULL) && !neg)
+	{	// fast path: plain decimal number
+		return s;
+	}
 	*ui = (unsigned int )strtoul(str, &s, 0);
 	return (s == str) ? NULL : s;
 }
@@ -95,6 +457,10 @@ char* string_get_ui(char* str, unsigned int* ui)
 char* string_get_d(char* str, double* d)
 {
 	char* s;
+	if ((s = parse_decimal_d(str, d)) != NULL)
+	{	// fast path: exactly representable decimal number
+		return s;
+	}
 	*d = strtod(str, &s);
 	return (s == str) ? NULL : s;
 }
@@ -110,6 +476,12 @@ char* string_get_d(char* str, double* d)
 char* string_get_f(char* str, float* f)
 {
 	char* s;
+	double d;
+	if ((s = parse_decimal_d(str, &d)) != NULL)
+	{	// fast path: exactly representable decimal number
+		*f = (float )d;
+		return s;
+	}
 	*f = (float )strtod(str, &s);	// strtof() only available in GNU-C
 	return (s == str) ? NULL : s;
 }
@@ -127,18 +499,11 @@ char* string_get_f(char* str, float* f)
  */
 char* string_get_block(char* str, const char* fmt, int* idat, float* fdat, double *ddat)
 {
-	char* strend;
 	int index_i, index_f;
-	if ((str = strchr(str, '[')) == NULL)
+	if ((str = string_block_begin(str)) == NULL)
 	{       // search begin of block
 		return NULL;
 	}
-	if ((strend = strchr(str, ']')) == NULL)
-	{    // search end of block
-		return NULL;
-	}
-	str++;                               // remove delimiters
-	*strend = '\0';
 	index_i = index_f = 0;
 	while(*fmt)
 	{
@@ -147,32 +512,92 @@ char* string_get_block(char* str, const char* fmt, int* idat, float* fdat, doubl
 			case 'i':
 				if((str = string_get_i(str, &idat[index_i++])) == NULL)
 				{
-					*strend = ']';
 					return NULL;
 				}
 				break;
 			case 'f':
 				if((str = string_get_f(str, &fdat[index_f++])) == NULL)
 				{
-					*strend = ']';
 					return NULL;
 				}
 				break;
 			case 'd':
 				if((str = string_get_d(str, &ddat[index_f++])) == NULL)
 				{
-					*strend = ']';
 					return NULL;
 				}
 				break;
 			default:	// unknown format character
-				*strend = ']';
 				return NULL;
 		}
 	}
 	// ignore additional data inside the block
-	*strend = ']';
-	return strend + 1;
+	return string_block_end(str);
+}
+
+
+/**
+ * 	\brief	Search begin of next block '[...]' in string
+ *
+ *	@param[in] 	str		string
+ *	@return		pointer behind '['; NULL in case of error
+ */
+char* string_block_begin(char* str)
+{
+	while (*str != '[')
+	{
+		if (*str == '\0')
+		{
+			return NULL;
+		}
+		str++;
+	}
+	return str + 1;
+}
+
+
+/**
+ * 	\brief	Search end of current block '[...]' in string
+ *
+ *	Additional data inside the block is ignored.
+ *	@param[in] 	str		string (inside the block)
+ *	@return		pointer behind ']'; NULL in case of error
+ */
+char* string_block_end(char* str)
+{
+	while (*str != ']')
+	{
+		if (*str == '\0' || *str == '[')
+		{
+			return NULL;
+		}
+		str++;
+	}
+	return str + 1;
+}
+
+
+/**
+ * 	\brief	Skip next blocks '[...]' in string without reading their values
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	n		number of blocks
+ *	@return		pointer behind last block; NULL in case of error
+ */
+char* string_skip_blocks(char* str, int n)
+{
+	while (n-- > 0)
+	{
+		if ((str = string_block_begin(str)) == NULL)
+		{
+			return NULL;
+		}
+		if ((str = string_block_end(str)) == NULL)
+		{
+			return NULL;
+		}
+	}
+	return str;
 }
 
 
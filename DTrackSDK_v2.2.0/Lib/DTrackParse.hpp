@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <string>
+#include <vector>
 
 namespace DTrackSDK_Parse {
 
@@ -41,6 +42,19 @@ namespace DTrackSDK_Parse {
  */
 char* string_nextline(char* str, char* start, int len);
 
+/**
+ *	\brief	Search begin of all lines in buffer
+ *
+ *	The first line always begins at offset 0. A line begins behind any sequence of CR/LF characters;
+ *	searching stops at the end of the buffer or at a line beginning with '\0'.
+ *	Uses SSE2/AVX2 if available at compile time.
+ *	@param[in] 	str		buffer (total)
+ *	@param[in] 	len		buffer length in bytes
+ *	@param[out]	start	offsets of the beginning of all lines
+ *	@return		number of lines
+ */
+int string_index_lines(const char* str, int len, std::vector<int>& start);
+
 /**
  * 	\brief	Read next 'int' value from string
  *
@@ -81,7 +95,8 @@ char* string_get_f(char* str, float* f);
  * 	\brief Process next block '[...]' in string
  *
  *	@param[in] 	str		string
- *	@param[in] 	fmt		format string ('i' for 'int', 'f' for 'float')
+ *	Format is interpreted at runtime; for fixed formats prefer the template versions below.
+ *	@param[in] 	fmt		format string ('i' for 'int', 'f' for 'float', 'd' for 'double')
  *	@param[out] idat	array for 'int' values (long enough due to fmt)
  *	@param[out] fdat	array for 'float' values (long enough due to fmt)
  *	@param[out] ddat	array for 'double' values (long enough due to fmt)
@@ -89,6 +104,114 @@ char* string_get_f(char* str, float* f);
  */
 char* string_get_block(char* str, const char* fmt, int* idat = NULL, float* fdat = NULL, double *ddat = NULL);
 
+/**
+ * 	\brief	Search begin of next block '[...]' in string
+ *
+ *	@param[in] 	str		string
+ *	@return		pointer behind '['; NULL in case of error
+ */
+char* string_block_begin(char* str);
+
+/**
+ * 	\brief	Search end of current block '[...]' in string
+ *
+ *	Additional data inside the block is ignored.
+ *	@param[in] 	str		string (inside the block)
+ *	@return		pointer behind ']'; NULL in case of error
+ */
+char* string_block_end(char* str);
+
+/**
+ * 	\brief	Skip next blocks '[...]' in string without reading their values
+ *
+ *	@param[in] 	str		string
+ *	@param[in] 	n		number of blocks
+ *	@return		pointer behind last block; NULL in case of error
+ */
+char* string_skip_blocks(char* str, int n);
+
+/**
+ * 	\brief	Read next value from string, type selected at compile time
+ *
+ *	@param[in] 	str		string
+ *	@param[out] v		read value
+ *	@return		pointer behind read value in str; NULL in case of error
+ */
+inline char* string_get_value(char* str, int* v)          { return string_get_i(str, v); }
+inline char* string_get_value(char* str, unsigned int* v) { return string_get_ui(str, v); }
+inline char* string_get_value(char* str, double* v)       { return string_get_d(str, v); }
+inline char* string_get_value(char* str, float* v)        { return string_get_f(str, v); }
+
+/**
+ * 	\brief	Process next block '[...]' with N values of the same type in string
+ *
+ *	Format is fixed at compile time, the block is read in one pass.
+ *	@param[in] 	str		string
+ *	@param[out] dat		array for N values
+ *	@return 	pointer behind block in str; NULL in case of error
+ */
+template<int N, typename T>
+inline char* string_get_block(char* str, T* dat)
+{
+	if ((str = string_block_begin(str)) == NULL) return NULL;
+	for (int i = 0; i < N; i++)
+	{
+		if ((str = string_get_value(str, &dat[i])) == NULL) return NULL;
+	}
+	return string_block_end(str);
+}
+
+/**
+ * 	\brief	Process next block '[...]' with 2 to 6 values in string
+ *
+ *	Format is given by the types of the arguments, the block is read in one pass.
+ *	@param[in] 	str		string
+ *	@param[out] v1..v6	read values
+ *	@return 	pointer behind block in str; NULL in case of error
+ */
+template<typename T1, typename T2>
+inline char* string_get_block(char* str, T1* v1, T2* v2)
+{
+	if ((str = string_block_begin(str)) == NULL) return NULL;
+	if ((str = string_get_value(str, v1)) == NULL) return NULL;
+	if ((str = string_get_value(str, v2)) == NULL) return NULL;
+	return string_block_end(str);
+}
+
+template<typename T1, typename T2, typename T3>
+inline char* string_get_block(char* str, T1* v1, T2* v2, T3* v3)
+{
+	if ((str = string_block_begin(str)) == NULL) return NULL;
+	if ((str = string_get_value(str, v1)) == NULL) return NULL;
+	if ((str = string_get_value(str, v2)) == NULL) return NULL;
+	if ((str = string_get_value(str, v3)) == NULL) return NULL;
+	return string_block_end(str);
+}
+
+template<typename T1, typename T2, typename T3, typename T4>
+inline char* string_get_block(char* str, T1* v1, T2* v2, T3* v3, T4* v4)
+{
+	if ((str = string_block_begin(str)) == NULL) return NULL;
+	if ((str = string_get_value(str, v1)) == NULL) return NULL;
+	if ((str = string_get_value(str, v2)) == NULL) return NULL;
+	if ((str = string_get_value(str, v3)) == NULL) return NULL;
+	if ((str = string_get_value(str, v4)) == NULL) return NULL;
+	return string_block_end(str);
+}
+
+template<typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+inline char* string_get_block(char* str, T1* v1, T2* v2, T3* v3, T4* v4, T5* v5, T6* v6)
+{
+	if ((str = string_block_begin(str)) == NULL) return NULL;
+	if ((str = string_get_value(str, v1)) == NULL) return NULL;
+	if ((str = string_get_value(str, v2)) == NULL) return NULL;
+	if ((str = string_get_value(str, v3)) == NULL) return NULL;
+	if ((str = string_get_value(str, v4)) == NULL) return NULL;
+	if ((str = string_get_value(str, v5)) == NULL) return NULL;
+	if ((str = string_get_value(str, v6)) == NULL) return NULL;
+	return string_block_end(str);
+}
+
 /**
  * 	\brief	Read next 'word' value from string
  *
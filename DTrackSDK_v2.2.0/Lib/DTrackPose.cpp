@@ -0,0 +1,509 @@
+/* DTrackPose: C/C++ source file
+ *
+ * Functions for compact poses (location and unit quaternion)
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Version v2.2.0
+ */
+
+#include "DTrackPose.h"
+
+#include <math.h>
+
+using namespace DTrackSDK_Datatypes;
+
+namespace DTrackSDK_Pose {
+
+// ---------------------------------------------------------------------------------------------------
+// Internal functions:
+
+/**
+ * 	\brief	Convert rotation matrix (float or double) into unit quaternion.
+ *
+ *	Method of Shepperd: the largest of the four components is computed from the diagonal, the
+ *	others from sums or differences of the off-diagonal elements divided by it.
+ */
+template<class S>
+static void rot2quat(float quat[4], const S rot[9])
+{
+	S m00 = rot[0], m10 = rot[1], m20 = rot[2];
+	S m01 = rot[3], m11 = rot[4], m21 = rot[5];
+	S m02 = rot[6], m12 = rot[7], m22 = rot[8];
+	S tr = m00 + m11 + m22;
+	S w, x, y, z, f;
+
+	if (tr >= m00 && tr >= m11 && tr >= m22) {
+		w = (S )sqrt(1 + tr) * (S )0.5;
+		f = (w > 0) ? (S )0.25 / w : 0;
+		x = (m21 - m12) * f;
+		y = (m02 - m20) * f;
+		z = (m10 - m01) * f;
+	} else if (m00 >= m11 && m00 >= m22) {
+		x = (S )sqrt(1 + m00 - m11 - m22) * (S )0.5;
+		f = (S )0.25 / x;
+		w = (m21 - m12) * f;
+		y = (m01 + m10) * f;
+		z = (m02 + m20) * f;
+	} else if (m11 >= m22) {
+		y = (S )sqrt(1 - m00 + m11 - m22) * (S )0.5;
+		f = (S )0.25 / y;
+		w = (m02 - m20) * f;
+		x = (m01 + m10) * f;
+		z = (m12 + m21) * f;
+	} else {
+		z = (S )sqrt(1 - m00 - m11 + m22) * (S )0.5;
+		f = (S )0.25 / z;
+		w = (m10 - m01) * f;
+		x = (m02 + m20) * f;
+		y = (m12 + m21) * f;
+	}
+
+	S n = w * w + x * x + y * y + z * z;
+	if (!(n > 0)) {  // no rotation matrix at all
+		quat[0] = 1;
+		quat[1] = quat[2] = quat[3] = 0;
+		return;
+	}
+
+	n = (S )1 / (S )sqrt(n);
+	if (w < 0) {  // unique sign
+		n = -n;
+	}
+	quat[0] = (float )(w * n);
+	quat[1] = (float )(x * n);
+	quat[2] = (float )(y * n);
+	quat[3] = (float )(z * n);
+}
+
+/**
+ * 	\brief	Convert unit quaternion into rotation matrix (float or double).
+ */
+template<class D>
+static void quat2rot(D rot[9], const float quat[4])
+{
+	D w = quat[0], x = quat[1], y = quat[2], z = quat[3];
+	D xx = x * x, yy = y * y, zz = z * z;
+	D xy = x * y, xz = x * z, yz = y * z;
+	D wx = w * x, wy = w * y, wz = w * z;
+
+	rot[0] = 1 - 2 * (yy + zz);
+	rot[1] = 2 * (xy + wz);
+	rot[2] = 2 * (xz - wy);
+	rot[3] = 2 * (xy - wz);
+	rot[4] = 1 - 2 * (xx + zz);
+	rot[5] = 2 * (yz + wx);
+	rot[6] = 2 * (xz + wy);
+	rot[7] = 2 * (yz - wx);
+	rot[8] = 1 - 2 * (xx + yy);
+}
+
+/**
+ * 	\brief	Rotate position with unit quaternion.
+ *
+ *	Uses v' = v + w * t + q x t with t = 2 * (q x v) (cheaper than building the rotation matrix).
+ */
+static inline void quat_rotate(float res[3], const float quat[4], const float loc[3])
+{
+	float w = quat[0], qx = quat[1], qy = quat[2], qz = quat[3];
+	float x = loc[0], y = loc[1], z = loc[2];
+
+	float tx = 2 * (qy * z - qz * y);
+	float ty = 2 * (qz * x - qx * z);
+	float tz = 2 * (qx * y - qy * x);
+
+	res[0] = x + w * tx + (qy * tz - qz * ty);
+	res[1] = y + w * ty + (qz * tx - qx * tz);
+	res[2] = z + w * tz + (qx * ty - qy * tx);
+}
+
+/**
+ * 	\brief	Convert standard body data into compact pose (from float or double).
+ */
+template<class S>
+static void convert_pose_6d(DTrack_Body_Pose_Type& dst, const S& src)
+{
+	dst.id = src.id;
+	dst.quality = (float )src.quality;
+	if (src.quality < 0) {
+		pose_identity(dst.pose);
+	} else {
+		pose_set(dst.pose, src.loc, src.rot);
+	}
+}
+
+/**
+ * 	\brief	Convert Fingertracking hand data into compact poses (from float or double).
+ */
+template<class S>
+static void convert_pose_hand(DTrack_Hand_Pose_Type& dst, const S& src)
+{
+	bool tracked = (src.quality >= 0);
+
+	dst.id = src.id;
+	dst.quality = (float )src.quality;
+	dst.lr = src.lr;
+	dst.nfinger = src.nfinger;
+	if (tracked) {
+		pose_set(dst.pose, src.loc, src.rot);
+	} else {
+		pose_identity(dst.pose);
+	}
+	for (int j=0; j<DTRACK_HAND_MAX_FINGER; j++) {
+		if (tracked && (j < src.nfinger)) {
+			pose_set(dst.finger[j], src.finger[j].loc, src.finger[j].rot);
+		} else {
+			pose_identity(dst.finger[j]);
+		}
+	}
+}
+
+/**
+ * 	\brief	Convert human model data into compact poses (from float or double).
+ */
+template<class S>
+static void convert_pose_human(DTrack_Human_Pose_Type& dst, const S& src)
+{
+	dst.id = src.id;
+	dst.num_joints = src.num_joints;
+	for (int j=0; j<src.num_joints; j++) {
+		dst.joint[j].id = src.joint[j].id;
+		dst.joint[j].quality = (float )src.joint[j].quality;
+		if (src.joint[j].quality < 0) {
+			pose_identity(dst.joint[j].pose);
+		} else {
+			pose_set(dst.joint[j].pose, src.joint[j].loc, src.joint[j].rot);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------
+
+
+/**
+ * 	\brief	Convert rotation matrix into unit quaternion.
+ *
+ *	Numerically stable for all rotations (largest component is computed first). Small deviations of
+ *	the matrix from orthonormality are tolerated, the result is normalized. A matrix of zeros (not
+ *	tracked) gives the identity.
+ *	@param[out]	quat	unit quaternion (order: w, x, y, z; w >= 0)
+ *	@param[in]	rot		rotation matrix (column-wise)
+ */
+void quat_from_rot(float quat[4], const float rot[9])
+{
+	rot2quat(quat, rot);
+}
+
+void quat_from_rot(float quat[4], const double rot[9])
+{
+	rot2quat(quat, rot);
+}
+
+
+/**
+ * 	\brief	Convert unit quaternion into rotation matrix.
+ *
+ *	@param[out]	rot		rotation matrix (column-wise)
+ *	@param[in]	quat	unit quaternion (order: w, x, y, z)
+ */
+void quat_to_rot(float rot[9], const float quat[4])
+{
+	quat2rot(rot, quat);
+}
+
+void quat_to_rot(double rot[9], const float quat[4])
+{
+	quat2rot(rot, quat);
+}
+
+
+/**
+ * 	\brief	Multiply two quaternions.
+ *
+ *	Rotating with the result is the same as rotating with qin first and with qout afterwards.
+ *	@param[out]	qres	product qout * qin (might be the same as qout or qin)
+ *	@param[in]	qout	outer quaternion
+ *	@param[in]	qin		inner quaternion
+ */
+void quat_mult(float qres[4], const float qout[4], const float qin[4])
+{
+	float aw = qout[0], ax = qout[1], ay = qout[2], az = qout[3];
+	float bw = qin[0], bx = qin[1], by = qin[2], bz = qin[3];
+
+	qres[0] = aw * bw - ax * bx - ay * by - az * bz;
+	qres[1] = aw * bx + ax * bw + ay * bz - az * by;
+	qres[2] = aw * by - ax * bz + ay * bw + az * bx;
+	qres[3] = aw * bz + ax * by - ay * bx + az * bw;
+}
+
+
+/**
+ * 	\brief	Set compact pose.
+ *
+ *	@param[out]	pose	compact pose
+ *	@param[in]	loc		location
+ *	@param[in]	rot		rotation matrix (column-wise)
+ */
+void pose_set(DTrack_Pose_Type_f& pose, const float loc[3], const float rot[9])
+{
+	pose.loc[0] = loc[0];
+	pose.loc[1] = loc[1];
+	pose.loc[2] = loc[2];
+	rot2quat(pose.quat, rot);
+}
+
+void pose_set(DTrack_Pose_Type_f& pose, const double loc[3], const double rot[9])
+{
+	pose.loc[0] = (float )loc[0];
+	pose.loc[1] = (float )loc[1];
+	pose.loc[2] = (float )loc[2];
+	rot2quat(pose.quat, rot);
+}
+
+
+/**
+ * 	\brief	Set identity pose (no translation, no rotation).
+ *
+ *	@param[out]	pose	compact pose
+ */
+void pose_identity(DTrack_Pose_Type_f& pose)
+{
+	pose.loc[0] = pose.loc[1] = pose.loc[2] = 0;
+	pose.quat[0] = 1;
+	pose.quat[1] = pose.quat[2] = pose.quat[3] = 0;
+}
+
+
+/**
+ * 	\brief	Transform one position into another coordinate system.
+ *
+ *	@param[out]	locres	transformed position (might be the same as loc)
+ *	@param[in]	pose	pose of coordinate system
+ *	@param[in]	loc		position to transform
+ */
+void pose_transform(float locres[3], const DTrack_Pose_Type_f& pose, const float loc[3])
+{
+	float v[3];
+
+	quat_rotate(v, pose.quat, loc);
+
+	locres[0] = v[0] + pose.loc[0];
+	locres[1] = v[1] + pose.loc[1];
+	locres[2] = v[2] + pose.loc[2];
+}
+
+
+/**
+ * 	\brief	Transform several positions into another coordinate system.
+ *
+ *	The rotation matrix is computed once, so this is faster than pose_transform() for more than
+ *	two positions.
+ *	@param[out]	locres	transformed positions (3 * n values; might be the same as loc)
+ *	@param[in]	pose	pose of coordinate system
+ *	@param[in]	loc		positions to transform (3 * n values)
+ *	@param[in]	n		number of positions
+ */
+void pose_transform_n(float* locres, const DTrack_Pose_Type_f& pose, const float* loc, int n)
+{
+	float r[9];
+
+	quat2rot(r, pose.quat);
+
+	for (int i=0; i<n; i++) {
+		float x = loc[3*i], y = loc[3*i+1], z = loc[3*i+2];
+
+		locres[3*i]   = r[0] * x + r[3] * y + r[6] * z + pose.loc[0];
+		locres[3*i+1] = r[1] * x + r[4] * y + r[7] * z + pose.loc[1];
+		locres[3*i+2] = r[2] * x + r[5] * y + r[8] * z + pose.loc[2];
+	}
+}
+
+
+/**
+ * 	\brief	Compose two poses into one.
+ *
+ *	Transforming with the result is the same as transforming with the inner pose first and with the
+ *	outer pose afterwards (e.g. finger in hand and hand in room gives finger in room).
+ *	@param[out]	res		composed pose (might be the same as out or in)
+ *	@param[in]	out		outer pose
+ *	@param[in]	in		inner pose
+ */
+void pose_compose(DTrack_Pose_Type_f& res, const DTrack_Pose_Type_f& out, const DTrack_Pose_Type_f& in)
+{
+	float loc[3], quat[4];
+
+	pose_transform(loc, out, in.loc);
+	quat_mult(quat, out.quat, in.quat);
+
+	res.loc[0] = loc[0];
+	res.loc[1] = loc[1];
+	res.loc[2] = loc[2];
+	res.quat[0] = quat[0];
+	res.quat[1] = quat[1];
+	res.quat[2] = quat[2];
+	res.quat[3] = quat[3];
+}
+
+
+/**
+ * 	\brief	Compose one outer pose with several inner poses.
+ *
+ *	@param[out]	res		composed poses (n values; might be the same as in)
+ *	@param[in]	out		outer pose
+ *	@param[in]	in		inner poses (n values)
+ *	@param[in]	n		number of inner poses
+ */
+void pose_compose_n(DTrack_Pose_Type_f* res, const DTrack_Pose_Type_f& out, const DTrack_Pose_Type_f* in, int n)
+{
+	DTrack_Pose_Type_f o = out;  // res might overlap out
+	float r[9];
+
+	quat2rot(r, o.quat);
+
+	for (int i=0; i<n; i++) {
+		float x = in[i].loc[0], y = in[i].loc[1], z = in[i].loc[2];
+
+		res[i].loc[0] = r[0] * x + r[3] * y + r[6] * z + o.loc[0];
+		res[i].loc[1] = r[1] * x + r[4] * y + r[7] * z + o.loc[1];
+		res[i].loc[2] = r[2] * x + r[5] * y + r[8] * z + o.loc[2];
+		quat_mult(res[i].quat, o.quat, in[i].quat);
+	}
+}
+
+
+/**
+ * 	\brief	Invert pose.
+ *
+ *	Transforming with the result is the inverse transformation (e.g. room into body coordinates).
+ *	@param[out]	res		inverted pose (might be the same as pose)
+ *	@param[in]	pose	pose
+ */
+void pose_invert(DTrack_Pose_Type_f& res, const DTrack_Pose_Type_f& pose)
+{
+	float quat[4], loc[3];
+
+	quat[0] = pose.quat[0];
+	quat[1] = -pose.quat[1];
+	quat[2] = -pose.quat[2];
+	quat[3] = -pose.quat[3];
+	quat_rotate(loc, quat, pose.loc);
+
+	res.loc[0] = -loc[0];
+	res.loc[1] = -loc[1];
+	res.loc[2] = -loc[2];
+	res.quat[0] = quat[0];
+	res.quat[1] = quat[1];
+	res.quat[2] = quat[2];
+	res.quat[3] = quat[3];
+}
+
+/**
+ * 	\brief	Convert rotation quaternion into rotation vector (logarithm).
+ *
+ *	The shorter of the two equivalent rotations is taken (angle up to 180 deg).
+ *	@param[out]	rotvec	rotation vector (axis times angle in rad)
+ *	@param[in]	quat	unit quaternion (order: w, x, y, z)
+ */
+void quat_log(float rotvec[3], const float quat[4])
+{
+	double w = quat[0], x = quat[1], y = quat[2], z = quat[3];
+
+	if (w < 0) {  // same rotation, shorter way
+		w = -w;  x = -x;  y = -y;  z = -z;
+	}
+
+	double s = sqrt(x * x + y * y + z * z);
+	double f = (s > 1e-9) ? 2 * atan2(s, w) / s : 2 / w;  // small angles: sin(a/2) ~ a/2
+
+	rotvec[0] = (float )(x * f);
+	rotvec[1] = (float )(y * f);
+	rotvec[2] = (float )(z * f);
+}
+
+
+/**
+ * 	\brief	Convert rotation vector into rotation quaternion (exponential).
+ *
+ *	@param[out]	quat	unit quaternion (order: w, x, y, z)
+ *	@param[in]	rotvec	rotation vector (axis times angle in rad)
+ */
+void quat_exp(float quat[4], const float rotvec[3])
+{
+	double x = rotvec[0], y = rotvec[1], z = rotvec[2];
+	double a = sqrt(x * x + y * y + z * z);
+	double f = (a > 1e-9) ? sin(a / 2) / a : 0.5;
+
+	quat[0] = (float )cos(a / 2);
+	quat[1] = (float )(x * f);
+	quat[2] = (float )(y * f);
+	quat[3] = (float )(z * f);
+}
+
+
+/**
+ * 	\brief	Convert standard body data into compact pose.
+ *
+ *	Not tracked bodies get the identity pose.
+ *	@param[out]	dst		compact pose
+ *	@param[in]	src		standard body data
+ */
+void pose_convert(DTrack_Body_Pose_Type& dst, const DTrack_Body_Type_f& src)
+{
+	convert_pose_6d(dst, src);
+}
+
+void pose_convert(DTrack_Body_Pose_Type& dst, const DTrack_Body_Type_d& src)
+{
+	convert_pose_6d(dst, src);
+}
+
+
+/**
+ * 	\brief	Convert Fingertracking hand data into compact poses.
+ *
+ *	Not tracked hands and fingers not available get the identity pose.
+ *	@param[out]	dst		compact poses
+ *	@param[in]	src		Fingertracking hand data
+ */
+void pose_convert(DTrack_Hand_Pose_Type& dst, const DTrack_Hand_Type_f& src)
+{
+	convert_pose_hand(dst, src);
+}
+
+void pose_convert(DTrack_Hand_Pose_Type& dst, const DTrack_Hand_Type_d& src)
+{
+	convert_pose_hand(dst, src);
+}
+
+
+/**
+ * 	\brief	Convert human model data into compact poses.
+ *
+ *	Not tracked joints get the identity pose.
+ *	@param[out]	dst		compact poses
+ *	@param[in]	src		human model data
+ */
+void pose_convert(DTrack_Human_Pose_Type& dst, const DTrack_Human_Type_f& src)
+{
+	convert_pose_human(dst, src);
+}
+
+void pose_convert(DTrack_Human_Pose_Type& dst, const DTrack_Human_Type_d& src)
+{
+	convert_pose_human(dst, src);
+}
+
+} // end namespace
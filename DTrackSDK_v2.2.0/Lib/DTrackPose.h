@@ -0,0 +1,189 @@
+/* DTrackPose: C header file
+ *
+ * Functions for compact poses (location and unit quaternion)
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Version v2.2.0
+ */
+
+#ifndef _ART_DTRACKPOSE_H_
+#define _ART_DTRACKPOSE_H_
+
+#include "DTrackDataTypes.h"
+
+namespace DTrackSDK_Pose {
+
+using DTrackSDK_Datatypes::DTrack_Pose_Type_f;
+using DTrackSDK_Datatypes::DTrack_Body_Type_f;
+using DTrackSDK_Datatypes::DTrack_Body_Type_d;
+using DTrackSDK_Datatypes::DTrack_Body_Pose_Type;
+using DTrackSDK_Datatypes::DTrack_Hand_Type_f;
+using DTrackSDK_Datatypes::DTrack_Hand_Type_d;
+using DTrackSDK_Datatypes::DTrack_Hand_Pose_Type;
+using DTrackSDK_Datatypes::DTrack_Human_Type_f;
+using DTrackSDK_Datatypes::DTrack_Human_Type_d;
+using DTrackSDK_Datatypes::DTrack_Human_Pose_Type;
+
+/**
+ * 	\brief	Convert rotation matrix into unit quaternion.
+ *
+ *	Numerically stable for all rotations (largest component is computed first). Small deviations of
+ *	the matrix from orthonormality are tolerated, the result is normalized. A matrix of zeros (not
+ *	tracked) gives the identity.
+ *	@param[out]	quat	unit quaternion (order: w, x, y, z; w >= 0)
+ *	@param[in]	rot		rotation matrix (column-wise)
+ */
+void quat_from_rot(float quat[4], const float rot[9]);
+void quat_from_rot(float quat[4], const double rot[9]);  //!< see quat_from_rot()
+
+/**
+ * 	\brief	Convert unit quaternion into rotation matrix.
+ *
+ *	@param[out]	rot		rotation matrix (column-wise)
+ *	@param[in]	quat	unit quaternion (order: w, x, y, z)
+ */
+void quat_to_rot(float rot[9], const float quat[4]);
+void quat_to_rot(double rot[9], const float quat[4]);  //!< see quat_to_rot()
+
+/**
+ * 	\brief	Multiply two quaternions.
+ *
+ *	Rotating with the result is the same as rotating with qin first and with qout afterwards.
+ *	@param[out]	qres	product qout * qin (might be the same as qout or qin)
+ *	@param[in]	qout	outer quaternion
+ *	@param[in]	qin		inner quaternion
+ */
+void quat_mult(float qres[4], const float qout[4], const float qin[4]);
+
+/**
+ * 	\brief	Set compact pose.
+ *
+ *	@param[out]	pose	compact pose
+ *	@param[in]	loc		location
+ *	@param[in]	rot		rotation matrix (column-wise)
+ */
+void pose_set(DTrack_Pose_Type_f& pose, const float loc[3], const float rot[9]);
+void pose_set(DTrack_Pose_Type_f& pose, const double loc[3], const double rot[9]);  //!< see pose_set()
+
+/**
+ * 	\brief	Set identity pose (no translation, no rotation).
+ *
+ *	@param[out]	pose	compact pose
+ */
+void pose_identity(DTrack_Pose_Type_f& pose);
+
+/**
+ * 	\brief	Transform one position into another coordinate system.
+ *
+ *	@param[out]	locres	transformed position (might be the same as loc)
+ *	@param[in]	pose	pose of coordinate system
+ *	@param[in]	loc		position to transform
+ */
+void pose_transform(float locres[3], const DTrack_Pose_Type_f& pose, const float loc[3]);
+
+/**
+ * 	\brief	Transform several positions into another coordinate system.
+ *
+ *	The rotation matrix is computed once, so this is faster than pose_transform() for more than
+ *	two positions.
+ *	@param[out]	locres	transformed positions (3 * n values; might be the same as loc)
+ *	@param[in]	pose	pose of coordinate system
+ *	@param[in]	loc		positions to transform (3 * n values)
+ *	@param[in]	n		number of positions
+ */
+void pose_transform_n(float* locres, const DTrack_Pose_Type_f& pose, const float* loc, int n);
+
+/**
+ * 	\brief	Compose two poses into one.
+ *
+ *	Transforming with the result is the same as transforming with the inner pose first and with the
+ *	outer pose afterwards (e.g. finger in hand and hand in room gives finger in room).
+ *	@param[out]	res		composed pose (might be the same as out or in)
+ *	@param[in]	out		outer pose
+ *	@param[in]	in		inner pose
+ */
+void pose_compose(DTrack_Pose_Type_f& res, const DTrack_Pose_Type_f& out, const DTrack_Pose_Type_f& in);
+
+/**
+ * 	\brief	Compose one outer pose with several inner poses.
+ *
+ *	@param[out]	res		composed poses (n values; might be the same as in)
+ *	@param[in]	out		outer pose
+ *	@param[in]	in		inner poses (n values)
+ *	@param[in]	n		number of inner poses
+ */
+void pose_compose_n(DTrack_Pose_Type_f* res, const DTrack_Pose_Type_f& out, const DTrack_Pose_Type_f* in, int n);
+
+/**
+ * 	\brief	Invert pose.
+ *
+ *	Transforming with the result is the inverse transformation (e.g. room into body coordinates).
+ *	@param[out]	res		inverted pose (might be the same as pose)
+ *	@param[in]	pose	pose
+ */
+void pose_invert(DTrack_Pose_Type_f& res, const DTrack_Pose_Type_f& pose);
+
+/**
+ * 	\brief	Convert rotation quaternion into rotation vector (logarithm).
+ *
+ *	The shorter of the two equivalent rotations is taken (angle up to 180 deg).
+ *	@param[out]	rotvec	rotation vector (axis times angle in rad)
+ *	@param[in]	quat	unit quaternion (order: w, x, y, z)
+ */
+void quat_log(float rotvec[3], const float quat[4]);
+
+/**
+ * 	\brief	Convert rotation vector into rotation quaternion (exponential).
+ *
+ *	@param[out]	quat	unit quaternion (order: w, x, y, z)
+ *	@param[in]	rotvec	rotation vector (axis times angle in rad)
+ */
+void quat_exp(float quat[4], const float rotvec[3]);
+
+/**
+ * 	\brief	Convert standard body data into compact pose.
+ *
+ *	Not tracked bodies get the identity pose.
+ *	@param[out]	dst		compact pose
+ *	@param[in]	src		standard body data
+ */
+void pose_convert(DTrack_Body_Pose_Type& dst, const DTrack_Body_Type_f& src);
+void pose_convert(DTrack_Body_Pose_Type& dst, const DTrack_Body_Type_d& src);  //!< see pose_convert()
+
+/**
+ * 	\brief	Convert Fingertracking hand data into compact poses.
+ *
+ *	Not tracked hands and fingers not available get the identity pose.
+ *	@param[out]	dst		compact poses
+ *	@param[in]	src		Fingertracking hand data
+ */
+void pose_convert(DTrack_Hand_Pose_Type& dst, const DTrack_Hand_Type_f& src);
+void pose_convert(DTrack_Hand_Pose_Type& dst, const DTrack_Hand_Type_d& src);  //!< see pose_convert()
+
+/**
+ * 	\brief	Convert human model data into compact poses.
+ *
+ *	Not tracked joints get the identity pose.
+ *	@param[out]	dst		compact poses
+ *	@param[in]	src		human model data
+ */
+void pose_convert(DTrack_Human_Pose_Type& dst, const DTrack_Human_Type_f& src);
+void pose_convert(DTrack_Human_Pose_Type& dst, const DTrack_Human_Type_d& src);  //!< see pose_convert()
+
+} // end namespace
+
+#endif /* _ART_DTRACKPOSE_H_ */
@@ -0,0 +1,813 @@
+/* DTrackShm: C/C++ source file
+ *
+ * Functions for handing over tracking data to other processes through shared memory
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Version v2.2.0
+ */
+
+#include "DTrackShm.h"
+#include "DTrackThread.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef OS_UNIX
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+#ifdef OS_LINUX
+	#include <errno.h>
+	#include <limits.h>
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+#endif
+
+#define SHM_MAX_NAME      128         // maximum length of name of shared memory
+#define SHM_ALIGN          64         // alignment of header and slots (cache line)
+#define SHM_POLL_US       100         // waiting without futex: polling interval in us
+#define SHM_CHECK_S       0.1         // reader: min interval of checks for a replaced shared memory in s
+#define SHM_PACKET_MAGIC  0x50545444  // packet ring: 'DTTP'
+#define SHM_FRAME_MAGIC   0x46545444  // frame ring: 'DTTF'
+
+using namespace DTrackSDK_Net;
+using namespace DTrackSDK_Thread;
+
+// internal type of mapped shared memory
+struct _shm_struct {
+	char* addr;					// begin of mapping
+	size_t size;				// size of mapping
+	int writer;					// mapped by writer (otherwise read-only)?
+	char name[SHM_MAX_NAME];	// name of shared memory (as used by OS)
+#ifdef OS_UNIX
+	dev_t dev;					// device of shared memory object (to detect a replaced one)
+	ino_t ino;					// inode of shared memory object
+#endif
+#ifdef OS_WIN
+	HANDLE handle;				// file mapping
+#endif
+	double checktime;			// reader: time of last check for a replaced shared memory
+	int next;					// reader: number of next packet to be read (frames: number of frames already seen)
+	volatile int* seq;			// frame reader: sequence lock of frame returned last
+	int seqval;					// frame reader: value of sequence lock when frame was returned
+};
+
+// header of packet ring (at begin of shared memory)
+struct _shm_packet_header {
+	int magic;				// SHM_PACKET_MAGIC
+	int nslot;				// number of slots
+	int slotlen;			// max length of packet
+	int slotsize;			// distance of slots (slot header, packet, padding)
+	volatile int count;		// number of packets written so far (futex word for waiting readers)
+	volatile int closed;	// writer has detached?
+};
+
+// header of frame ring (at begin of shared memory)
+struct _shm_frame_header {
+	int magic;				// SHM_FRAME_MAGIC
+	int nslot;				// number of slots
+	int framesize;			// size of frame
+	int slotsize;			// distance of slots (sequence lock, frame, padding)
+	volatile int count;		// number of frames written so far (futex word for waiting readers)
+	volatile int closed;	// writer has detached?
+};
+
+// header of slot in packet ring (followed by packet data)
+struct _shm_packet_slot {
+	volatile int seq;		// sequence lock: odd while slot is written
+	int num;				// number of packet
+	int len;				// length of packet
+	double rxtime;			// receive timestamp of packet
+};
+
+namespace DTrackSDK_Shm {
+
+// ---------------------------------------------------------------------------------------------------
+// Mapping shared memory:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Map shared memory.
+ *
+ *	@param[out]	m		mapping
+ *	@param[in]	name	name of shared memory
+ *	@param[in]	size	size to be created (writer), 0 to map existing shared memory read-only (reader)
+ *	@return	0 if ok, <0 if error occured (-1 shared memory doesn't exist)
+ */
+static int shm_map(struct _shm_struct* m, const char* name, size_t size)
+{
+	m->writer = (size > 0);
+	m->next = 0;
+	m->seq = NULL;
+	m->seqval = 0;
+	m->checktime = 0;
+	if (strlen(name) + 8 > SHM_MAX_NAME)
+	{
+		return -3;
+	}
+#ifdef OS_UNIX
+	int fd;
+	struct stat st;
+	sprintf(m->name, "/%s", name);
+	if (m->writer)
+	{	// replace existing shared memory (readers still attached keep the old one)
+		shm_unlink(m->name);
+		fd = shm_open(m->name, O_RDWR | O_CREAT | O_EXCL, 0644);
+		if (fd < 0)
+		{
+			return -2;
+		}
+		if ((ftruncate(fd, size) < 0) || (fstat(fd, &st) < 0))
+		{
+			close(fd);
+			shm_unlink(m->name);
+			return -2;
+		}
+	}
+	else
+	{
+		fd = shm_open(m->name, O_RDONLY, 0);
+		if (fd < 0)
+		{
+			return -1;
+		}
+		if ((fstat(fd, &st) < 0) || (st.st_size <= 0))
+		{
+			close(fd);
+			return -2;
+		}
+		size = st.st_size;
+	}
+	m->dev = st.st_dev;
+	m->ino = st.st_ino;
+	m->addr = (char* )mmap(NULL, size, m->writer ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (m->addr == (char* )MAP_FAILED)
+	{
+		if (m->writer)
+		{
+			shm_unlink(m->name);
+		}
+		return -2;
+	}
+#endif
+#ifdef OS_WIN
+	MEMORY_BASIC_INFORMATION mbi;
+	sprintf(m->name, "Local\\%s", name);
+	if (m->writer)
+	{	// an existing mapping can't be replaced while in use
+		m->handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+				(DWORD )((unsigned long long )size >> 32), (DWORD )size, m->name);
+		if ((m->handle != NULL) && (GetLastError() == ERROR_ALREADY_EXISTS))
+		{
+			CloseHandle(m->handle);
+			return -2;
+		}
+	}
+	else
+	{
+		m->handle = OpenFileMappingA(FILE_MAP_READ, FALSE, m->name);
+		if (m->handle == NULL)
+		{
+			return -1;
+		}
+	}
+	if (m->handle == NULL)
+	{
+		return -2;
+	}
+	m->addr = (char* )MapViewOfFile(m->handle, m->writer ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size);
+	if (m->addr == NULL)
+	{
+		CloseHandle(m->handle);
+		return -2;
+	}
+	if (!m->writer)
+	{
+		VirtualQuery(m->addr, &mbi, sizeof(mbi));
+		size = mbi.RegionSize;
+	}
+#endif
+	m->size = size;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Unmap shared memory.
+ *
+ *	@param[in]	m	mapping
+ *	@return	0 ok, -1 error
+ */
+static int shm_unmap(struct _shm_struct* m)
+{
+	int err = 0;
+#ifdef OS_UNIX
+	err = munmap(m->addr, m->size);
+	if (m->writer)
+	{
+		shm_unlink(m->name);
+	}
+#endif
+#ifdef OS_WIN
+	if (!UnmapViewOfFile(m->addr))
+	{
+		err = -1;
+	}
+	CloseHandle(m->handle);
+#endif
+	if (err < 0)
+	{
+		return -1;
+	}
+	return 0;
+}
+
+
+/**
+ * 	\brief	Check if shared memory was replaced by a new writer (reader side).
+ *
+ *	A writer that terminated without closing (e.g. crashed) leaves its readers attached to a shared
+ *	memory nobody writes to any more; a new writer with the same name replaces it. Checks the name
+ *	at most every SHM_CHECK_S.
+ *	@param[in]	m	mapping
+ *	@return	replaced? (the reader has to attach again)
+ */
+static bool shm_replaced(struct _shm_struct* m)
+{
+	double t = net_clock();
+	if ((t >= m->checktime) && (t < m->checktime + SHM_CHECK_S))
+	{
+		return false;
+	}
+	m->checktime = t;
+#ifdef OS_UNIX
+	int fd;
+	struct stat st;
+	bool replaced;
+	fd = shm_open(m->name, O_RDONLY, 0);
+	if (fd < 0)
+	{	// no new writer yet
+		return false;
+	}
+	replaced = (fstat(fd, &st) == 0) && ((st.st_dev != m->dev) || (st.st_ino != m->ino));
+	close(fd);
+	return replaced;
+#else
+	return false;  // Windows: a new writer can't replace a mapping still in use (see shm_map())
+#endif
+}
+
+
+/**
+ * 	\brief	Wait until a value in shared memory might have changed.
+ *
+ *	May return early (spurious wakeup), the caller has to check the value again.
+ *	@param[in]	addr	address of value
+ *	@param[in]	value	current value
+ *	@param[in]	tout_us	max time to wait in us (micro sec)
+ */
+static void shm_wait(volatile int* addr, int value, int tout_us)
+{
+#ifdef OS_LINUX
+	struct timespec ts;
+	ts.tv_sec = tout_us / 1000000;
+	ts.tv_nsec = (tout_us % 1000000) * 1000;
+	syscall(SYS_futex, addr, FUTEX_WAIT, value, &ts, NULL, 0);
+#else
+	if (tout_us > SHM_POLL_US)
+	{
+		tout_us = SHM_POLL_US;
+	}
+#ifdef OS_UNIX
+	usleep(tout_us);
+#endif
+#ifdef OS_WIN
+	Sleep(1);  // 1 ms resolution
+#endif
+#endif
+}
+
+
+/**
+ * 	\brief	Wake up all readers waiting for a value in shared memory.
+ *
+ *	@param[in]	addr	address of value
+ */
+static void shm_wake(volatile int* addr)
+{
+#ifdef OS_LINUX
+	syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+	(void )addr;  // readers are polling
+#endif
+}
+
+
+/**
+ * 	\brief	Wait until a counter in shared memory differs from a value.
+ *
+ *	@param[in]	counter	address of counter
+ *	@param[in]	value	value to differ from
+ *	@param[in]	closed	address of flag for closed shared memory
+ *	@param[in]	tout_us	timeout in us (micro sec)
+ *	@return	0 if ok, -1 if timeout, -2 if shared memory closed
+ */
+static int shm_wait_counter(volatile int* counter, int value, volatile int* closed, int tout_us)
+{
+	double deadline = net_clock() + tout_us * 1e-6;
+	int remain;
+	while (atomic_load(counter) == value)
+	{
+		if (atomic_load(closed))
+		{
+			return -2;
+		}
+		remain = (int )((deadline - net_clock()) * 1e6);
+		if (remain <= 0)
+		{
+			return -1;
+		}
+		shm_wait(counter, value, remain);
+	}
+	return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------
+// Ring of packets:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Get slot of packet ring.
+ */
+static struct _shm_packet_slot* packet_slot(struct _shm_struct* m, unsigned int num)
+{
+	struct _shm_packet_header* h = (struct _shm_packet_header *)m->addr;
+	return (struct _shm_packet_slot *)(m->addr + SHM_ALIGN + (num % (unsigned int )h->nslot) * h->slotsize);
+}
+
+
+/**
+ * 	\brief	Create ring of packets in shared memory (writer side).
+ *
+ *	Replaces an existing ring with the same name (e.g. left by a crashed writer). Readers attached
+ *	to the replaced ring notice this at their next timeout and have to attach again (see
+ *	shm_packet_receive_batch()). On Windows, creating fails instead as long as readers are attached.
+ *	@param[out]	ring	ring handle
+ *	@param[in]	name	name of shared memory (POSIX: without leading '/'; Windows: in 'Local\' namespace)
+ *	@param[in]	nslot	number of packets kept in the ring
+ *	@param[in]	slotlen	max length of one packet
+ *	@return	0 if ok, <0 if error occured
+ */
+int shm_packet_create(void** ring, const char* name, int nslot, int slotlen)
+{
+	struct _shm_struct* m;
+	struct _shm_packet_header* h;
+	int err, slotsize;
+	if ((nslot <= 0) || (slotlen <= 0))
+	{
+		return -3;
+	}
+	m = (struct _shm_struct *)malloc(sizeof(struct _shm_struct));
+	if (m == NULL)
+	{
+		return -11;
+	}
+	slotsize = (sizeof(struct _shm_packet_slot) + slotlen + SHM_ALIGN - 1) / SHM_ALIGN * SHM_ALIGN;
+	err = shm_map(m, name, SHM_ALIGN + (size_t )nslot * slotsize);
+	if (err)
+	{
+		free(m);
+		return err;
+	}
+	h = (struct _shm_packet_header *)m->addr;
+	h->nslot = nslot;
+	h->slotlen = slotlen;
+	h->slotsize = slotsize;
+	h->count = 0;
+	h->closed = 0;
+	atomic_store(&h->magic, SHM_PACKET_MAGIC);  // ring is valid now
+	*ring = m;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Attach to ring of packets in shared memory (reader side).
+ *
+ *	The ring is mapped read-only, readers don't influence the writer or other readers.
+ *	Reading starts with the next packet written after attaching.
+ *	@param[out]	ring	ring handle
+ *	@param[in]	name	name of shared memory (see shm_packet_create())
+ *	@return	0 if ok, <0 if error occured (-1 ring doesn't exist)
+ */
+int shm_packet_open(void** ring, const char* name)
+{
+	struct _shm_struct* m;
+	struct _shm_packet_header* h;
+	int err;
+	m = (struct _shm_struct *)malloc(sizeof(struct _shm_struct));
+	if (m == NULL)
+	{
+		return -11;
+	}
+	err = shm_map(m, name, 0);
+	if (err)
+	{
+		free(m);
+		return err;
+	}
+	h = (struct _shm_packet_header *)m->addr;
+	if ((m->size < SHM_ALIGN) || (atomic_load(&h->magic) != SHM_PACKET_MAGIC)
+			|| (m->size < SHM_ALIGN + (size_t )h->nslot * h->slotsize))
+	{	// no packet ring (or not yet initialized)
+		shm_unmap(m);
+		free(m);
+		return -2;
+	}
+	m->next = atomic_load(&h->count);
+	*ring = m;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Detach from ring of packets.
+ *
+ *	The writer marks the ring as closed and removes its name.
+ *	@param[in]	ring	ring handle
+ *	@return	0 ok, -1 error
+ */
+int shm_packet_close(void* ring)
+{
+	int err;
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	if (ring == NULL)
+	{
+		return 0;
+	}
+	if (m->writer)
+	{
+		struct _shm_packet_header* h = (struct _shm_packet_header *)m->addr;
+		atomic_store(&h->closed, 1);
+		shm_wake(&h->count);
+	}
+	err = shm_unmap(m);
+	free(ring);
+	return err;
+}
+
+
+/**
+ * 	\brief	Write packet into ring (writer side).
+ *
+ *	Never blocks, overwrites the oldest packet. Wakes up waiting readers (one syscall on Linux,
+ *	independent of the number of readers).
+ *	@param[in]	ring	ring handle
+ *	@param[in]	data	packet data
+ *	@param[in]	len		length of packet (truncated to slotlen)
+ *	@param[in]	rxtime	receive timestamp of packet in s (see DTrackSDK_Net::udp_receive())
+ */
+void shm_packet_write(void* ring, const void* data, int len, double rxtime)
+{
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	struct _shm_packet_header* h = (struct _shm_packet_header *)m->addr;
+	int num = h->count;  // only changed by this writer
+	struct _shm_packet_slot* s = packet_slot(m, num);
+	int seq = s->seq;
+	if (len > h->slotlen)
+	{
+		len = h->slotlen;
+	}
+	atomic_store(&s->seq, seq + 1);  // odd: slot is written
+	s->num = num;
+	s->len = len;
+	s->rxtime = rxtime;
+	memcpy((char* )s + sizeof(struct _shm_packet_slot), data, len);
+	atomic_store(&s->seq, seq + 2);
+	atomic_store(&h->count, (int )((unsigned int )num + 1));
+	shm_wake(&h->count);
+}
+
+
+/**
+ *	\brief	Receive all packets written since the last call at once (reader side).
+ *
+ *	Same semantics as DTrackSDK_Net::udp_receive_batch(). Needs no syscall if packets are available,
+ *	waiting uses a futex on Linux and polling on other systems. Packets overwritten before they
+ *	were read are lost.
+ *	@param[in]	ring	ring handle
+ *	@param[out] buffer 	buffer for packet data, consists of nslot slots of slotlen bytes each
+ *	@param[in] 	slotlen	length of one slot
+ *	@param[in] 	nslot	number of slots
+ *	@param[out] len		number of received bytes per slot, -4 if packet didn't fit into its slot
+ *	@param[in]  tout_us timeout in us (micro sec)
+ *	@param[out]	rxtime	receive timestamp per slot in s (optional)
+ *	@return	number of received packets (oldest first), -1 if timeout, -2 if ring closed or replaced by the writer
+ */
+int shm_packet_receive_batch(void* ring, void *buffer, int slotlen, int nslot, int* len, int tout_us, double* rxtime)
+{
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	struct _shm_packet_header* h = (struct _shm_packet_header *)m->addr;
+	struct _shm_packet_slot* s;
+	int n, err, count, seq, num, plen;
+	double t;
+	while (1)
+	{
+		// waiting for data:
+		err = shm_wait_counter(&h->count, m->next, &h->closed, tout_us);
+		if ((err == -1) && shm_replaced(m))
+		{	// writer terminated without closing, a new one has started
+			err = -2;
+		}
+		if (err)
+		{
+			return err;
+		}
+		count = atomic_load(&h->count);
+		if ((unsigned int )count - (unsigned int )m->next > (unsigned int )h->nslot)
+		{	// reader too slow: older packets are overwritten already
+			m->next = (int )((unsigned int )count - h->nslot);
+		}
+		// reading packets:
+		n = 0;
+		while ((n < nslot) && (m->next != count))
+		{
+			s = packet_slot(m, m->next);
+			seq = atomic_load(&s->seq);
+			if (!(seq & 1))
+			{
+				num = s->num;
+				plen = s->len;
+				t = s->rxtime;
+				if ((num == m->next) && (plen < slotlen))
+				{
+					memcpy((char* )buffer + n * slotlen, (char* )s + sizeof(struct _shm_packet_slot), plen);
+				}
+				atomic_fence();
+				if ((num == m->next) && (atomic_load(&s->seq) == seq))
+				{	// slot not overwritten while reading
+					len[n] = (plen < slotlen) ? plen : -4;
+					if (rxtime != NULL)
+					{
+						rxtime[n] = t;
+					}
+					n++;
+				}
+			}
+			m->next = (int )((unsigned int )m->next + 1);
+		}
+		if (n > 0)
+		{
+			return n;
+		}
+		// all packets lost: wait for next one
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------
+// Ring of frames:
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * 	\brief	Get sequence lock of slot in frame ring (followed by frame data at SHM_ALIGN).
+ */
+static volatile int* frame_slot(struct _shm_struct* m, unsigned int num)
+{
+	struct _shm_frame_header* h = (struct _shm_frame_header *)m->addr;
+	return (volatile int *)(m->addr + SHM_ALIGN + (num % (unsigned int )h->nslot) * h->slotsize);
+}
+
+
+/**
+ * 	\brief	Create ring of frames in shared memory (writer side).
+ *
+ *	Frames are blocks of fixed size, the ring keeps the newest nslot frames. Replaces an existing
+ *	ring with the same name (see shm_packet_create()).
+ *	@param[out]	ring		ring handle
+ *	@param[in]	name		name of shared memory (see shm_packet_create())
+ *	@param[in]	nslot		number of frames kept in the ring
+ *	@param[in]	framesize	size of one frame in bytes
+ *	@return	0 if ok, <0 if error occured
+ */
+int shm_frame_create(void** ring, const char* name, int nslot, int framesize)
+{
+	struct _shm_struct* m;
+	struct _shm_frame_header* h;
+	int err, slotsize;
+	if ((nslot < 2) || (framesize <= 0))
+	{
+		return -3;
+	}
+	m = (struct _shm_struct *)malloc(sizeof(struct _shm_struct));
+	if (m == NULL)
+	{
+		return -11;
+	}
+	slotsize = SHM_ALIGN + (framesize + SHM_ALIGN - 1) / SHM_ALIGN * SHM_ALIGN;
+	err = shm_map(m, name, SHM_ALIGN + (size_t )nslot * slotsize);
+	if (err)
+	{
+		free(m);
+		return err;
+	}
+	h = (struct _shm_frame_header *)m->addr;
+	h->nslot = nslot;
+	h->framesize = framesize;
+	h->slotsize = slotsize;
+	h->count = 0;
+	h->closed = 0;
+	atomic_store(&h->magic, SHM_FRAME_MAGIC);  // ring is valid now
+	*ring = m;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Attach to ring of frames in shared memory (reader side).
+ *
+ *	The ring is mapped read-only.
+ *	@param[out]	ring	ring handle
+ *	@param[in]	name	name of shared memory
+ *	@return	0 if ok, <0 if error occured (-1 ring doesn't exist)
+ */
+int shm_frame_open(void** ring, const char* name)
+{
+	struct _shm_struct* m;
+	struct _shm_frame_header* h;
+	int err;
+	m = (struct _shm_struct *)malloc(sizeof(struct _shm_struct));
+	if (m == NULL)
+	{
+		return -11;
+	}
+	err = shm_map(m, name, 0);
+	if (err)
+	{
+		free(m);
+		return err;
+	}
+	h = (struct _shm_frame_header *)m->addr;
+	if ((m->size < SHM_ALIGN) || (atomic_load(&h->magic) != SHM_FRAME_MAGIC)
+			|| (m->size < SHM_ALIGN + (size_t )h->nslot * h->slotsize))
+	{	// no frame ring (or not yet initialized)
+		shm_unmap(m);
+		free(m);
+		return -2;
+	}
+	*ring = m;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Detach from ring of frames.
+ *
+ *	The writer marks the ring as closed and removes its name.
+ *	@param[in]	ring	ring handle
+ *	@return	0 ok, -1 error
+ */
+int shm_frame_close(void* ring)
+{
+	int err;
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	if (ring == NULL)
+	{
+		return 0;
+	}
+	if (m->writer)
+	{
+		struct _shm_frame_header* h = (struct _shm_frame_header *)m->addr;
+		atomic_store(&h->closed, 1);
+		shm_wake(&h->count);
+	}
+	err = shm_unmap(m);
+	free(ring);
+	return err;
+}
+
+
+/**
+ * 	\brief	Get size of one frame.
+ *
+ *	@param[in]	ring	ring handle
+ *	@return	size in bytes
+ */
+int shm_frame_size(void* ring)
+{
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	return ((struct _shm_frame_header *)m->addr)->framesize;
+}
+
+
+/**
+ * 	\brief	Begin to write next frame (writer side).
+ *
+ *	The frame is published by shm_frame_commit(). Overwrites the oldest frame.
+ *	@param[in]	ring	ring handle
+ *	@return	memory of frame (framesize bytes, 64 byte aligned)
+ */
+void* shm_frame_begin(void* ring)
+{
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	struct _shm_frame_header* h = (struct _shm_frame_header *)m->addr;
+	volatile int* seq = frame_slot(m, h->count);  // count only changed by this writer
+	atomic_store(seq, *seq + 1);  // odd: slot is written
+	return (char* )seq + SHM_ALIGN;
+}
+
+
+/**
+ * 	\brief	Publish frame started by shm_frame_begin() (writer side).
+ *
+ *	Wakes up waiting readers (one syscall on Linux, independent of the number of readers).
+ *	@param[in]	ring	ring handle
+ */
+void shm_frame_commit(void* ring)
+{
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	struct _shm_frame_header* h = (struct _shm_frame_header *)m->addr;
+	volatile int* seq = frame_slot(m, h->count);
+	atomic_store(seq, *seq + 1);  // even: slot is complete
+	atomic_store(&h->count, (int )((unsigned int )h->count + 1));
+	shm_wake(&h->count);
+}
+
+
+/**
+ * 	\brief	Get newest frame (reader side).
+ *
+ *	Waits up to tout_us for a frame newer than the one returned by the last call. The frame is read in
+ *	place (no copy); it stays valid until the writer reuses its slot, which shm_frame_check() tells
+ *	after reading. Needs no syscall if a newer frame is available.
+ *	@param[in]	ring	ring handle
+ *	@param[out]	frame	memory of frame (framesize bytes)
+ *	@param[in]	tout_us	timeout in us (micro sec)
+ *	@return	number of frames written since the last call (> 0), -1 if timeout, -2 if ring closed or replaced by the writer
+ */
+int shm_frame_latest(void* ring, const void** frame, int tout_us)
+{
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	struct _shm_frame_header* h = (struct _shm_frame_header *)m->addr;
+	volatile int* seq;
+	int err, count, seqval;
+	while (1)
+	{
+		err = shm_wait_counter(&h->count, m->next, &h->closed, tout_us);
+		if ((err == -1) && shm_replaced(m))
+		{	// writer terminated without closing, a new one has started
+			err = -2;
+		}
+		if (err)
+		{
+			return err;
+		}
+		count = atomic_load(&h->count);
+		seq = frame_slot(m, (unsigned int )count - 1);
+		seqval = atomic_load(seq);
+		if (!(seqval & 1))
+		{	// otherwise the writer has wrapped around the whole ring in the meantime: try again
+			err = (int )((unsigned int )count - (unsigned int )m->next);
+			m->next = count;
+			m->seq = seq;
+			m->seqval = seqval;
+			*frame = (const char* )seq + SHM_ALIGN;
+			return err;
+		}
+	}
+}
+
+
+/**
+ * 	\brief	Check if frame returned by shm_frame_latest() is still unchanged (reader side).
+ *
+ *	@param[in]	ring	ring handle
+ *	@return	frame unchanged, i.e. data read so far is consistent?
+ */
+bool shm_frame_check(void* ring)
+{
+	struct _shm_struct* m = (struct _shm_struct *)ring;
+	if (m->seq == NULL)
+	{
+		return false;
+	}
+	atomic_fence();
+	return (atomic_load(m->seq) == m->seqval);
+}
+
+}
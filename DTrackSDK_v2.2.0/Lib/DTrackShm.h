@@ -0,0 +1,173 @@
+/* DTrackShm: C header file
+ *
+ * Functions for handing over tracking data to other processes through shared memory
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Version v2.2.0
+ */
+
+#ifndef _ART_DTRACKSHM_H_
+#define _ART_DTRACKSHM_H_
+
+#include "DTrackNet.h"  // OS_* definitions
+
+namespace DTrackSDK_Shm {
+
+/**
+ * 	\brief	Create ring of packets in shared memory (writer side).
+ *
+ *	Replaces an existing ring with the same name (e.g. left by a crashed writer). Readers attached
+ *	to the replaced ring notice this at their next timeout and have to attach again (see
+ *	shm_packet_receive_batch()). On Windows, creating fails instead as long as readers are attached.
+ *	@param[out]	ring	ring handle
+ *	@param[in]	name	name of shared memory (POSIX: without leading '/'; Windows: in 'Local\' namespace)
+ *	@param[in]	nslot	number of packets kept in the ring
+ *	@param[in]	slotlen	max length of one packet
+ *	@return	0 if ok, <0 if error occured
+ */
+int shm_packet_create(void** ring, const char* name, int nslot, int slotlen);
+
+/**
+ * 	\brief	Attach to ring of packets in shared memory (reader side).
+ *
+ *	The ring is mapped read-only, readers don't influence the writer or other readers.
+ *	Reading starts with the next packet written after attaching.
+ *	@param[out]	ring	ring handle
+ *	@param[in]	name	name of shared memory (see shm_packet_create())
+ *	@return	0 if ok, <0 if error occured (-1 ring doesn't exist)
+ */
+int shm_packet_open(void** ring, const char* name);
+
+/**
+ * 	\brief	Detach from ring of packets.
+ *
+ *	The writer marks the ring as closed and removes its name.
+ *	@param[in]	ring	ring handle
+ *	@return	0 ok, -1 error
+ */
+int shm_packet_close(void* ring);
+
+/**
+ * 	\brief	Write packet into ring (writer side).
+ *
+ *	Never blocks, overwrites the oldest packet. Wakes up waiting readers (one syscall on Linux,
+ *	independent of the number of readers).
+ *	@param[in]	ring	ring handle
+ *	@param[in]	data	packet data
+ *	@param[in]	len		length of packet (truncated to slotlen)
+ *	@param[in]	rxtime	receive timestamp of packet in s (see DTrackSDK_Net::udp_receive())
+ */
+void shm_packet_write(void* ring, const void* data, int len, double rxtime);
+
+/**
+ *	\brief	Receive all packets written since the last call at once (reader side).
+ *
+ *	Same semantics as DTrackSDK_Net::udp_receive_batch(). Needs no syscall if packets are available,
+ *	waiting uses a futex on Linux and polling on other systems. Packets overwritten before they
+ *	were read are lost.
+ *	@param[in]	ring	ring handle
+ *	@param[out] buffer 	buffer for packet data, consists of nslot slots of slotlen bytes each
+ *	@param[in] 	slotlen	length of one slot
+ *	@param[in] 	nslot	number of slots
+ *	@param[out] len		number of received bytes per slot, -4 if packet didn't fit into its slot
+ *	@param[in]  tout_us timeout in us (micro sec)
+ *	@param[out]	rxtime	receive timestamp per slot in s (optional)
+ *	@return	number of received packets (oldest first), -1 if timeout, -2 if ring closed or replaced by the writer
+ */
+int shm_packet_receive_batch(void* ring, void *buffer, int slotlen, int nslot, int* len, int tout_us, double* rxtime = NULL);
+
+/**
+ * 	\brief	Create ring of frames in shared memory (writer side).
+ *
+ *	Frames are blocks of fixed size, the ring keeps the newest nslot frames. Replaces an existing
+ *	ring with the same name (see shm_packet_create()).
+ *	@param[out]	ring		ring handle
+ *	@param[in]	name		name of shared memory (see shm_packet_create())
+ *	@param[in]	nslot		number of frames kept in the ring
+ *	@param[in]	framesize	size of one frame in bytes
+ *	@return	0 if ok, <0 if error occured
+ */
+int shm_frame_create(void** ring, const char* name, int nslot, int framesize);
+
+/**
+ * 	\brief	Attach to ring of frames in shared memory (reader side).
+ *
+ *	The ring is mapped read-only.
+ *	@param[out]	ring	ring handle
+ *	@param[in]	name	name of shared memory
+ *	@return	0 if ok, <0 if error occured (-1 ring doesn't exist)
+ */
+int shm_frame_open(void** ring, const char* name);
+
+/**
+ * 	\brief	Detach from ring of frames.
+ *
+ *	The writer marks the ring as closed and removes its name.
+ *	@param[in]	ring	ring handle
+ *	@return	0 ok, -1 error
+ */
+int shm_frame_close(void* ring);
+
+/**
+ * 	\brief	Get size of one frame.
+ *
+ *	@param[in]	ring	ring handle
+ *	@return	size in bytes
+ */
+int shm_frame_size(void* ring);
+
+/**
+ * 	\brief	Begin to write next frame (writer side).
+ *
+ *	The frame is published by shm_frame_commit(). Overwrites the oldest frame.
+ *	@param[in]	ring	ring handle
+ *	@return	memory of frame (framesize bytes, 64 byte aligned)
+ */
+void* shm_frame_begin(void* ring);
+
+/**
+ * 	\brief	Publish frame started by shm_frame_begin() (writer side).
+ *
+ *	Wakes up waiting readers (one syscall on Linux, independent of the number of readers).
+ *	@param[in]	ring	ring handle
+ */
+void shm_frame_commit(void* ring);
+
+/**
+ * 	\brief	Get newest frame (reader side).
+ *
+ *	Waits up to tout_us for a frame newer than the one returned by the last call. The frame is read in
+ *	place (no copy); it stays valid until the writer reuses its slot, which shm_frame_check() tells
+ *	after reading. Needs no syscall if a newer frame is available.
+ *	@param[in]	ring	ring handle
+ *	@param[out]	frame	memory of frame (framesize bytes)
+ *	@param[in]	tout_us	timeout in us (micro sec)
+ *	@return	number of frames written since the last call (> 0), -1 if timeout, -2 if ring closed or replaced by the writer
+ */
+int shm_frame_latest(void* ring, const void** frame, int tout_us);
+
+/**
+ * 	\brief	Check if frame returned by shm_frame_latest() is still unchanged (reader side).
+ *
+ *	@param[in]	ring	ring handle
+ *	@return	frame unchanged, i.e. data read so far is consistent?
+ */
+bool shm_frame_check(void* ring);
+
+}
+
+#endif // _ART_DTRACKSHM_H_
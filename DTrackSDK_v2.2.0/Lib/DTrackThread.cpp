@@ -0,0 +1,232 @@
+/* DTrackThread: C/C++ source file
+ *
+ * Functions for running a background thread and exchanging data with it
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Version v2.2.0
+ */
+
+#include "DTrackThread.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef OS_UNIX
+	#include <pthread.h>
+#endif
+
+// internal thread type
+struct _thread_struct {
+#ifdef OS_UNIX
+	pthread_t osthread;	// Unix thread
+#endif
+#ifdef OS_WIN
+	HANDLE osthread;	// Windows thread
+#endif
+	void (*func)(void*);	// function executed by the thread
+	void* arg;				// argument passed to func
+};
+
+// entry point of all threads, calls the user function
+#ifdef OS_UNIX
+static void* thread_main(void* arg)
+{
+	struct _thread_struct* t = (struct _thread_struct *)arg;
+	t->func(t->arg);
+	return NULL;
+}
+#endif
+#ifdef OS_WIN
+static DWORD WINAPI thread_main(LPVOID arg)
+{
+	struct _thread_struct* t = (struct _thread_struct *)arg;
+	t->func(t->arg);
+	return 0;
+}
+#endif
+
+namespace DTrackSDK_Thread {
+
+/**
+ * 	\brief	Start a new thread.
+ *
+ *	@param[out]	thread	thread handle
+ *	@param[in]	func	function executed by the thread
+ *	@param[in]	arg		argument passed to func
+ *	@return	0 if ok, <0 if error occured
+ */
+int thread_start(void** thread, void (*func)(void*), void* arg)
+{
+	struct _thread_struct* t;
+	t = (struct _thread_struct *)malloc(sizeof(struct _thread_struct));
+	if (t == NULL)
+	{
+		return -11;
+	}
+	t->func = func;
+	t->arg = arg;
+#ifdef OS_UNIX
+	if (pthread_create(&t->osthread, NULL, thread_main, t) != 0)
+	{
+		free(t);
+		return -1;
+	}
+#endif
+#ifdef OS_WIN
+	t->osthread = CreateThread(NULL, 0, thread_main, t, 0, NULL);
+	if (t->osthread == NULL)
+	{
+		free(t);
+		return -1;
+	}
+#endif
+	*thread = t;
+	return 0;
+}
+
+
+/**
+ * 	\brief	Wait for the end of a thread and release its handle.
+ *
+ *	@param[in]	thread	thread handle
+ *	@return	0 if ok, <0 if error occured
+ */
+int thread_join(void* thread)
+{
+	int err = 0;
+	struct _thread_struct* t = (struct _thread_struct *)thread;
+	if (thread == NULL)
+	{
+		return 0;
+	}
+#ifdef OS_UNIX
+	if (pthread_join(t->osthread, NULL) != 0)
+	{
+		err = -1;
+	}
+#endif
+#ifdef OS_WIN
+	if (WaitForSingleObject(t->osthread, INFINITE) != WAIT_OBJECT_0)
+	{
+		err = -1;
+	}
+	CloseHandle(t->osthread);
+#endif
+	free(thread);
+	return err;
+}
+
+
+/**
+ * 	\brief	Suspend calling thread.
+ *
+ *	@param[in]	us		time in us (micro sec)
+ */
+void thread_sleep(int us)
+{
+	if (us <= 0)
+	{
+		return;
+	}
+#ifdef OS_UNIX
+	struct timespec ts;
+	ts.tv_sec = us / 1000000;
+	ts.tv_nsec = (us % 1000000) * 1000;
+	nanosleep(&ts, NULL);
+#endif
+#ifdef OS_WIN
+	Sleep((us + 999) / 1000);
+#endif
+}
+
+
+/**
+ * 	\brief	Atomically read value (with full memory barrier).
+ *
+ *	@param[in]	ptr		pointer to value
+ *	@return	value
+ */
+int atomic_load(volatile int* ptr)
+{
+#ifdef OS_UNIX
+#ifdef __ATOMIC_SEQ_CST
+	return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+#else
+	return __sync_fetch_and_add(ptr, 0);
+#endif
+#endif
+#ifdef OS_WIN
+	return InterlockedCompareExchange((volatile LONG* )ptr, 0, 0);
+#endif
+}
+
+
+/**
+ * 	\brief	Atomically write value (with full memory barrier).
+ *
+ *	@param[in]	ptr		pointer to value
+ *	@param[in]	value	new value
+ */
+void atomic_store(volatile int* ptr, int value)
+{
+	atomic_exchange(ptr, value);
+}
+
+
+/**
+ * 	\brief	Atomically exchange value (with full memory barrier).
+ *
+ *	@param[in]	ptr		pointer to value
+ *	@param[in]	value	new value
+ *	@return	previous value
+ */
+int atomic_exchange(volatile int* ptr, int value)
+{
+#ifdef OS_UNIX
+#ifdef __ATOMIC_SEQ_CST
+	return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+#else
+	__sync_synchronize();  // __sync_lock_test_and_set() is only an acquire barrier
+	return __sync_lock_test_and_set(ptr, value);
+#endif
+#endif
+#ifdef OS_WIN
+	return InterlockedExchange((volatile LONG* )ptr, value);
+#endif
+}
+
+
+/**
+ * 	\brief	Full memory barrier.
+ *
+ *	No memory access is moved across the barrier (neither by compiler nor by CPU).
+ */
+void atomic_fence(void)
+{
+#ifdef OS_UNIX
+#ifdef __ATOMIC_SEQ_CST
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+	__sync_synchronize();
+#endif
+#endif
+#ifdef OS_WIN
+	MemoryBarrier();
+#endif
+}
+
+} // end namespace
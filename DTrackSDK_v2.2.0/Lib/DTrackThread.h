@@ -0,0 +1,89 @@
+/* DTrackThread: C header file
+ *
+ * Functions for running a background thread and exchanging data with it
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Version v2.2.0
+ */
+
+#ifndef _ART_DTRACKTHREAD_H_
+#define _ART_DTRACKTHREAD_H_
+
+#include "DTrackNet.h"  // OS_* definitions
+
+namespace DTrackSDK_Thread {
+
+/**
+ * 	\brief	Start a new thread.
+ *
+ *	@param[out]	thread	thread handle
+ *	@param[in]	func	function executed by the thread
+ *	@param[in]	arg		argument passed to func
+ *	@return	0 if ok, <0 if error occured
+ */
+int thread_start(void** thread, void (*func)(void*), void* arg);
+
+/**
+ * 	\brief	Wait for the end of a thread and release its handle.
+ *
+ *	@param[in]	thread	thread handle
+ *	@return	0 if ok, <0 if error occured
+ */
+int thread_join(void* thread);
+
+/**
+ * 	\brief	Suspend calling thread.
+ *
+ *	@param[in]	us		time in us (micro sec)
+ */
+void thread_sleep(int us);
+
+/**
+ * 	\brief	Atomically read value (with full memory barrier).
+ *
+ *	@param[in]	ptr		pointer to value
+ *	@return	value
+ */
+int atomic_load(volatile int* ptr);
+
+/**
+ * 	\brief	Atomically write value (with full memory barrier).
+ *
+ *	@param[in]	ptr		pointer to value
+ *	@param[in]	value	new value
+ */
+void atomic_store(volatile int* ptr, int value);
+
+/**
+ * 	\brief	Atomically exchange value (with full memory barrier).
+ *
+ *	@param[in]	ptr		pointer to value
+ *	@param[in]	value	new value
+ *	@return	previous value
+ */
+int atomic_exchange(volatile int* ptr, int value);
+
+/**
+ * 	\brief	Full memory barrier.
+ *
+ *	No memory access is moved across the barrier (neither by compiler nor by CPU).
+ */
+void atomic_fence(void);
+
+}
+
+#endif // _ART_DTRACKTHREAD_H_
@@ -0,0 +1,204 @@
+/* DTrackSDK: C++ example
+ *
+ * example_parse_check:
+ *    C++ example comparing the number conversion of DTrackSDK with the C library
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Purpose:
+ *  - converts a corpus of numbers (as sent by DTrack, and unusual ones) with string_get_i(),
+ *    string_get_ui(), string_get_d() and string_get_f() and compares the values and the end of
+ *    the numbers with strtol(), strtoul() and strtod(); no DTrack needed
+ *  - exits with the number of failed checks
+ *  - using DTrackSDK v2.2.0
+ */
+#include "DTrackParse.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace DTrackSDK_Parse;
+
+// numbers with special cases: signs, leading zeros, exponents, long mantissas, qualities of -1, ...
+static const char* corpus[] = {
+	"0", "-0", "+0", "1", "-1", "+1", "-1.000", "-1.0", "-1.", "1.000", "0.000", "-0.000",
+	"007", "-007", "+007.50", "0000000000000000000000001", "-000.000123", "00.5",
+	".5", "-.5", "5.", "1e5", "1E5", "1e+5", "1e-5", "-1.5e3", "1.5E-3", "0e0", "1e0",
+	"1e22", "1e23", "1e-22", "1e-23", "1.7976931348623157e308", "2.2250738585072014e-308",
+	"4.9e-324", "2.5e-310", "1e309", "-1e309", "1e-400", "1e+0000000000000000000003",
+	"9007199254740992", "9007199254740993", "18446744073709551615", "18446744073709551616",
+	"123456789012345678901234567890", "0.1000000000000000055511151231257827021181583404541015625",
+	"3.14159265358979323846264338327950288419716939937510", "-273.149999999999977262632455676794",
+	"2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295", "4294967296",
+	"1234.567", "-1234.567", "12345678.123456", "0.000001", "999999.999999",
+	"0x10", "0X1f", "-0x10", "0x", "1.2.3", "12abc", "1e", "1e+", "1e-x", "--1", "+-1", "-+1",
+	"+", "-", ".", "-.", "e5", "", "nan", "inf", "-inf", "a1"
+};
+
+// separators behind and in front of numbers, as in DTrack data:
+static const char* prefix[] = { "", " ", "  ", "[", " [" };
+static const char* suffix[] = { "", " ", "]", "][", "\r\n" };
+
+static int num_checks = 0;
+static int num_failed = 0;
+static unsigned int seed = 12345;
+
+
+/**
+ * 	\brief Pseudo random number, same sequence on all systems.
+ */
+static unsigned int random_value()
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+
+/**
+ * 	\brief Prints failed check.
+ */
+static void fail(const char* type, const string& text)
+{
+	if (num_failed++ < 20) {
+		cout << type << " differs for '" << text << "'" << endl;
+	}
+}
+
+
+/**
+ * 	\brief Converts one string with all functions and compares with the C library.
+ */
+static void check(const string& text)
+{
+	vector<char> buf(text.begin(), text.end());
+	buf.push_back('\0');
+	buf.push_back('\0');
+	char* str = &buf[0];
+	char* end;
+	char* s;
+
+	num_checks++;
+
+	// strings are skipped to the first non-space character by the C library only:
+	double dref = strtod(str, &end);
+	char* endref = (end == str) ? NULL : end;
+
+	double d = 0;
+	s = string_get_d(str, &d);
+	if ((s != endref) || (s && (memcmp(&d, &dref, sizeof(d)) != 0))) {
+		fail("double", text);
+	}
+
+	float f = 0;
+	float fref = (float )dref;
+	s = string_get_f(str, &f);
+	if ((s != endref) || (s && (memcmp(&f, &fref, sizeof(f)) != 0))) {
+		fail("float", text);
+	}
+
+	int iref = (int )strtol(str, &end, 0);
+	endref = (end == str) ? NULL : end;
+	int i = 0;
+	s = string_get_i(str, &i);
+	if ((s != endref) || (s && (i != iref))) {
+		fail("int", text);
+	}
+
+	unsigned int uiref = (unsigned int )strtoul(str, &end, 0);
+	endref = (end == str) ? NULL : end;
+	unsigned int ui = 0;
+	s = string_get_ui(str, &ui);
+	if ((s != endref) || (s && (ui != uiref))) {
+		fail("unsigned int", text);
+	}
+}
+
+
+/**
+ * 	\brief Checks a DTrack block with a quality of -1 (not tracked).
+ */
+static void check_block()
+{
+	char line[] = "[3 -1.000][0.000 -0.000 0.000]";
+	int id = 0;
+	float quality = 0;
+	double loc[3] = { 1, 1, 1 };
+
+	num_checks++;
+	char* s = string_get_block(line, "if", &id, &quality, NULL);
+	s = s ? string_get_block(s, "ddd", NULL, NULL, loc) : NULL;
+	if (!s || (*s != '\0') || (id != 3) || (quality != -1.0f) || (loc[0] != 0) || (loc[1] != 0) || (loc[2] != 0)) {
+		fail("block", line);
+	}
+}
+
+
+/**
+ * 	\brief	Main.
+ */
+int main()
+{
+	char text[512];
+
+	// corpus, with separators:
+	for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+		for (size_t p = 0; p < sizeof(prefix) / sizeof(prefix[0]); p++) {
+			for (size_t q = 0; q < sizeof(suffix) / sizeof(suffix[0]); q++) {
+				check(string(prefix[p]) + corpus[i] + suffix[q]);
+			}
+		}
+	}
+	check_block();
+
+	// numbers as sent by DTrack (fixed number of decimals), and random doubles:
+	for (int k = 0; k < 200000; k++) {
+		double v = (double )(random_value() % 20000000) / 1000.0 - 10000.0;
+		sprintf(text, "%.3f", v);
+		check(text);
+		sprintf(text, "%.6f", v / 1000.0);
+		check(text);
+
+		unsigned int bits[2] = { random_value() ^ (random_value() << 24), random_value() ^ (random_value() << 24) };
+		memcpy(&v, bits, sizeof(v));
+		if (v != v)  // NaN
+			continue;
+
+		sprintf(text, "%.17g", v);
+		check(text);
+		sprintf(text, "%.6e", v);
+		check(text);
+	}
+
+	// random strings of number characters:
+	const char alphabet[] = "0123456789.eE+- ]x";
+	for (int k = 0; k < 200000; k++) {
+		string t;
+		int len = random_value() % 14;
+		for (int j = 0; j < len; j++) {
+			t += alphabet[random_value() % (sizeof(alphabet) - 1)];
+		}
+		check(t);
+	}
+
+	cout << num_checks << " checks, " << num_failed << " failed" << endl;
+	return num_failed;
+}
@@ -0,0 +1,255 @@
+/* DTrackSDK: C++ example
+ *
+ * example_predictor_check:
+ *    C++ example checking the extrapolation of poses by DTrackPredictor
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Purpose:
+ *  - feeds frames of a body and a hand moving with constant velocity or constant acceleration into
+ *    DTrackPredictor and compares the extrapolated poses with the true motion; no DTrack needed
+ *  - checks frames not tracked, repeated frames, a restart of the time base and the max time of
+ *    extrapolation
+ *  - exits with the number of failed checks
+ *  - using DTrackSDK v2.2.0
+ */
+#include "DTrackPredictor.hpp"
+#include "DTrackPose.h"
+
+#include <string.h>
+#include <math.h>
+#include <iostream>
+
+using namespace std;
+using namespace DTrackSDK_Pose;
+
+#define FRAME_RATE    60.0   // frame rate in Hz
+#define PREDICT_TIME  0.02   // time of extrapolation in s
+#define MAX_LOC_ERR   0.01   // max error of extrapolated locations in mm
+#define MAX_ANG_ERR   0.01   // max error of extrapolated orientations in deg
+
+static const double PI = 3.14159265358979323846;
+
+static int num_failed = 0;
+
+
+/**
+ * 	\brief	Print result of one check.
+ */
+static void check(const char* name, bool ok)
+{
+	cout << name << ": " << (ok ? "ok" : "FAILED") << endl;
+	if (!ok) {
+		num_failed++;
+	}
+}
+
+
+/**
+ * 	\brief	True motion: location and orientation at time t (in s).
+ *
+ *	@param[in]	t		time
+ *	@param[in]	accel	with constant acceleration? otherwise constant velocity
+ *	@param[out]	pose	pose at time t
+ */
+static void true_pose(double t, bool accel, DTrack_Pose_Type_f& pose)
+{
+	double acc = accel ? 1.0 : 0.0;
+
+	for (int k = 0; k < 3; k++) {
+		pose.loc[k] = (float )(100.0 * k + (200.0 + 50.0 * k) * t + acc * (3000.0 - 1000.0 * k) * t * t / 2);
+	}
+
+	// rotation about a fixed axis, starting from an arbitrary orientation:
+	double angle = 2.0 * t + acc * 20.0 * t * t / 2;
+	float rotvec[3] = { (float )(0.6 * angle), (float )(0.8 * angle), 0.0f };
+	float start[4] = { 0.5f, 0.5f, 0.5f, 0.5f };
+	float q[4];
+
+	quat_exp(q, rotvec);
+	quat_mult(pose.quat, q, start);
+}
+
+
+/**
+ * 	\brief	Distance of two locations in mm.
+ */
+static double loc_error(const float a[3], const float b[3])
+{
+	double d[3] = { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+	return sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+}
+
+
+/**
+ * 	\brief	Angle between two orientations in deg.
+ */
+static double ang_error(const float a[4], const float b[4])
+{
+	float binv[4] = { b[0], -b[1], -b[2], -b[3] };
+	float q[4], v[3];
+
+	quat_mult(q, a, binv);
+	quat_log(v, q);
+	return sqrt((double )v[0] * v[0] + (double )v[1] * v[1] + (double )v[2] * v[2]) * 180.0 / PI;
+}
+
+
+/**
+ * 	\brief	Set frame with one body and one hand (three fingers), all at the same pose.
+ *
+ *	Fingers move in hand coordinates like the hand in room coordinates, scaled down by 10.
+ */
+static void set_frame(DTrack_Frame_Type_d& frame, double timestamp, const DTrack_Pose_Type_f& pose, bool tracked)
+{
+	double rot[9];
+	quat_to_rot(rot, pose.quat);
+
+	frame.timestamp = timestamp;
+	frame.num_body = 1;
+	frame.body.resize(1);
+	frame.num_hand = 1;
+	frame.hand.resize(1);
+
+	DTrack_Body_Type_d& body = frame.body[0];
+	body.id = 0;
+	body.quality = tracked ? 1.0 : -1.0;
+	for (int k = 0; k < 3; k++) {
+		body.loc[k] = pose.loc[k];
+	}
+	memcpy(body.rot, rot, sizeof(rot));
+
+	DTrack_Hand_Type_d& hand = frame.hand[0];
+	memset(&hand, 0, sizeof(hand));
+	hand.quality = tracked ? 1.0 : -1.0;
+	hand.nfinger = 3;
+	for (int k = 0; k < 3; k++) {
+		hand.loc[k] = pose.loc[k];
+	}
+	memcpy(hand.rot, rot, sizeof(rot));
+	for (int j = 0; j < hand.nfinger; j++) {
+		for (int k = 0; k < 3; k++) {
+			hand.finger[j].loc[k] = pose.loc[k] / 10;
+		}
+		memcpy(hand.finger[j].rot, rot, sizeof(rot));
+	}
+}
+
+
+/**
+ * 	\brief	Extrapolates 2 s of motion and compares with the true motion.
+ */
+static void check_motion(const char* name, bool accel, DTrackPredictor::Model model)
+{
+	DTrackPredictor predictor(model);
+	DTrack_Frame_Type_d frame;
+	double t0 = 1000.0;  // timestamp of first frame
+	double maxloc = 0, maxang = 0, maxloc_unpredicted = 0;
+	bool ok = true;
+
+	for (int i = 0; i < 2 * (int )FRAME_RATE; i++) {
+		double t = i / FRAME_RATE;
+		DTrack_Pose_Type_f pose, future;
+
+		true_pose(t, accel, pose);
+		set_frame(frame, t0 + t, pose, true);
+		ok = ok && predictor.update(frame);
+
+		if (i < 3)  // motion not fully known yet
+			continue;
+
+		true_pose(t + PREDICT_TIME, accel, future);
+
+		DTrack_Body_Pose_Type body;
+		DTrack_Hand_Pose_Type hand;
+		ok = ok && predictor.predictBody(0, t0 + t + PREDICT_TIME, body) && predictor.predictHand(0, t0 + t + PREDICT_TIME, hand);
+
+		float finger_loc[3] = { future.loc[0] / 10, future.loc[1] / 10, future.loc[2] / 10 };
+		double errors[3] = {
+			loc_error(body.pose.loc, future.loc), loc_error(hand.pose.loc, future.loc),
+			10 * loc_error(hand.finger[2].loc, finger_loc)
+		};
+		for (int k = 0; k < 3; k++) {
+			maxloc = (errors[k] > maxloc) ? errors[k] : maxloc;
+		}
+
+		double angles[2] = { ang_error(body.pose.quat, future.quat), ang_error(hand.finger[1].quat, future.quat) };
+		for (int k = 0; k < 2; k++) {
+			maxang = (angles[k] > maxang) ? angles[k] : maxang;
+		}
+
+		double unpredicted = loc_error(pose.loc, future.loc);
+		maxloc_unpredicted = (unpredicted > maxloc_unpredicted) ? unpredicted : maxloc_unpredicted;
+	}
+
+	cout << name << ": max error " << maxloc << " mm, " << maxang << " deg (without extrapolation "
+	     << maxloc_unpredicted << " mm)" << endl;
+	check(name, ok && (maxloc <= MAX_LOC_ERR) && (maxang <= MAX_ANG_ERR));
+}
+
+
+/**
+ * 	\brief	Frames not tracked, repeated frames, restart of the time base, max time of extrapolation.
+ */
+static void check_special()
+{
+	DTrackPredictor predictor(DTrackPredictor::MODEL_VELOCITY, 0.05);
+	DTrack_Frame_Type_d frame;
+	DTrack_Pose_Type_f pose;
+	DTrack_Body_Pose_Type body, body_max;
+
+	for (int i = 0; i < 3; i++) {
+		true_pose(i / FRAME_RATE, false, pose);
+		set_frame(frame, 100.0 + i / FRAME_RATE, pose, true);
+		predictor.update(frame);
+	}
+	double t = predictor.getTimeStamp();
+
+	// extrapolation is limited to the max time:
+	bool ok = predictor.predictBody(0, t + 1.0, body) && predictor.predictBody(0, t + 0.05, body_max);
+	check("max time of extrapolation", ok && (memcmp(&body.pose, &body_max.pose, sizeof(body.pose)) == 0)
+	      && !predictor.setMaxPrediction(-1.0) && (predictor.getMaxPrediction() == 0.05));
+
+	// same frame again:
+	check("repeated frame", !predictor.update(frame) && (predictor.getTimeStamp() == t));
+
+	// target not tracked:
+	true_pose(3 / FRAME_RATE, false, pose);
+	set_frame(frame, 100.0 + 3 / FRAME_RATE, pose, false);
+	ok = predictor.update(frame);
+	check("not tracked", ok && !predictor.predictBody(0, t + 0.1, body) && (body.quality < 0));
+
+	// timestamp going back (e.g. restart of DTrack): motion unknown, last pose is kept
+	set_frame(frame, 10.0, pose, true);
+	ok = predictor.update(frame) && predictor.predictBody(0, 10.0 + PREDICT_TIME, body);
+	check("restart of time base", ok && (loc_error(body.pose.loc, pose.loc) == 0) && (predictor.getNumBody() == 1));
+}
+
+
+/**
+ * 	\brief	Main.
+ */
+int main()
+{
+	check_motion("velocity model, constant velocity", false, DTrackPredictor::MODEL_VELOCITY);
+	check_motion("acceleration model, constant velocity", false, DTrackPredictor::MODEL_ACCELERATION);
+	check_motion("acceleration model, constant acceleration", true, DTrackPredictor::MODEL_ACCELERATION);
+	check_special();
+
+	cout << num_failed << " checks failed" << endl;
+	return num_failed;
+}
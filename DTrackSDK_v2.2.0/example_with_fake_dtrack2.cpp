@@ -0,0 +1,421 @@
+/* DTrackSDK: C++ example
+ *
+ * example_with_fake_dtrack2:
+ *    C++ example checking the DTrack2 command interface against a fake DTrack2
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Purpose:
+ *  - runs a minimal DTrack2 command server on localhost in a background thread, no DTrack2 needed
+ *  - checks asynchronous DTrack2 commands: more commands than DTRACK_CMD_PIPELINE in flight, answers
+ *    split over several reads and several answers in one read, timeouts and broken connections
+ *  - checks getting several parameters at once and the parameter cache
+ *  - exits with the number of failed checks
+ *  - using DTrackSDK v2.2.0
+ */
+#include "DTrackSDK.hpp"
+#include "DTrackNet.h"
+#include "DTrackThread.h"
+
+#include <string.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace DTrackSDK_Thread;
+
+#ifdef OS_WIN
+	typedef SOCKET socket_type;
+	#define close_socket closesocket
+#else
+	typedef int socket_type;
+	#define close_socket close
+#endif
+
+#define FAKE_COLLECT_US 5000  // time to wait for further commands before answering them at once
+
+// state of fake DTrack2
+struct FakeDTrack2 {
+	socket_type listener;     // listening socket
+	unsigned short port;      // TCP port
+	volatile int num_get;     // number of "dtrack2 get" commands received
+	volatile int num_send;    // number of sends of answers
+};
+
+static int num_failed = 0;
+
+
+/**
+ * 	\brief	Print result of one check.
+ */
+static void check(const char* name, bool ok)
+{
+	cout << name << ": " << (ok ? "ok" : "FAILED") << endl;
+	if (!ok) {
+		num_failed++;
+	}
+}
+
+
+/**
+ * 	\brief	Wait for data on a socket.
+ *
+ *	@return	data available?
+ */
+static bool wait_readable(socket_type sock, int tout_us)
+{
+	fd_set set;
+	FD_ZERO(&set);
+	FD_SET(sock, &set);
+
+	struct timeval t;
+	t.tv_sec = tout_us / 1000000;
+	t.tv_usec = tout_us % 1000000;
+	return (select((int )sock + 1, &set, NULL, NULL, &t) > 0);
+}
+
+
+/**
+ * 	\brief	Send answers collected so far.
+ */
+static void send_answers(FakeDTrack2* fake, socket_type sock, string& out)
+{
+	if (!out.empty()) {
+		atomic_store(&fake->num_send, atomic_load(&fake->num_send) + 1);
+		send(sock, out.data(), (int )out.size(), 0);
+		out.clear();
+	}
+}
+
+
+/**
+ * 	\brief	Fake DTrack2: answers commands of one connection, until the connection is closed.
+ *
+ *	Commands arriving within FAKE_COLLECT_US are answered at once, so several answers arrive in one read.
+ *	Known commands:
+ *	 - "dtrack2 get <parameter>": answer "dtrack2 set <parameter> v_<parameter>"
+ *	 - "dtrack2 set <parameter>": answer "dtrack2 ok"
+ *	 - "dtrack2 bad": answer "dtrack2 err 7 ..."
+ *	 - "dtrack2 split": answer sent in two parts with a pause in between
+ *	 - "dtrack2 slow": answer "dtrack2 ok" after 300 ms
+ *	 - "dtrack2 quit": closes connection without answer
+ */
+static void fake_dtrack2(void* arg)
+{
+	FakeDTrack2* fake = (FakeDTrack2* )arg;
+
+	socket_type sock = accept(fake->listener, NULL, NULL);
+	string in, out;
+	char buf[4096];
+
+	while (true) {
+		if (!wait_readable(sock, out.empty() ? 10000000 : FAKE_COLLECT_US)) {
+			send_answers(fake, sock, out);
+			continue;
+		}
+
+		int n = recv(sock, buf, sizeof(buf), 0);
+		if (n <= 0)
+			break;
+
+		in.append(buf, n);
+		size_t end;
+		while ((end = in.find('\0')) != string::npos) {
+			string cmd = in.substr(0, end);
+			in.erase(0, end + 1);
+
+			if (cmd.compare(0, 12, "dtrack2 get ") == 0) {
+				atomic_store(&fake->num_get, atomic_load(&fake->num_get) + 1);
+				out += "dtrack2 set " + cmd.substr(12) + " v_" + cmd.substr(12);
+			} else if (cmd.compare(0, 12, "dtrack2 set ") == 0) {
+				out += "dtrack2 ok";
+			} else if (cmd == "dtrack2 bad") {
+				out += "dtrack2 err 7 \"bad command\"";
+			} else if (cmd == "dtrack2 split") {  // end of previous answers and begin of this one in one read
+				out += "dtrack2 split";
+				send_answers(fake, sock, out);
+				thread_sleep(50000);
+				out += "answer";
+			} else if (cmd == "dtrack2 slow") {
+				thread_sleep(300000);
+				out += "dtrack2 ok";
+			} else if (cmd == "dtrack2 quit") {
+				send_answers(fake, sock, out);
+				close_socket(sock);
+				return;
+			} else {
+				out += "dtrack2 err 1 \"unknown command\"";
+			}
+			out += '\0';
+		}
+	}
+
+	close_socket(sock);
+}
+
+
+/**
+ * 	\brief	Start fake DTrack2 on a free port of localhost.
+ *
+ *	@return	success?
+ */
+static bool fake_dtrack2_start(FakeDTrack2& fake, void** thread)
+{
+	fake.num_get = 0;
+	fake.num_send = 0;
+	fake.listener = socket(AF_INET, SOCK_STREAM, 0);
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	addr.sin_port = 0;
+	if (bind(fake.listener, (struct sockaddr* )&addr, sizeof(addr)) || listen(fake.listener, 1)) {
+		return false;
+	}
+
+	socklen_t len = sizeof(addr);
+	getsockname(fake.listener, (struct sockaddr* )&addr, &len);
+	fake.port = ntohs(addr.sin_port);
+
+	return (thread_start(thread, fake_dtrack2, &fake) == 0);
+}
+
+
+// answers handed over to callback:
+struct Answer {
+	int id;
+	int result;
+	string answer;
+};
+
+static vector<Answer> answers;
+
+
+/**
+ * 	\brief	Callback for answers of asynchronous commands.
+ */
+static void on_answer(DTrackSDK* /*sdk*/, int id, int result, const std::string& answer, void* /*userdata*/)
+{
+	Answer a;
+	a.id = id;
+	a.result = result;
+	a.answer = answer;
+	answers.push_back(a);
+}
+
+
+/**
+ * 	\brief	Expected answer of fake DTrack2 to "dtrack2 get <parameter>".
+ */
+static string get_answer(const string& parameter)
+{
+	return "dtrack2 set " + parameter + " v_" + parameter;
+}
+
+
+/**
+ * 	\brief	More commands than DTRACK_CMD_PIPELINE, half with callback, answers fetched in reverse order.
+ */
+static void check_pipeline(DTrackSDK* dt)
+{
+	const int num = 3 * DTRACK_CMD_PIPELINE;
+	vector<int> ids(num);
+	vector<string> params(num);
+	bool ok = true;
+
+	answers.clear();
+	for (int i = 0; i < num; i++) {
+		ostringstream os;
+		os << "cat p" << i;
+		params[i] = os.str();
+		ids[i] = dt->sendDTrack2CommandAsync("dtrack2 get " + params[i], (i % 2) ? on_answer : NULL);
+		ok = ok && (ids[i] > 0) && (dt->getNumPendingDTrack2Commands() <= DTRACK_CMD_PIPELINE);
+	}
+
+	for (int i = num - 2; i >= 0; i -= 2) {
+		string answer;
+		ok = ok && (dt->waitDTrack2Command(ids[i], &answer) == 0) && (answer == get_answer(params[i]));
+	}
+	ok = ok && (dt->waitDTrack2Command(ids[0]) == -12);  // fetched already
+
+	ok = ok && ((int )answers.size() == num / 2);
+	for (size_t i = 0; ok && (i < answers.size()); i++) {
+		int k = 2 * (int )i + 1;
+		ok = (answers[i].id == ids[k]) && (answers[i].result == 0) && (answers[i].answer == get_answer(params[k]));
+	}
+
+	check("pipeline", ok && (dt->getNumPendingDTrack2Commands() == 0));
+}
+
+
+/**
+ * 	\brief	Answers split over several reads, several answers in one read, different kinds of answers.
+ */
+static void check_split(DTrackSDK* dt)
+{
+	answers.clear();
+	dt->sendDTrack2CommandAsync("dtrack2 get cat a", on_answer);
+	dt->sendDTrack2CommandAsync("dtrack2 bad", on_answer);
+	dt->sendDTrack2CommandAsync("dtrack2 split", on_answer);
+	dt->sendDTrack2CommandAsync("dtrack2 set cat b 1", on_answer);
+
+	int num = 0;
+	while (dt->getNumPendingDTrack2Commands() > 0) {
+		int n = dt->processDTrack2Answers(1000000);
+		if (n <= 0)
+			break;
+		num += n;
+	}
+
+	check("split answers", (num == 4) && (answers.size() == 4)
+	      && (answers[0].result == 0) && (answers[0].answer == get_answer("cat a"))
+	      && (answers[1].result == 2) && (answers[2].result == 0) && (answers[2].answer == "dtrack2 splitanswer")
+	      && (answers[3].result == 1));
+
+	// synchronous command after asynchronous ones:
+	string value;
+	check("synchronous after asynchronous", dt->getParam("cat c", value) && (value == "v_cat c"));
+}
+
+
+/**
+ * 	\brief	Several parameters at once, with and without parameter cache.
+ */
+static void check_params(DTrackSDK* dt, FakeDTrack2& fake)
+{
+	vector<string> params, values;
+	for (int i = 0; i < 2 * DTRACK_CMD_PIPELINE; i++) {
+		ostringstream os;
+		os << "cat q" << (i + 1);
+		params.push_back(os.str());
+	}
+	int num = (int )params.size();
+
+	// requests are sent without waiting for the answers in between:
+	int get0 = atomic_load(&fake.num_get);
+	int send0 = atomic_load(&fake.num_send);
+	bool ok = (dt->getParams(params, values) == num);
+	for (int i = 0; ok && (i < num); i++) {
+		ok = (values[i] == "v_" + params[i]);
+	}
+	int gets = atomic_load(&fake.num_get) - get0;
+	int sends = atomic_load(&fake.num_send) - send0;
+	check("getParams", ok && (gets == num) && (sends < num / 4));
+
+	// cached parameters are not requested again; setParam() only removes the parameter it sets:
+	dt->setParamCache(true);
+	dt->getParams(params, values);
+
+	get0 = atomic_load(&fake.num_get);
+	ok = (dt->getParams(params, values) == num);
+	int gets_cached = atomic_load(&fake.num_get) - get0;
+
+	ok = ok && dt->setParam("cat q3 1") && dt->setParam("cat", "q4", "2");  // values[2], values[3]
+	get0 = atomic_load(&fake.num_get);
+	ok = ok && (dt->getParams(params, values) == num) && (values[2] == "v_cat q3");
+	int gets_set = atomic_load(&fake.num_get) - get0;
+
+	dt->clearParamCache();
+	get0 = atomic_load(&fake.num_get);
+	ok = ok && (dt->getParams(params, values) == num);
+	int gets_cleared = atomic_load(&fake.num_get) - get0;
+	dt->setParamCache(false);
+
+	check("parameter cache", ok && (gets_cached == 0) && (gets_set == 2) && (gets_cleared == num));
+}
+
+
+/**
+ * 	\brief	Timeout of a command: later commands must not get its late answer.
+ */
+static void check_timeout(DTrackSDK* dt)
+{
+	answers.clear();
+	dt->sendDTrack2CommandAsync("dtrack2 get cat t", on_answer);
+
+	dt->setControllerTimeoutUS(100000);
+	int result = dt->sendDTrack2Command("dtrack2 slow");
+	dt->setControllerTimeoutUS(1000000);
+
+	string value;
+	bool ok = dt->getParam("cat late", value);
+	check("timeout", (result == -1) && (answers.size() == 1) && (answers[0].answer == get_answer("cat t"))
+	      && ok && (value == "v_cat late") && (dt->processDTrack2Answers() == 0));
+}
+
+
+/**
+ * 	\brief	Broken connection: commands waiting for their answers fail.
+ */
+static void check_disconnect(DTrackSDK* dt)
+{
+	answers.clear();
+	dt->sendDTrack2CommandAsync("dtrack2 get cat z", on_answer);
+	dt->sendDTrack2CommandAsync("dtrack2 quit", on_answer);
+	int id = dt->sendDTrack2CommandAsync("dtrack2 get cat y");
+
+	int err = 0;
+	while ((dt->getNumPendingDTrack2Commands() > 0) && (err >= 0)) {
+		err = dt->processDTrack2Answers(1000000);
+	}
+	int result = dt->waitDTrack2Command(id);
+
+	check("disconnect", (err == -9) && (answers.size() == 2) && (answers[0].result == 0) && (answers[1].result == -9)
+	      && (result == -9) && (dt->getNumPendingDTrack2Commands() == 0)
+	      && (dt->sendDTrack2Command("dtrack2 get cat x") < 0));
+}
+
+
+/**
+ * 	\brief	Main.
+ */
+int main()
+{
+	FakeDTrack2 fake;
+	void* thread = NULL;
+
+	DTrackSDK_Net::net_init();
+	if (!fake_dtrack2_start(fake, &thread)) {
+		cout << "starting fake DTrack2 failed" << endl;
+		return -1;
+	}
+
+	// init library (no tracking data needed):
+	DTrackSDK* dt = new DTrackSDK("127.0.0.1", fake.port, 0);
+
+	if (!dt->isCommandInterfaceValid()) {
+		cout << "DTrackSDK init error" << endl;
+		return -2;
+	}
+
+	check_pipeline(dt);
+	check_split(dt);
+	check_params(dt, fake);
+	check_timeout(dt);
+	check_disconnect(dt);
+
+	delete dt;
+	thread_join(thread);
+	close_socket(fake.listener);
+	DTrackSDK_Net::net_exit();
+
+	cout << num_failed << " checks failed" << endl;
+	return num_failed;
+}
@@ -30,43 +30,35 @@
 #include <sstream>
 #include <cmath>
 #include "fingers.hpp"
-#define M_PI 3.14
 using namespace std;
 
-static void trafo_loc2coo( double locres[3], const double loccoo[3], const double rotcoo[9], const double loc[3] );
 static void test();
 // global DTrackSDK
 static DTrackSDK* dt = NULL;
+// finger positions of all hands
+static fingers* kin = NULL;
 
 
 /**
- * 	\brief Prints current tracking data to console.
+ * 	\brief Prints finger positions of all hands to console (structure of arrays).
  */
 static void test()
 {
-	
-//	cout.precision(3);
-//	cout.setf(ios::fixed, ios::floatfield);
-	/*
-	cout << endl << "frame " << dt->getFrameCounter() << " ts " << dt->getTimeStamp()
-			<< " nhand " << dt->getNumHand() 
-			<< endl;
-
-	*/
-	const int nohands=dt->getNumHand();
-	// ART Fingertracking hands:
-	DTrack_Hand_Type_d *hand = new DTrack_Hand_Type_d[nohands];
-	for(int i=0; i<dt->getNumHand(); i++){
-		hand[i] = *dt->getHand(i);
+	cout.precision(3);
+	cout.setf(ios::fixed, ios::floatfield);
 
+	kin->Update(dt);
 
-		fingers finger1(1);
-	
-		cout<<hand[0].id<<"other hand id";
-		finger1.GetFingerTip(hand[0]);
-	
+	const double* x = kin->GetRoomX();
+	const double* y = kin->GetRoomY();
+	const double* z = kin->GetRoomZ();
 
-	}	
+	cout << endl << "frame " << dt->getFrameCounter() << " positions " << kin->GetNumPoints() << endl;
+	for(int i=0; i<kin->GetNumPoints(); i++){
+		if(kin->IsValid(i)){
+			cout << " " << i << ": " << x[i] << " " << y[i] << " " << z[i] << endl;
+		}
+	}
 }
 
 
@@ -80,6 +72,8 @@ static void output_to_console()
 			<< endl;
 
 	// ART Fingertracking hands:
+	kin->Update(dt);
+
 	DTrack_Hand_Type_d hand;
 	for(int i=0; i<dt->getNumHand(); i++){
 		hand = *dt->getHand(i);
@@ -95,84 +89,31 @@ static void output_to_console()
 			     << " " << hand.rot[6] << " " << hand.rot[7] << " " << hand.rot[8] << endl;
 
 			for(int j=0; j<hand.nfinger; j++){
-				
 				double lochand[3], locroom[3];
 
-				// calculating the position for tip and all joints of the fingers (in hand and room coordinate system):
-
-				for(int k=0; k<3; k++){
-					lochand[k] = hand.finger[j].loc[k];  // finger tip (already in hand coordinate system)
-				}
+				// position for tip and all joints of the fingers (in hand and room coordinate system):
 
-				trafo_loc2coo(locroom, hand.loc, hand.rot, lochand);  // finger tip (in room coordinate system)
+				kin->GetFingerTip(i, j, lochand, locroom);
 
 				cout << "   finger " << j
 						<< " tip (hand) " << lochand[0] << " " << lochand[1] << " " << lochand[2]
 						<< " tip (room) " << locroom[0] << " " << locroom[1] << " " << locroom[2]
 						<< endl;
 
-				lochand[0] = -hand.finger[j].lengthphalanx[0];  // first joint (in finger coordinate system)
-				lochand[1] = lochand[2] = 0;
+				for(int k=1; k<=3; k++){
+					kin->GetJoint(i, j, k, lochand, locroom);
 
-				trafo_loc2coo(lochand, hand.finger[j].loc, hand.finger[j].rot, lochand);  // first joint (in hand coordinate system)
-				trafo_loc2coo(locroom, hand.loc, hand.rot, lochand);  // first joint (in room coordinate system)
-
-				cout << "           "
-						<< " joint 1 (hand) " << lochand[0] << " " << lochand[1] << " " << lochand[2]
-						<< " joint 1 (room) " << locroom[0] << " " << locroom[1] << " " << locroom[2]
-						<< endl;
-
-				lochand[0] = -hand.finger[j].lengthphalanx[0]  // second joint (in finger coordinate system)
-					- hand.finger[j].lengthphalanx[1] * cos(hand.finger[j].anglephalanx[0] * M_PI / 180);
-				lochand[1] = 0;
-				lochand[2] = hand.finger[j].lengthphalanx[1] * sin(hand.finger[j].anglephalanx[0] * M_PI / 180);
-
-				trafo_loc2coo(lochand, hand.finger[j].loc, hand.finger[j].rot, lochand);  // second joint (in hand coordinate system)
-				trafo_loc2coo(locroom, hand.loc, hand.rot, lochand);  // second joint (in room coordinate system)
-
-				cout << "           "
-						<< " joint 2 (hand) " << lochand[0] << " " << lochand[1] << " " << lochand[2]
-						<< " joint 2 (room) " << locroom[0] << " " << locroom[1] << " " << locroom[2]
-						<< endl;
-
-				lochand[0] = -hand.finger[j].lengthphalanx[0]  // third joint (in finger coordinate system)
-					- hand.finger[j].lengthphalanx[1] * cos(hand.finger[j].anglephalanx[0] * M_PI / 180)
-					- hand.finger[j].lengthphalanx[2] * cos( (hand.finger[j].anglephalanx[0] + hand.finger[j].anglephalanx[1]) * M_PI / 180 );
-				lochand[1] = 0;
-				lochand[2] = hand.finger[j].lengthphalanx[1] * sin(hand.finger[j].anglephalanx[0] * M_PI / 180)
-					+ hand.finger[j].lengthphalanx[2] * sin( (hand.finger[j].anglephalanx[0] + hand.finger[j].anglephalanx[1]) * M_PI / 180 );
-
-				trafo_loc2coo(lochand, hand.finger[j].loc, hand.finger[j].rot, lochand);  // third joint (in hand coordinate system)
-				trafo_loc2coo(locroom, hand.loc, hand.rot, lochand);  // third joint (in room coordinate system)
-
-				cout << "           "
-						<< " joint 3 (hand) " << lochand[0] << " " << lochand[1] << " " << lochand[2]
-						<< " joint 3 (room) " << locroom[0] << " " << locroom[1] << " " << locroom[2]
-						<< endl;
-					
+					cout << "           "
+							<< " joint " << k << " (hand) " << lochand[0] << " " << lochand[1] << " " << lochand[2]
+							<< " joint " << k << " (room) " << locroom[0] << " " << locroom[1] << " " << locroom[2]
+							<< endl;
+				}
 			}
 		}
 	}
 }
 
 
-/**
- * 	\brief Transforms position into another coordinate system.
- */
-static void trafo_loc2coo( double locres[3], const double loccoo[3], const double rotcoo[9], const double loc[3] )
-{
-	double tmploc[3];
-
-	for(int i=0; i<3; i++){
-		tmploc[i] = rotcoo[i+0*3] * loc[0] + rotcoo[i+1*3] * loc[1] + rotcoo[i+2*3] * loc[2];
-	}
-
-	for(int i=0; i<3; i++){
-		locres[i] = tmploc[i] + loccoo[i];
-	}
-}
-
-
 /**
  * 	\brief Prints error messages to console
  *
@@ -222,6 +163,7 @@ int main(int argc, char** argv)
 
 	// init library:
 	dt = new DTrackSDK(port);
+	kin = new fingers();
 
 	if(!dt->isLocalDataPortValid()){
 		cout << "DTrack init error" << endl;
@@ -245,6 +187,7 @@ int main(int argc, char** argv)
 	}
 
 	// clean up:
+	delete kin;
 	delete dt;
 
 	return 0;
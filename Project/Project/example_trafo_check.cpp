@@ -0,0 +1,252 @@
+/* DTrackSDK: C++ example
+ *
+ * example_trafo_check:
+ *    C++ example comparing the SSE2/AVX transformation of positions with plain C++
+ * Copyright (C) 2026, DTrackSDK contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *
+ * Purpose:
+ *  - transforms random positions with trafo_loc2coo_n() and compares the results with plain C++,
+ *    with trafo_loc2coo() and with trafo_compose() (bit-identical, or within the tolerance with FMA,
+ *    see trafo.hpp); no DTrack needed
+ *  - build with trafo.cpp only, once for each instruction set, e.g. with gcc:
+ *    'g++ -O2 example_trafo_check.cpp trafo.cpp', the same with '-mavx' and with '-mavx -mfma'
+ *  - exits with the number of failed checks
+ */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cfloat>
+#include "trafo.hpp"
+using namespace std;
+
+// results may differ in the last bits only, if the compiler contracts into FMA (see trafo.hpp):
+#if defined(__FMA__) || defined(__FAST_MATH__) || defined(FP_FAST_FMA)
+	#define CHECK_CONTRACTED
+#endif
+
+static int num_failed = 0;
+static unsigned int seed = 12345;
+
+
+/**
+ * 	\brief Pseudo random number in [-1, 1), same sequence on all systems.
+ */
+static double random_value()
+{
+	seed = seed * 1103515245 + 12345;
+	return ((seed >> 8) & 0xffff) / 32768.0 - 1.0;
+}
+
+
+/**
+ * 	\brief Random rotation matrix (column-wise) and location in mm.
+ */
+static void random_pose(double loc[3], double rot[9])
+{
+	// unit quaternion:
+	double q[4], len = 0;
+	for(int i=0; i<4; i++){
+		q[i] = random_value();
+		len += q[i] * q[i];
+	}
+	len = sqrt(len);
+	for(int i=0; i<4; i++){
+		q[i] /= len;
+	}
+
+	double w = q[0], x = q[1], y = q[2], z = q[3];
+	rot[0] = 1 - 2*(y*y + z*z);  rot[3] = 2*(x*y - w*z);      rot[6] = 2*(x*z + w*y);
+	rot[1] = 2*(x*y + w*z);      rot[4] = 1 - 2*(x*x + z*z);  rot[7] = 2*(y*z - w*x);
+	rot[2] = 2*(x*z - w*y);      rot[5] = 2*(y*z + w*x);      rot[8] = 1 - 2*(x*x + y*y);
+
+	for(int i=0; i<3; i++){
+		loc[i] = 3000.0 * random_value();
+	}
+}
+
+
+/**
+ * 	\brief Compares trafo_loc2coo_n() for n positions with plain C++.
+ *
+ *	@param[in]	n		number of positions
+ *	@param[in]	inplace	result arrays are the input arrays?
+ *	@param[out]	exact	set to false, if results are not bit-identical
+ *	@return	max deviation relative to the tolerance (pass if <= 1)
+ */
+static double compare(int n, bool inplace, bool& exact)
+{
+	double loc[3], rot[9];
+	random_pose(loc, rot);
+
+	vector<double> x(n + 1), y(n + 1), z(n + 1), xres(n + 1), yres(n + 1), zres(n + 1);
+	for(int i=0; i<n; i++){
+		x[i] = 1000.0 * random_value();
+		y[i] = 1000.0 * random_value();
+		z[i] = 1000.0 * random_value();
+	}
+	vector<double> x0(x), y0(y), z0(z);
+
+	if(inplace){
+		trafo_loc2coo_n(&x[0], &y[0], &z[0], loc, rot, &x[0], &y[0], &z[0], n);
+		xres = x;  yres = y;  zres = z;
+	}else{
+		trafo_loc2coo_n(&xres[0], &yres[0], &zres[0], loc, rot, &x[0], &y[0], &z[0], n);
+	}
+
+	double maxdev = 0;
+	for(int i=0; i<n; i++){
+		double p[3] = { x0[i], y0[i], z0[i] };
+		double res[3] = { xres[i], yres[i], zres[i] };
+		for(int k=0; k<3; k++){
+			// same order of additions as trafo_loc2coo_n():
+			double a = rot[k] * p[0], b = rot[k+3] * p[1], c = rot[k+6] * p[2];
+			double expected = (a + b) + (c + loc[k]);
+			double tolerance = 4 * DBL_EPSILON * (fabs(a) + fabs(b) + fabs(c) + fabs(loc[k]));
+
+			if(res[k] != expected){
+				exact = false;
+			}
+			double dev = fabs(res[k] - expected) / tolerance;
+			if(!(dev <= maxdev)){  // also catches NaN
+				maxdev = dev;
+			}
+		}
+	}
+
+	if(xres[n] != 0 || yres[n] != 0 || zres[n] != 0){  // nothing written behind the last position
+		maxdev = HUGE_VAL;
+	}
+	return maxdev;
+}
+
+
+/**
+ * 	\brief Compares trafo_loc2coo() and the location of trafo_compose() with trafo_loc2coo_n().
+ *
+ *	@param[out]	exact	set to false, if results are not bit-identical
+ *	@return	max deviation relative to the tolerance (pass if <= 1)
+ */
+static double compare_single(bool& exact)
+{
+	const int n = 8;  // enough for SSE2/AVX
+	double loc[3], rot[9], x[n], y[n], z[n], xres[n], yres[n], zres[n];
+	const double identity[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+
+	random_pose(loc, rot);
+	for(int i=0; i<n; i++){
+		x[i] = 1000.0 * random_value();
+		y[i] = 1000.0 * random_value();
+		z[i] = 1000.0 * random_value();
+	}
+	trafo_loc2coo_n(xres, yres, zres, loc, rot, x, y, z, n);
+
+	double maxdev = 0;
+	for(int i=0; i<n; i++){
+		double p[3] = { x[i], y[i], z[i] };
+		double res[3] = { xres[i], yres[i], zres[i] };
+		double single[3], composed[3], rotcomposed[9];
+
+		trafo_loc2coo(single, loc, rot, p);
+		trafo_compose(composed, rotcomposed, loc, rot, p, identity);
+
+		for(int k=0; k<3; k++){
+			double tolerance = 4 * DBL_EPSILON * (fabs(rot[k] * p[0]) + fabs(rot[k+3] * p[1])
+					+ fabs(rot[k+6] * p[2]) + fabs(loc[k]));
+
+			if(single[k] != res[k] || composed[k] != res[k]){
+				exact = false;
+			}
+			double dev = fabs(single[k] - res[k]) / tolerance;
+			double devcomposed = fabs(composed[k] - res[k]) / tolerance;
+			if(devcomposed > dev){
+				dev = devcomposed;
+			}
+			if(!(dev <= maxdev)){  // also catches NaN
+				maxdev = dev;
+			}
+		}
+	}
+	return maxdev;
+}
+
+
+/**
+ * 	\brief Prints and counts failed check.
+ *
+ *	Without FMA contraction results have to be bit-identical, otherwise within the tolerance.
+ */
+static void check(const char* name, int n, bool inplace, double dev, bool exact)
+{
+#if defined(CHECK_CONTRACTED)
+	exact = true;
+#endif
+	if(!(dev <= 1) || !exact){
+		cout << name;
+		if(n >= 0){
+			cout << " n " << n << (inplace ? " in place" : "");
+		}
+		cout << ": deviation " << dev << " times tolerance" << (exact ? "" : ", not bit-identical")
+		     << ": FAILED" << endl;
+		num_failed++;
+	}
+}
+
+
+/**
+ * 	\brief	Main.
+ */
+int main()
+{
+#if defined(__AVX__)
+	cout << "instruction set: AVX" << endl;
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	cout << "instruction set: SSE2" << endl;
+#else
+	cout << "instruction set: plain C++" << endl;
+#endif
+
+	// all lengths of the remaining positions, and longer arrays:
+	const int sizes[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 100, 1001 };
+	bool exact_all = true;
+	double maxdev = 0;
+
+	for(size_t s=0; s<sizeof(sizes) / sizeof(sizes[0]); s++){
+		for(int inplace=0; inplace<2; inplace++){
+			bool exact = true;
+			double dev = compare(sizes[s], inplace != 0, exact);
+			check("trafo_loc2coo_n()", sizes[s], inplace != 0, dev, exact);
+			exact_all = exact_all && exact;
+			maxdev = (dev > maxdev) ? dev : maxdev;
+		}
+	}
+
+	// single positions and composed poses against several positions:
+	for(int i=0; i<1000; i++){
+		bool exact = true;
+		double dev = compare_single(exact);
+		check("trafo_loc2coo(), trafo_compose()", -1, false, dev, exact);
+		exact_all = exact_all && exact;
+		maxdev = (dev > maxdev) ? dev : maxdev;
+	}
+
+	cout << "bit-identical to plain C++: " << (exact_all ? "yes" : "no (e.g. FMA)")
+	     << ", max deviation " << maxdev << " times tolerance" << endl;
+	cout << num_failed << " checks failed" << endl;
+	return num_failed;
+}
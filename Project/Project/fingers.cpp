@@ -1,36 +1,266 @@
 
 #include "fingers.hpp"
+#include <cstring>
 
-fingers::fingers(int handid)
+//! Conversion from degrees to radians
+static const double DEG2RAD = 3.14159265358979323846 / 180;
+
+//! Number of values of the key of a joint chain (phalanx lengths and angles)
+#define CHAIN_KEY 5
+
+/**
+ * 	\brief	Constructor.
+ *
+ *	@param[in]	maxhand		number of hands to reserve memory for (more hands are possible)
+ */
+fingers::fingers(int maxhand)
+{
+	nhand = 0;
+	this->maxhand = 0;
+	hx = hy = hz = rx = ry = rz = NULL;
+
+	Reserve(maxhand);
+}
+
+
+/**
+ * 	\brief	Adjust size of output buffer, if necessary.
+ *
+ *	@param[in]	numhand		number of hands
+ */
+void fingers::Reserve(int numhand)
+{
+	if (numhand <= maxhand && !buf.empty())
+		return;
+
+	if (numhand > maxhand)
+		maxhand = numhand;
+
+	int n = (maxhand > 0 ? maxhand : 1) * DTRACK_HAND_MAX_FINGER * NUM_POINT;
+	buf.assign(6 * n, 0.0);
+	valid.assign(n, 0);
+
+	hx = &buf[0];
+	hy = hx + n;
+	hz = hy + n;
+	rx = hz + n;
+	ry = rx + n;
+	rz = ry + n;
+
+	int nf = (maxhand > 0 ? maxhand : 1) * DTRACK_HAND_MAX_FINGER;
+	lasthand.resize(maxhand > 0 ? maxhand : 1);
+	computed.assign(lasthand.size(), 0);
+	chain.assign(nf * 3 * NUM_POINT, 0.0);
+	chainkey.assign(nf * CHAIN_KEY, -1.0);
+}
+
+
+/**
+ * 	\brief	Clear cache, i.e. compute all hands with the next Update().
+ */
+void fingers::Reset()
+{
+	computed.assign(computed.size(), 0);
+	chainkey.assign(chainkey.size(), -1.0);
+}
+
+
+/**
+ * 	\brief	Compute positions of all fingers of all hands.
+ *
+ *	@param[in]	hand	Fingertracking hand data, as delivered by DTrackSDK::getHand()
+ *	@param[in]	nhand	number of hands
+ *	@return	number of tracked hands
+ */
+int fingers::Update(const DTrack_Hand_Type_d* hand, int nhand)
+{
+	Reserve(nhand);
+	this->nhand = nhand;
+
+	int ntracked = 0;
+	for(int i=0; i<nhand; i++){
+		if(ComputeHand(hand[i], i))
+			ntracked++;
+	}
+
+	return ntracked;
+}
+
+
+/**
+ * 	\brief	Compute positions of all fingers of all hands of the last received frame.
+ *
+ *	@param[in]	dt		DTrackSDK instance
+ *	@return	number of tracked hands
+ */
+int fingers::Update(DTrackSDK* dt)
+{
+	int n = dt->getNumHand();
+	Reserve(n);
+	nhand = n;
+
+	int ntracked = 0;
+	for(int i=0; i<n; i++){
+		if(ComputeHand(*dt->getHand(i), i))
+			ntracked++;
+	}
+
+	return ntracked;
+}
+
+
+/**
+ * 	\brief	Compute positions of all fingers of one hand.
+ *
+ *	@param[in]	h		hand data
+ *	@param[in]	i		index of hand
+ *	@return	hand tracked?
+ */
+bool fingers::ComputeHand(const DTrack_Hand_Type_d& h, int i)
 {
-	
-ID=handid;
+	bool tracked = (h.quality >= 0);
+
+	// unchanged since last computation?
+	if(computed[i] && memcmp(&lasthand[i], &h, sizeof(h)) == 0)
+		return tracked;
+
+	lasthand[i] = h;
+	computed[i] = 1;
+
+	for(int j=0; j<DTRACK_HAND_MAX_FINGER; j++){
+		int idx = Index(i, j, 0);
+
+		if(!tracked || j >= h.nfinger){
+			for(int k=0; k<NUM_POINT; k++){
+				valid[idx + k] = 0;
+				hx[idx + k] = hy[idx + k] = hz[idx + k] = 0;
+				rx[idx + k] = ry[idx + k] = rz[idx + k] = 0;
+			}
+			continue;
+		}
+
+		const double* l = JointChain(i * DTRACK_HAND_MAX_FINGER + j, h.finger[j].lengthphalanx, h.finger[j].anglephalanx);
+		const double* lx = l;
+		const double* ly = l + NUM_POINT;
+		const double* lz = l + 2 * NUM_POINT;
+
+		// into hand coordinate system (finger pose), and directly into room coordinate system
+		// (finger pose composed with hand pose, i.e. one transformation per position):
+
+		double locroom[3], rotroom[9];
+		trafo_compose(locroom, rotroom, h.loc, h.rot, h.finger[j].loc, h.finger[j].rot);
+
+		trafo_loc2coo_n(hx + idx, hy + idx, hz + idx, h.finger[j].loc, h.finger[j].rot, lx, ly, lz, NUM_POINT);
+		trafo_loc2coo_n(rx + idx, ry + idx, rz + idx, locroom, rotroom, lx, ly, lz, NUM_POINT);
+
+		for(int k=0; k<NUM_POINT; k++){
+			valid[idx + k] = 1;
+		}
+	}
+
+	return tracked;
 }
 
 
- double fingers::GetFingerTip(DTrack_Hand_Type_d hand)
+/**
+ * 	\brief	Get joint chain of a finger (tip and all joints in finger coordinate system).
+ *
+ *	@param[in]	f		index of finger in all hands (hand * DTRACK_HAND_MAX_FINGER + finger)
+ *	@param[in]	len		length of phalanxes
+ *	@param[in]	ang		angle between phalanxes (in deg)
+ *	@return	x, y and z coordinates of all positions (NUM_POINT values each)
+ */
+const double* fingers::JointChain(int f, const double len[3], const double ang[2])
 {
+	double* key = &chainkey[f * CHAIN_KEY];
+	double* x = &chain[f * 3 * NUM_POINT];
+	double* y = x + NUM_POINT;
+	double* z = y + NUM_POINT;
+
+	if(key[0] == len[0] && key[1] == len[1] && key[2] == len[2] && key[3] == ang[0] && key[4] == ang[1])
+		return x;
+
+	// trigonometry of both angles, each evaluated once:
+	double a0 = ang[0] * DEG2RAD;
+	double a01 = (ang[0] + ang[1]) * DEG2RAD;
+	double c0 = cos(a0), s0 = sin(a0);
+	double c01 = cos(a01), s01 = sin(a01);
+
+	// tip is origin, each joint continues the chain from the previous one:
 
+	x[POINT_TIP] = y[POINT_TIP] = z[POINT_TIP] = 0;
 
-	return 1.0f;
+	x[POINT_JOINT1] = -len[0];
+	y[POINT_JOINT1] = z[POINT_JOINT1] = 0;
 
+	x[POINT_JOINT2] = x[POINT_JOINT1] - len[1] * c0;
+	y[POINT_JOINT2] = 0;
+	z[POINT_JOINT2] = len[1] * s0;
 
+	x[POINT_JOINT3] = x[POINT_JOINT2] - len[2] * c01;
+	y[POINT_JOINT3] = 0;
+	z[POINT_JOINT3] = z[POINT_JOINT2] + len[2] * s01;
+
+	key[0] = len[0];
+	key[1] = len[1];
+	key[2] = len[2];
+	key[3] = ang[0];
+	key[4] = ang[1];
+	return x;
+}
+
+
+/**
+ * 	\brief	Get finger tip.
+ *
+ *	@param[in]	hand		index of hand
+ *	@param[in]	finger		index of finger
+ *	@param[out]	lochand		position in hand coordinate system
+ *	@param[out]	locroom		position in room coordinate system
+ *	@return	available?
+ */
+bool fingers::GetFingerTip(int hand, int finger, double lochand[3], double locroom[3]) const
+{
+	if(finger < 0 || finger >= DTRACK_HAND_MAX_FINGER)
+		return false;
+
+	return GetPoint(Index(hand, finger, POINT_TIP), lochand, locroom);
+}
+
+
+/**
+ * 	\brief	Get finger joint.
+ *
+ *	@param[in]	hand		index of hand
+ *	@param[in]	finger		index of finger
+ *	@param[in]	joint		joint, range 1 .. 3 (1 is next to the finger tip)
+ *	@param[out]	lochand		position in hand coordinate system
+ *	@param[out]	locroom		position in room coordinate system
+ *	@return	available?
+ */
+bool fingers::GetJoint(int hand, int finger, int joint, double lochand[3], double locroom[3]) const
+{
+	if(finger < 0 || finger >= DTRACK_HAND_MAX_FINGER || joint < 1 || joint > 3)
+		return false;
+
+	return GetPoint(Index(hand, finger, POINT_TIP + joint), lochand, locroom);
 }
 
 
+/**
+ * 	\brief	Get position from coordinate arrays.
+ */
+bool fingers::GetPoint(int index, double lochand[3], double locroom[3]) const
+{
+	if(!IsValid(index))
+		return false;
+
+	lochand[0] = hx[index];
+	lochand[1] = hy[index];
+	lochand[2] = hz[index];
+	locroom[0] = rx[index];
+	locroom[1] = ry[index];
+	locroom[2] = rz[index];
+	return true;
+}
 
-//void fingers:: trafo_loc2coo( double locres[3], const double loccoo[3], const double rotcoo[9], const double loc[3] )
-//{
-//
-//
-//	for(int i=0; i<3; i++)
-//	{
-//		tmploc[i] = rotcoo[i+0*3] * loc[0] + rotcoo[i+1*3] * loc[1] + rotcoo[i+2*3] * loc[2];
-//	}
-//
-//	for(int i=0; i<3; i++)
-//	{
-//		locres[i] = tmploc[i] + loccoo[i];
-//	}
-//
-//}
\ No newline at end of file
@@ -3,34 +3,186 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include <vector>
 #include "DTrackSDK.hpp"
+#include "trafo.hpp"
 
-#define M_PI 3.14
 using namespace std;
 
 
-
+/**
+ * 	\brief Forward kinematics of Fingertracking hands.
+ *
+ *	Computes finger tip and all three joints of every finger of every hand in one pass, both in hand
+ *	and in room coordinates. The results are stored as structure of arrays: one contiguous array per
+ *	coordinate, indexed by Index(hand, finger, point).
+ *
+ *	Results are cached: a hand whose data did not change since the last Update() is not computed
+ *	again, and the joint chain of a finger (depending on phalanx lengths and angles only) is
+ *	reused as long as these don't change.
+ */
 class fingers{
 
 public:
 
-
-
-fingers(int handid);
-//double lochand[3], locroom[3];
-//double tmploc[3];
-
-int ID;
-double GetFingerTip(DTrack_Hand_Type_d hand);
-double GetFirstJoint();
-
-//private:
-
-//void trafo_loc2coo( double locres[3], const double loccoo[3], const double rotcoo[9], const double loc[3] );
-
-
-
+	//! Positions computed per finger
+	enum {
+		POINT_TIP = 0,	//!< finger tip
+		POINT_JOINT1,	//!< first joint (between outermost and middle phalanx)
+		POINT_JOINT2,	//!< second joint (between middle and innermost phalanx)
+		POINT_JOINT3,	//!< third joint (base of innermost phalanx)
+		NUM_POINT		//!< number of positions per finger
+	};
+
+	/**
+	 * 	\brief	Constructor.
+	 *
+	 *	@param[in]	maxhand		number of hands to reserve memory for (more hands are possible)
+	 */
+	fingers(int maxhand = 2);
+
+	/**
+	 * 	\brief	Compute positions of all fingers of all hands.
+	 *
+	 *	@param[in]	hand	Fingertracking hand data, as delivered by DTrackSDK::getHand()
+	 *	@param[in]	nhand	number of hands
+	 *	@return	number of tracked hands
+	 */
+	int Update(const DTrack_Hand_Type_d* hand, int nhand);
+
+	/**
+	 * 	\brief	Compute positions of all fingers of all hands of the last received frame.
+	 *
+	 *	@param[in]	dt		DTrackSDK instance
+	 *	@return	number of tracked hands
+	 */
+	int Update(DTrackSDK* dt);
+
+	/**
+	 * 	\brief	Clear cache, i.e. compute all hands with the next Update().
+	 */
+	void Reset();
+
+	/**
+	 * 	\brief	Get number of hands of last Update().
+	 *
+	 *	@return	number of hands
+	 */
+	int GetNumHand() const { return nhand; }
+
+	/**
+	 * 	\brief	Get number of positions (length of coordinate arrays).
+	 *
+	 *	@return	number of positions
+	 */
+	int GetNumPoints() const { return nhand * DTRACK_HAND_MAX_FINGER * NUM_POINT; }
+
+	/**
+	 * 	\brief	Get index of a position in the coordinate arrays.
+	 *
+	 *	@param[in]	hand	index of hand
+	 *	@param[in]	finger	index of finger (order: thumb, index finger, middle finger, ...)
+	 *	@param[in]	point	position (one of POINT_TIP, POINT_JOINT1, ...)
+	 *	@return	index
+	 */
+	static int Index(int hand, int finger, int point) { return (hand * DTRACK_HAND_MAX_FINGER + finger) * NUM_POINT + point; }
+
+	/**
+	 * 	\brief	Get coordinate arrays of positions in hand coordinate system.
+	 *
+	 *	Valid until the next Update().
+	 *	@return	x, y or z coordinates (GetNumPoints() values)
+	 */
+	const double* GetHandX() const { return hx; }
+	const double* GetHandY() const { return hy; }  //!< see GetHandX()
+	const double* GetHandZ() const { return hz; }  //!< see GetHandX()
+
+	/**
+	 * 	\brief	Get coordinate arrays of positions in room coordinate system.
+	 *
+	 *	Valid until the next Update().
+	 *	@return	x, y or z coordinates (GetNumPoints() values)
+	 */
+	const double* GetRoomX() const { return rx; }
+	const double* GetRoomY() const { return ry; }  //!< see GetRoomX()
+	const double* GetRoomZ() const { return rz; }  //!< see GetRoomX()
+
+	/**
+	 * 	\brief	Check if a position is available (hand tracked, finger existing).
+	 *
+	 *	@param[in]	index	index of position (see Index())
+	 *	@return	available?
+	 */
+	bool IsValid(int index) const { return (index >= 0 && index < GetNumPoints() && valid[index] != 0); }
+
+	/**
+	 * 	\brief	Get finger tip.
+	 *
+	 *	@param[in]	hand		index of hand
+	 *	@param[in]	finger		index of finger
+	 *	@param[out]	lochand		position in hand coordinate system
+	 *	@param[out]	locroom		position in room coordinate system
+	 *	@return	available?
+	 */
+	bool GetFingerTip(int hand, int finger, double lochand[3], double locroom[3]) const;
+
+	/**
+	 * 	\brief	Get finger joint.
+	 *
+	 *	@param[in]	hand		index of hand
+	 *	@param[in]	finger		index of finger
+	 *	@param[in]	joint		joint, range 1 .. 3 (1 is next to the finger tip)
+	 *	@param[out]	lochand		position in hand coordinate system
+	 *	@param[out]	locroom		position in room coordinate system
+	 *	@return	available?
+	 */
+	bool GetJoint(int hand, int finger, int joint, double lochand[3], double locroom[3]) const;
+
+private:
+
+	/**
+	 * 	\brief	Adjust size of output buffer, if necessary.
+	 *
+	 *	@param[in]	numhand		number of hands
+	 */
+	void Reserve(int numhand);
+
+	/**
+	 * 	\brief	Compute positions of all fingers of one hand.
+	 *
+	 *	@param[in]	h		hand data
+	 *	@param[in]	i		index of hand
+	 *	@return	hand tracked?
+	 */
+	bool ComputeHand(const DTrack_Hand_Type_d& h, int i);
+
+	/**
+	 * 	\brief	Get joint chain of a finger (tip and all joints in finger coordinate system).
+	 *
+	 *	@param[in]	f		index of finger in all hands (hand * DTRACK_HAND_MAX_FINGER + finger)
+	 *	@param[in]	len		length of phalanxes
+	 *	@param[in]	ang		angle between phalanxes (in deg)
+	 *	@return	x, y and z coordinates of all positions (NUM_POINT values each)
+	 */
+	const double* JointChain(int f, const double len[3], const double ang[2]);
+
+	/**
+	 * 	\brief	Get position from coordinate arrays.
+	 */
+	bool GetPoint(int index, double lochand[3], double locroom[3]) const;
+
+	int nhand;                   //!< number of hands of last Update()
+	int maxhand;                 //!< number of hands the buffer is sized for
+	std::vector<double> buf;     //!< output buffer (six coordinate arrays of maxhand hands each)
+	std::vector<char> valid;     //!< position available? (per position)
+	double *hx, *hy, *hz;        //!< coordinates in hand coordinate system (pointing into buf)
+	double *rx, *ry, *rz;        //!< coordinates in room coordinate system (pointing into buf)
+
+	std::vector<DTrack_Hand_Type_d> lasthand;  //!< cache: hand data positions were computed from (per hand)
+	std::vector<char> computed;  //!< cache: positions of hand computed from lasthand? (per hand)
+	std::vector<double> chain;   //!< cache: joint chain in finger coordinate system (per finger, see JointChain())
+	std::vector<double> chainkey;  //!< cache: phalanx lengths and angles of joint chain (per finger; negative length if none)
 };
 
 
-#endif
\ No newline at end of file
+#endif
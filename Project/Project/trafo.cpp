@@ -0,0 +1,137 @@
+
+#include "trafo.hpp"
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+	#define TRAFO_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define TRAFO_SSE2
+#endif
+
+
+/**
+ * 	\brief	Transform one position into another coordinate system.
+ *
+ *	@param[out]	locres	transformed position (might be the same as loc)
+ *	@param[in]	loccoo	location of pose
+ *	@param[in]	rotcoo	rotation matrix of pose (column-wise)
+ *	@param[in]	loc		position to transform
+ */
+void trafo_loc2coo( double locres[3], const double loccoo[3], const double rotcoo[9], const double loc[3] )
+{
+	double x = loc[0], y = loc[1], z = loc[2];
+
+	// same order of additions as trafo_loc2coo_n():
+	locres[0] = (rotcoo[0] * x + rotcoo[3] * y) + (rotcoo[6] * z + loccoo[0]);
+	locres[1] = (rotcoo[1] * x + rotcoo[4] * y) + (rotcoo[7] * z + loccoo[1]);
+	locres[2] = (rotcoo[2] * x + rotcoo[5] * y) + (rotcoo[8] * z + loccoo[2]);
+}
+
+
+/**
+ * 	\brief	Transform several positions into another coordinate system.
+ *
+ *	Positions are stored as structure of arrays (one array per coordinate). Result arrays might be
+ *	the same as the input arrays. Results with and without SSE2/AVX are identical, except with FMA
+ *	(see trafo.hpp; checked by example_trafo_check.cpp).
+ *	@param[out]	xres	x coordinates of transformed positions
+ *	@param[out]	yres	y coordinates of transformed positions
+ *	@param[out]	zres	z coordinates of transformed positions
+ *	@param[in]	loccoo	location of pose
+ *	@param[in]	rotcoo	rotation matrix of pose (column-wise)
+ *	@param[in]	x		x coordinates of positions to transform
+ *	@param[in]	y		y coordinates of positions to transform
+ *	@param[in]	z		z coordinates of positions to transform
+ *	@param[in]	n		number of positions
+ */
+void trafo_loc2coo_n( double* xres, double* yres, double* zres, const double loccoo[3], const double rotcoo[9],
+		const double* x, const double* y, const double* z, int n )
+{
+	int i = 0;
+
+#if defined(TRAFO_AVX)
+	// four positions at once:
+	__m256d r0 = _mm256_set1_pd(rotcoo[0]), r1 = _mm256_set1_pd(rotcoo[1]), r2 = _mm256_set1_pd(rotcoo[2]);
+	__m256d r3 = _mm256_set1_pd(rotcoo[3]), r4 = _mm256_set1_pd(rotcoo[4]), r5 = _mm256_set1_pd(rotcoo[5]);
+	__m256d r6 = _mm256_set1_pd(rotcoo[6]), r7 = _mm256_set1_pd(rotcoo[7]), r8 = _mm256_set1_pd(rotcoo[8]);
+	__m256d l0 = _mm256_set1_pd(loccoo[0]), l1 = _mm256_set1_pd(loccoo[1]), l2 = _mm256_set1_pd(loccoo[2]);
+
+	for( ; i+4<=n; i+=4){
+		__m256d vx = _mm256_loadu_pd(x + i);
+		__m256d vy = _mm256_loadu_pd(y + i);
+		__m256d vz = _mm256_loadu_pd(z + i);
+
+		_mm256_storeu_pd(xres + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r0, vx), _mm256_mul_pd(r3, vy)),
+				_mm256_add_pd(_mm256_mul_pd(r6, vz), l0)));
+		_mm256_storeu_pd(yres + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r1, vx), _mm256_mul_pd(r4, vy)),
+				_mm256_add_pd(_mm256_mul_pd(r7, vz), l1)));
+		_mm256_storeu_pd(zres + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r2, vx), _mm256_mul_pd(r5, vy)),
+				_mm256_add_pd(_mm256_mul_pd(r8, vz), l2)));
+	}
+#elif defined(TRAFO_SSE2)
+	// two positions at once:
+	__m128d r0 = _mm_set1_pd(rotcoo[0]), r1 = _mm_set1_pd(rotcoo[1]), r2 = _mm_set1_pd(rotcoo[2]);
+	__m128d r3 = _mm_set1_pd(rotcoo[3]), r4 = _mm_set1_pd(rotcoo[4]), r5 = _mm_set1_pd(rotcoo[5]);
+	__m128d r6 = _mm_set1_pd(rotcoo[6]), r7 = _mm_set1_pd(rotcoo[7]), r8 = _mm_set1_pd(rotcoo[8]);
+	__m128d l0 = _mm_set1_pd(loccoo[0]), l1 = _mm_set1_pd(loccoo[1]), l2 = _mm_set1_pd(loccoo[2]);
+
+	for( ; i+2<=n; i+=2){
+		__m128d vx = _mm_loadu_pd(x + i);
+		__m128d vy = _mm_loadu_pd(y + i);
+		__m128d vz = _mm_loadu_pd(z + i);
+
+		_mm_storeu_pd(xres + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(r0, vx), _mm_mul_pd(r3, vy)),
+				_mm_add_pd(_mm_mul_pd(r6, vz), l0)));
+		_mm_storeu_pd(yres + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(r1, vx), _mm_mul_pd(r4, vy)),
+				_mm_add_pd(_mm_mul_pd(r7, vz), l1)));
+		_mm_storeu_pd(zres + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(r2, vx), _mm_mul_pd(r5, vy)),
+				_mm_add_pd(_mm_mul_pd(r8, vz), l2)));
+	}
+#endif
+
+	// remaining positions (all positions without SSE2/AVX):
+	for( ; i<n; i++){
+		double px = x[i], py = y[i], pz = z[i];
+
+		xres[i] = (rotcoo[0] * px + rotcoo[3] * py) + (rotcoo[6] * pz + loccoo[0]);
+		yres[i] = (rotcoo[1] * px + rotcoo[4] * py) + (rotcoo[7] * pz + loccoo[1]);
+		zres[i] = (rotcoo[2] * px + rotcoo[5] * py) + (rotcoo[8] * pz + loccoo[2]);
+	}
+}
+
+
+/**
+ * 	\brief	Compose two poses into one.
+ *
+ *	Transforming with the result is the same as transforming with the inner pose first and with the
+ *	outer pose afterwards (e.g. finger in hand and hand in room gives finger in room).
+ *	@param[out]	locres	location of composed pose
+ *	@param[out]	rotres	rotation matrix of composed pose (column-wise)
+ *	@param[in]	locout	location of outer pose
+ *	@param[in]	rotout	rotation matrix of outer pose
+ *	@param[in]	locin	location of inner pose
+ *	@param[in]	rotin	rotation matrix of inner pose
+ */
+void trafo_compose( double locres[3], double rotres[9], const double locout[3], const double rotout[9],
+		const double locin[3], const double rotin[9] )
+{
+	double rot[9], loc[3];
+
+	// rotation: rotout * rotin (column j of result is rotout applied to column j of rotin)
+	for(int j=0; j<3; j++){
+		for(int i=0; i<3; i++){
+			rot[i+j*3] = rotout[i+0*3] * rotin[0+j*3] + rotout[i+1*3] * rotin[1+j*3] + rotout[i+2*3] * rotin[2+j*3];
+		}
+	}
+
+	// location: rotout * locin + locout
+	trafo_loc2coo(loc, locout, rotout, locin);
+
+	for(int i=0; i<9; i++){
+		rotres[i] = rot[i];
+	}
+	for(int i=0; i<3; i++){
+		locres[i] = loc[i];
+	}
+}
@@ -0,0 +1,64 @@
+#ifndef _TRAFO_H_
+#define _TRAFO_H_
+
+/*
+ * Transformation of positions between coordinate systems.
+ *
+ * A pose (of a body, hand, finger, ...) consists of a rotation matrix rot[9] (column-wise, as
+ * delivered by DTrack) and a location loc[3]; it transforms a position p of the local coordinate
+ * system into the surrounding one: rot * p + loc.
+ *
+ * The functions working on several positions use SSE2 or AVX, if enabled for the compiler
+ * (e.g. gcc '-msse2', '-mavx'; MS Visual C++ '/arch:SSE2', '/arch:AVX'; SSE2 is always available
+ * on x64), otherwise plain C++. trafo_loc2coo(), trafo_loc2coo_n() and the location computed by
+ * trafo_compose() add the products in the same order, so the results are bit-identical, unless the
+ * compiler contracts multiplications and additions into FMA instructions (e.g. gcc with '-mfma' or
+ * '-march=native', MS Visual C++ with '/fp:contract', or '-ffast-math'); then they differ by less
+ * than 4 * DBL_EPSILON times the sum of the absolute values of the products and the location.
+ */
+
+/**
+ * 	\brief	Transform one position into another coordinate system.
+ *
+ *	@param[out]	locres	transformed position (might be the same as loc)
+ *	@param[in]	loccoo	location of pose
+ *	@param[in]	rotcoo	rotation matrix of pose (column-wise)
+ *	@param[in]	loc		position to transform
+ */
+void trafo_loc2coo( double locres[3], const double loccoo[3], const double rotcoo[9], const double loc[3] );
+
+/**
+ * 	\brief	Transform several positions into another coordinate system.
+ *
+ *	Positions are stored as structure of arrays (one array per coordinate). Result arrays might be
+ *	the same as the input arrays. Results with and without SSE2/AVX are identical, except with FMA
+ *	(see above; checked by example_trafo_check.cpp).
+ *	@param[out]	xres	x coordinates of transformed positions
+ *	@param[out]	yres	y coordinates of transformed positions
+ *	@param[out]	zres	z coordinates of transformed positions
+ *	@param[in]	loccoo	location of pose
+ *	@param[in]	rotcoo	rotation matrix of pose (column-wise)
+ *	@param[in]	x		x coordinates of positions to transform
+ *	@param[in]	y		y coordinates of positions to transform
+ *	@param[in]	z		z coordinates of positions to transform
+ *	@param[in]	n		number of positions
+ */
+void trafo_loc2coo_n( double* xres, double* yres, double* zres, const double loccoo[3], const double rotcoo[9],
+		const double* x, const double* y, const double* z, int n );
+
+/**
+ * 	\brief	Compose two poses into one.
+ *
+ *	Transforming with the result is the same as transforming with the inner pose first and with the
+ *	outer pose afterwards (e.g. finger in hand and hand in room gives finger in room).
+ *	@param[out]	locres	location of composed pose
+ *	@param[out]	rotres	rotation matrix of composed pose (column-wise)
+ *	@param[in]	locout	location of outer pose
+ *	@param[in]	rotout	rotation matrix of outer pose
+ *	@param[in]	locin	location of inner pose
+ *	@param[in]	rotin	rotation matrix of inner pose
+ */
+void trafo_compose( double locres[3], double rotres[9], const double locout[3], const double rotout[9],
+		const double locin[3], const double rotin[9] );
+
+#endif